@@ -17,4 +17,31 @@
 #define MINPP_STD_COMPAT true
 #endif
 
+// store tuple<T, ..., T> as an array of T, see tuple::operator[](size_t)
+#ifndef MINPP_HOMOGENEOUS_ARRAY_STORAGE
+#define MINPP_HOMOGENEOUS_ARRAY_STORAGE true
+#endif
+
+#ifndef MINPP_CACHELINE_SIZE
+#define MINPP_CACHELINE_SIZE 64
+#endif
+
+/*
+Accessors and forwarding constructors are forced inline so that an unoptimized build does not pay a call
+per layer (get, _impl_at, the tuple, _tuple_t and tuple_leaf constructors) for what is a member access.
+Define MINPP_ALWAYS_INLINE as empty to get the plain calls back, e.g. to step through them in a debugger.
+*/
+#ifndef MINPP_ALWAYS_INLINE
+#if defined(__GNUC__) || defined(__clang__)
+#define MINPP_ALWAYS_INLINE [[gnu::always_inline]]
+#elif defined(_MSC_VER)
+#define MINPP_ALWAYS_INLINE [[msvc::forceinline]]
+#else
+#define MINPP_ALWAYS_INLINE
+#endif
+#endif
+
+// std::forward without the function call std::forward is at -O0
+#define MINPP_FWD(x) static_cast<decltype(x)&&>(x)
+
 #endif
\ No newline at end of file
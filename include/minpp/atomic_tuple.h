@@ -0,0 +1,257 @@
+#ifndef MINPP_ATOMIC_TUPLE_H_
+#define MINPP_ATOMIC_TUPLE_H_
+#include "minpp/_minpp_macros.h"
+#include "minpp/tuple.h"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+MINPP_IMPL_BEGIN
+
+enum class _atomic_tuple_kind {
+  native,   // std::atomic<tuple>, lock-free for 1, 2, 4 and 8 bytes
+  wide,     // 16 bytes through cmpxchg16b (g++/clang with -mcx16)
+  seqlock   // sequence lock over relaxed atomic words
+};
+
+/*
+The lock-free kinds compare bitwise, so they are only chosen when bitwise equality is value equality.
+*/
+template <typename T>
+constexpr _atomic_tuple_kind _atomic_tuple_kind_of() noexcept {
+  if constexpr (!std::has_unique_object_representations_v<T>) return _atomic_tuple_kind::seqlock;
+  else if constexpr ((sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8) && std::atomic<T>::is_always_lock_free) {
+    return _atomic_tuple_kind::native;
+  }
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16) && defined(__SIZEOF_INT128__)
+  else if constexpr (sizeof(T) == 16) return _atomic_tuple_kind::wide;
+#endif
+  else return _atomic_tuple_kind::seqlock;
+}
+
+inline void _atomic_tuple_relax(unsigned& spins) noexcept {
+  if (++spins > 64) std::this_thread::yield();
+}
+
+template <typename T, _atomic_tuple_kind = _atomic_tuple_kind_of<T>()>
+class _atomic_tuple_storage;
+
+template <typename T>
+class _atomic_tuple_storage<T, _atomic_tuple_kind::native> {
+  public:
+  explicit _atomic_tuple_storage(const T& v) noexcept: _v{v} {}
+
+  T load() const noexcept { return _v.load(std::memory_order_acquire); }
+  void store(const T& v) noexcept { _v.store(v, std::memory_order_release); }
+
+  bool compare_exchange(T& expected, const T& desired) noexcept {
+    return _v.compare_exchange_strong(expected, desired, std::memory_order_acq_rel, std::memory_order_acquire);
+  }
+
+  private:
+  std::atomic<T> _v;
+};
+
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16) && defined(__SIZEOF_INT128__)
+template <typename T>
+class _atomic_tuple_storage<T, _atomic_tuple_kind::wide> {
+  using bits = unsigned __int128;
+
+  public:
+  explicit _atomic_tuple_storage(const T& v) noexcept: _v{std::bit_cast<bits>(v)} {}
+
+  // cmpxchg16b is the only 16-byte atomic read, so a load is a compare-exchange that never changes the value
+  T load() const noexcept { return std::bit_cast<T>(__sync_val_compare_and_swap(&_v, bits{0}, bits{0})); }
+
+  void store(const T& v) noexcept {
+    bits cur{0};
+    const bits next = std::bit_cast<bits>(v);
+    while (true) {
+      const bits seen = __sync_val_compare_and_swap(&_v, cur, next);
+      if (seen == cur) return;
+      cur = seen;
+    }
+  }
+
+  bool compare_exchange(T& expected, const T& desired) noexcept {
+    const bits exp = std::bit_cast<bits>(expected);
+    const bits seen = __sync_val_compare_and_swap(&_v, exp, std::bit_cast<bits>(desired));
+    if (seen == exp) return true;
+    expected = std::bit_cast<T>(seen);
+    return false;
+  }
+
+  private:
+  alignas(16) mutable bits _v;
+};
+#endif
+
+template <typename T>
+class _atomic_tuple_storage<T, _atomic_tuple_kind::seqlock> {
+  static constexpr std::size_t _words = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+  public:
+  explicit _atomic_tuple_storage(const T& v) noexcept { _write(v); }
+
+  /*
+  Readers never write shared memory: they copy the words and retry if a writer was active meanwhile.
+  */
+  T load() const noexcept {
+    std::array<std::uint64_t, _words> buf;
+    unsigned spins = 0;
+    while (true) {
+      const std::uint64_t before = _seq.load(std::memory_order_acquire);
+      if (!(before & 1)) {
+        for (std::size_t i = 0; i < _words; ++i) buf[i] = _data[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (_seq.load(std::memory_order_relaxed) == before) break;
+      }
+      _atomic_tuple_relax(spins);
+    }
+    std::array<unsigned char, sizeof(T)> bytes;
+    std::memcpy(bytes.data(), buf.data(), sizeof(T));
+    return std::bit_cast<T>(bytes);
+  }
+
+  void store(const T& v) noexcept {
+    _lock();
+    _write(v);
+    _unlock();
+  }
+
+  bool compare_exchange(T& expected, const T& desired) {
+    _lock();
+    T cur = _read_locked();
+    const bool equal = cur == expected;
+    if (equal) _write(desired);
+    _unlock();
+    if (!equal) expected = std::move(cur);
+    return equal;
+  }
+
+  template <std::size_t I, typename F>
+  T update(F& fn) {
+    _lock();
+    struct unlock_guard {
+      _atomic_tuple_storage* self;
+      ~unlock_guard() { self->_unlock(); }
+    } guard{this};
+    T next = _read_locked();
+    get<I>(next) = fn(std::as_const(get<I>(next)));
+    _write(next);
+    return next;
+  }
+
+  private:
+  void _lock() noexcept {
+    unsigned spins = 0;
+    std::uint64_t s = _seq.load(std::memory_order_relaxed);
+    while ((s & 1) || !_seq.compare_exchange_weak(s, s + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+      _atomic_tuple_relax(spins);
+      s = _seq.load(std::memory_order_relaxed);
+    }
+    // keeps the data stores below from becoming visible before the sequence turns odd
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  void _unlock() noexcept {
+    _seq.fetch_add(1, std::memory_order_release);
+  }
+
+  T _read_locked() const noexcept {
+    std::array<std::uint64_t, _words> buf;
+    for (std::size_t i = 0; i < _words; ++i) buf[i] = _data[i].load(std::memory_order_relaxed);
+    std::array<unsigned char, sizeof(T)> bytes;
+    std::memcpy(bytes.data(), buf.data(), sizeof(T));
+    return std::bit_cast<T>(bytes);
+  }
+
+  void _write(const T& v) noexcept {
+    std::array<std::uint64_t, _words> buf{};
+    std::memcpy(buf.data(), &v, sizeof(T));
+    for (std::size_t i = 0; i < _words; ++i) _data[i].store(buf[i], std::memory_order_relaxed);
+  }
+
+  alignas(MINPP_CACHELINE_SIZE) std::atomic<std::uint64_t> _seq{0};
+  std::atomic<std::uint64_t> _data[_words];
+};
+
+MINPP_IMPL_END
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @brief A tuple<Types...> that is read and written atomically as a whole.
+  Tuples of 1, 2, 4 or 8 bytes use std::atomic, 16-byte tuples use cmpxchg16b where the target has it
+  (x86-64 with -mcx16), and everything else falls back to a sequence lock: writers serialize on a sequence
+  counter, readers copy optimistically and retry, so reads never write shared memory.
+  @pre tuple<Types...> is trivially copyable.
+  @note Loads have acquire and stores release semantics. compare_exchange and update compare with ==; the
+  lock-free kinds are only used when the tuple has unique object representations, where == and bitwise
+  equality agree.
+*/
+template <typename... Types>
+class atomic_tuple {
+  public:
+  using value_type = tuple<Types...>;
+
+  static_assert(std::is_trivially_copyable_v<value_type>, "atomic_tuple requires trivially copyable elements");
+
+  /**
+    @brief true if every operation is lock-free, false if the sequence lock is used.
+  */
+  static constexpr bool is_always_lock_free = impl::_atomic_tuple_kind_of<value_type>() != impl::_atomic_tuple_kind::seqlock;
+
+  atomic_tuple() noexcept(std::is_nothrow_default_constructible_v<value_type>) requires std::default_initializable<value_type>
+  : _storage{value_type{}} {}
+
+  explicit atomic_tuple(const value_type& v) noexcept: _storage{v} {}
+
+  atomic_tuple(const atomic_tuple&) = delete;
+  atomic_tuple& operator=(const atomic_tuple&) = delete;
+
+  value_type load() const noexcept { return _storage.load(); }
+
+  void store(const value_type& v) noexcept { _storage.store(v); }
+
+  /**
+    @brief If the current value equals expected, replaces it with desired; otherwise loads it into expected.
+    @returns Whether the value was replaced.
+  */
+  bool compare_exchange(value_type& expected, const value_type& desired) {
+    return _storage.compare_exchange(expected, desired);
+  }
+
+  /**
+    @fn template<size_t I, class F> value_type update(F fn);
+    @brief Atomically replaces element I with fn(element I), keeping the other elements.
+    @returns The new value of the whole tuple.
+    @note fn may be called more than once under contention and should not have side effects.
+  */
+  template <std::size_t I, typename F>
+  value_type update(F fn) {
+    if constexpr (is_always_lock_free) {
+      value_type cur = load();
+      value_type next = cur;
+      do {
+        next = cur;
+        get<I>(next) = fn(std::as_const(get<I>(cur)));
+      } while (!compare_exchange(cur, next));
+      return next;
+    }
+    else return _storage.template update<I>(fn);
+  }
+
+  private:
+  impl::_atomic_tuple_storage<value_type> _storage;
+};
+
+MINPP_NAMESPACE_END
+
+#endif
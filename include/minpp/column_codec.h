@@ -0,0 +1,730 @@
+#ifndef MINPP_COLUMN_CODEC_H_
+#define MINPP_COLUMN_CODEC_H_
+#include "minpp/_minpp_macros.h"
+#include "minpp/tuple.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+MINPP_IMPL_BEGIN
+
+[[noreturn]] inline void _column_malformed() {
+  throw std::invalid_argument("minpp::column_codec: malformed or truncated data");
+}
+
+// the encoded format is little-endian whatever the host is
+template <std::unsigned_integral U>
+constexpr U _to_little_endian(U v) noexcept {
+  if constexpr (std::endian::native == std::endian::big && sizeof(U) > 1) {
+    U r = 0;
+    for (std::size_t i = 0; i < sizeof(U); ++i, v = static_cast<U>(v >> CHAR_BIT)) r = static_cast<U>((r << CHAR_BIT) | (v & 0xff));
+    return r;
+  }
+  else return v;
+}
+
+template <std::integral T>
+void _column_put(std::vector<std::byte>& out, T v) {
+  const auto le = _to_little_endian(static_cast<std::make_unsigned_t<T>>(v));
+  const std::size_t at = out.size();
+  out.resize(at + sizeof(le));
+  std::memcpy(out.data() + at, &le, sizeof(le));
+}
+
+template <std::integral T>
+void _column_put_all(std::vector<std::byte>& out, std::span<const T> v) {
+  const std::size_t at = out.size();
+  out.resize(at + v.size_bytes());
+  if constexpr (std::endian::native == std::endian::little) {
+    if (!v.empty()) std::memcpy(out.data() + at, v.data(), v.size_bytes());
+  }
+  else {
+    for (std::size_t i = 0; i < v.size(); ++i) {
+      const auto le = _to_little_endian(static_cast<std::make_unsigned_t<T>>(v[i]));
+      std::memcpy(out.data() + at + i * sizeof(T), &le, sizeof(T));
+    }
+  }
+}
+
+template <std::integral T>
+inline T _column_load(const std::byte* p) noexcept {
+  std::make_unsigned_t<T> v;
+  std::memcpy(&v, p, sizeof(v));
+  return static_cast<T>(_to_little_endian(v));
+}
+
+/*
+Bounds-checked cursor over the encoded bytes; every read of the format goes through it, so truncated or
+inconsistent data throws instead of reading past the end.
+*/
+struct _column_reader {
+  const std::byte* p;
+  const std::byte* end;
+
+  const std::byte* take(std::size_t n) {
+    if (static_cast<std::size_t>(end - p) < n) _column_malformed();
+    const std::byte* at = p;
+    p += n;
+    return at;
+  }
+
+  template <std::integral T>
+  T get() {
+    return _column_load<T>(take(sizeof(T)));
+  }
+
+  template <std::integral T>
+  void get_all(std::span<T> out) {
+    const std::byte* at = take(out.size_bytes());
+    if constexpr (std::endian::native == std::endian::little) {
+      if (!out.empty()) std::memcpy(out.data(), at, out.size_bytes());
+    }
+    else {
+      for (std::size_t i = 0; i < out.size(); ++i) out[i] = _column_load<T>(at + i * sizeof(T));
+    }
+  }
+};
+
+template <std::integral T>
+using _column_unsigned_t = std::make_unsigned_t<T>;
+
+template <std::integral T>
+constexpr _column_unsigned_t<T> _zigzag(T v) noexcept {
+  using U = _column_unsigned_t<T>;
+  const U u = static_cast<U>(v);
+  if constexpr (std::is_signed_v<T>) return static_cast<U>((u << 1) ^ static_cast<U>(U{0} - (u >> (sizeof(U) * CHAR_BIT - 1))));
+  else return u;
+}
+
+template <std::integral T>
+constexpr T _unzigzag(std::uint64_t x) noexcept {
+  using U = _column_unsigned_t<T>;
+  const U u = static_cast<U>(x);
+  if constexpr (std::is_signed_v<T>) return static_cast<T>(static_cast<U>((u >> 1) ^ static_cast<U>(U{0} - (u & 1))));
+  else return static_cast<T>(u);
+}
+
+/*
+Bit packing, in the lane-interleaved layout of SIMD bit-packing schemes. Values are packed into words of
+Word, 32 bits for elements of up to 4 bytes and 64 bits for wider ones, and go in groups of _pack_lanes
+lanes of B = bits of Word values each: value i of a group belongs to lane i % _pack_lanes, and each lane
+packs its B values at w bits each into w words, value j of the lane at bit j * w. The words of the lanes are
+interleaved, word k of lane l at k * _pack_lanes + l, so unpacking value j of every lane is the same load,
+shift and mask across consecutive words, a loop the compiler vectorizes without any intrinsic. A partial
+last group is padded with zeros.
+*/
+inline constexpr std::size_t _pack_lanes = 8;
+
+template <std::integral T>
+using _pack_word_t = std::conditional_t<(sizeof(T) <= 4), std::uint32_t, std::uint64_t>;
+
+template <typename Word>
+inline constexpr unsigned _word_bits = sizeof(Word) * CHAR_BIT;
+
+template <typename Word>
+inline constexpr std::size_t _pack_group = _word_bits<Word> * _pack_lanes;
+
+template <typename Word>
+constexpr std::size_t _packed_bytes(std::size_t n, unsigned w) noexcept {
+  return (n + _pack_group<Word> - 1) / _pack_group<Word> * w * _pack_lanes * sizeof(Word);
+}
+
+template <typename Word>
+constexpr Word _width_mask(unsigned w) noexcept {
+  return w == _word_bits<Word> ? static_cast<Word>(~Word{0}) : static_cast<Word>((Word{1} << w) - 1);
+}
+
+template <typename Word>
+void _pack(std::span<const Word> v, unsigned w, std::vector<std::byte>& out) {
+  constexpr unsigned bits = _word_bits<Word>;
+  constexpr std::size_t group = _pack_group<Word>;
+  const std::size_t at = out.size();
+  out.resize(at + _packed_bytes<Word>(v.size(), w));
+  if (w == 0) return;
+  const Word mask = _width_mask<Word>(w);
+  std::byte* p = out.data() + at;
+  for (std::size_t g = 0; g < v.size(); g += group, p += w * _pack_lanes * sizeof(Word)) {
+    for (std::size_t l = 0; l < _pack_lanes; ++l) {
+      Word acc = 0;
+      unsigned fill = 0;
+      std::size_t k = 0;
+      for (std::size_t j = 0; j < bits; ++j) {
+        const std::size_t i = g + j * _pack_lanes + l;
+        const Word x = i < v.size() ? static_cast<Word>(v[i] & mask) : Word{0};
+        acc = static_cast<Word>(acc | (x << fill));
+        fill += w;
+        if (fill >= bits) {
+          const Word le = _to_little_endian(acc);
+          std::memcpy(p + (k++ * _pack_lanes + l) * sizeof(Word), &le, sizeof(le));
+          fill -= bits;
+          acc = fill ? static_cast<Word>(x >> (w - fill)) : Word{0};
+        }
+      }
+    }
+  }
+}
+
+template <typename Word, typename Out, typename F>
+void _unpack_group(const std::byte* in, unsigned w, Out* out, F f) {
+  constexpr unsigned bits = _word_bits<Word>;
+  if (w == 0) {
+    for (std::size_t i = 0; i < _pack_group<Word>; ++i) out[i] = f(Word{0});
+    return;
+  }
+  const Word mask = _width_mask<Word>(w);
+  const std::size_t row = _pack_lanes * sizeof(Word);
+  for (unsigned j = 0; j < bits; ++j, out += _pack_lanes) {
+    // a value that does not spill into the next word gets bits from it only above w, which the mask drops;
+    // the last word of a lane never spills, so it stands in for the word after it
+    const unsigned bit = j * w;
+    const std::byte* lo = in + bit / bits * row;
+    const std::byte* hi = in + std::min(bit / bits + 1, w - 1) * row;
+    const unsigned shift = bit % bits;
+    // copied out first so that the compiler does not have to assume out aliases the words
+    Word a[_pack_lanes], b[_pack_lanes];
+    for (std::size_t l = 0; l < _pack_lanes; ++l) {
+      a[l] = _column_load<Word>(lo + l * sizeof(Word));
+      b[l] = _column_load<Word>(hi + l * sizeof(Word));
+    }
+    for (std::size_t l = 0; l < _pack_lanes; ++l) {
+      const Word x = static_cast<Word>((a[l] >> shift) | static_cast<Word>(b[l] << 1) << (bits - 1 - shift));
+      out[l] = f(static_cast<Word>(x & mask));
+    }
+  }
+}
+
+// stores f of each of the n w-bit values packed at in to out
+template <typename Word, typename Out, typename F>
+void _unpack(const std::byte* in, std::size_t n, unsigned w, Out* out, F f) {
+  constexpr std::size_t group = _pack_group<Word>;
+  const std::size_t group_bytes = w * _pack_lanes * sizeof(Word);
+  std::size_t i = 0;
+  for (; i + group <= n; i += group, in += group_bytes) _unpack_group<Word>(in, w, out + i, f);
+  if (i < n) {
+    Out tail[group];
+    _unpack_group<Word>(in, w, tail, f);
+    std::copy_n(tail, n - i, out + i);
+  }
+}
+
+// reads a width byte and the packed values that follow it
+template <typename Word>
+const std::byte* _take_packed(_column_reader& r, std::size_t n, unsigned& w, unsigned max_width) {
+  w = r.get<std::uint8_t>();
+  if (w > max_width) _column_malformed();
+  return r.take(_packed_bytes<Word>(n, w));
+}
+
+template <std::integral T>
+constexpr unsigned _bits_of = sizeof(T) * CHAR_BIT;
+
+MINPP_IMPL_END
+
+MINPP_SUBSPACE_BEGIN(codec)
+
+/*
+A column codec is a type with an id byte and static encode and decode templates over one block of one
+integral column:
+  template <class T> static void encode(std::span<const T> values, std::vector<std::byte>& out);
+  template <class T> static void decode(impl::_column_reader& in, std::span<T> out);
+decode reads exactly what encode appended and fills out, whose size is the number of values encoded.
+*/
+
+/**
+  @brief Stores the values as they are, little-endian.
+*/
+struct raw {
+  static constexpr std::uint8_t id = 0;
+
+  template <std::integral T>
+  static void encode(std::span<const T> v, std::vector<std::byte>& out) {
+    impl::_column_put_all(out, v);
+  }
+
+  template <std::integral T>
+  static void decode(impl::_column_reader& in, std::span<T> out) {
+    in.get_all(out);
+  }
+};
+
+/**
+  @brief Bit-packs the values with the width of the largest one; signed values are zigzag encoded first,
+  so small negative values stay narrow.
+*/
+struct bit_packing {
+  static constexpr std::uint8_t id = 1;
+
+  template <std::integral T>
+  static void encode(std::span<const T> v, std::vector<std::byte>& out) {
+    using Word = impl::_pack_word_t<T>;
+    std::vector<Word> z(v.size());
+    Word all = 0;
+    for (std::size_t i = 0; i < v.size(); ++i) all |= z[i] = impl::_zigzag(v[i]);
+    const auto w = static_cast<unsigned>(std::bit_width(all));
+    impl::_column_put(out, static_cast<std::uint8_t>(w));
+    impl::_pack<Word>(z, w, out);
+  }
+
+  template <std::integral T>
+  static void decode(impl::_column_reader& in, std::span<T> out) {
+    using Word = impl::_pack_word_t<T>;
+    unsigned w;
+    const std::byte* p = impl::_take_packed<Word>(in, out.size(), w, impl::_bits_of<T>);
+    impl::_unpack<Word>(p, out.size(), w, out.data(), [](Word x) { return impl::_unzigzag<T>(x); });
+  }
+};
+
+/**
+  @brief Stores the smallest value of the block and bit-packs every value's offset from it, for columns
+  whose values sit in a narrow range far from zero.
+*/
+struct frame_of_reference {
+  static constexpr std::uint8_t id = 2;
+
+  template <std::integral T>
+  static void encode(std::span<const T> v, std::vector<std::byte>& out) {
+    using U = impl::_column_unsigned_t<T>;
+    using Word = impl::_pack_word_t<T>;
+    const T base = v.empty() ? T{} : *std::min_element(v.begin(), v.end());
+    std::vector<Word> offsets(v.size());
+    Word all = 0;
+    for (std::size_t i = 0; i < v.size(); ++i) all |= offsets[i] = static_cast<U>(static_cast<U>(v[i]) - static_cast<U>(base));
+    impl::_column_put(out, base);
+    const auto w = static_cast<unsigned>(std::bit_width(all));
+    impl::_column_put(out, static_cast<std::uint8_t>(w));
+    impl::_pack<Word>(offsets, w, out);
+  }
+
+  template <std::integral T>
+  static void decode(impl::_column_reader& in, std::span<T> out) {
+    using U = impl::_column_unsigned_t<T>;
+    using Word = impl::_pack_word_t<T>;
+    const U base = static_cast<U>(in.get<T>());
+    unsigned w;
+    const std::byte* p = impl::_take_packed<Word>(in, out.size(), w, impl::_bits_of<T>);
+    impl::_unpack<Word>(p, out.size(), w, out.data(), [base](Word x) { return static_cast<T>(static_cast<U>(base + static_cast<U>(x))); });
+  }
+};
+
+/**
+  @brief Stores the first value and bit-packs the zigzag encoded differences between neighbours, for sorted
+  or slowly changing columns such as timestamps and sequence numbers.
+*/
+struct delta {
+  static constexpr std::uint8_t id = 3;
+
+  template <std::integral T>
+  static void encode(std::span<const T> v, std::vector<std::byte>& out) {
+    using U = impl::_column_unsigned_t<T>;
+    using S = std::make_signed_t<T>;
+    using Word = impl::_pack_word_t<T>;
+    std::vector<Word> d(v.size());
+    Word all = 0;
+    U prev = v.empty() ? U{0} : static_cast<U>(v[0]);
+    for (std::size_t i = 0; i < v.size(); ++i) {
+      const U u = static_cast<U>(v[i]);
+      all |= d[i] = impl::_zigzag(static_cast<S>(static_cast<U>(u - prev)));
+      prev = u;
+    }
+    impl::_column_put(out, v.empty() ? T{} : v[0]);
+    const auto w = static_cast<unsigned>(std::bit_width(all));
+    impl::_column_put(out, static_cast<std::uint8_t>(w));
+    impl::_pack<Word>(d, w, out);
+  }
+
+  template <std::integral T>
+  static void decode(impl::_column_reader& in, std::span<T> out) {
+    using U = impl::_column_unsigned_t<T>;
+    using S = std::make_signed_t<T>;
+    using Word = impl::_pack_word_t<T>;
+    U sum = static_cast<U>(in.get<T>());
+    unsigned w;
+    const std::byte* p = impl::_take_packed<Word>(in, out.size(), w, impl::_bits_of<T>);
+    // unpacking vectorizes, the running sum does not, so they are separate passes
+    impl::_unpack<Word>(p, out.size(), w, out.data(), [](Word x) { return static_cast<T>(impl::_unzigzag<S>(x)); });
+    for (T& x: out) x = static_cast<T>(sum = static_cast<U>(sum + static_cast<U>(x)));
+  }
+};
+
+/**
+  @brief Stores each run of equal values once, with its length, for columns of long runs such as flags and
+  sorted categories.
+*/
+struct run_length {
+  static constexpr std::uint8_t id = 4;
+
+  template <std::integral T>
+  static void encode(std::span<const T> v, std::vector<std::byte>& out) {
+    std::vector<T> values;
+    std::vector<std::uint32_t> lengths;
+    for (std::size_t i = 0; i < v.size();) {
+      std::size_t j = i + 1;
+      while (j < v.size() && v[j] == v[i]) ++j;
+      values.push_back(v[i]);
+      lengths.push_back(static_cast<std::uint32_t>(j - i));
+      i = j;
+    }
+    impl::_column_put(out, static_cast<std::uint32_t>(values.size()));
+    impl::_column_put_all(out, std::span<const T>{values});
+    impl::_column_put_all(out, std::span<const std::uint32_t>{lengths});
+  }
+
+  template <std::integral T>
+  static void decode(impl::_column_reader& in, std::span<T> out) {
+    const std::size_t runs = in.get<std::uint32_t>();
+    if (runs > out.size()) impl::_column_malformed();
+    const std::byte* values = in.take(runs * sizeof(T));
+    const std::byte* lengths = in.take(runs * sizeof(std::uint32_t));
+    std::size_t at = 0;
+    for (std::size_t r = 0; r < runs; ++r) {
+      const std::size_t n = impl::_column_load<std::uint32_t>(lengths + r * sizeof(std::uint32_t));
+      if (n > out.size() - at) impl::_column_malformed();
+      std::fill_n(out.data() + at, n, impl::_column_load<T>(values + r * sizeof(T)));
+      at += n;
+    }
+    if (at != out.size()) impl::_column_malformed();
+  }
+};
+
+/**
+  @brief Stores the distinct values of the block, sorted, and bit-packs each value's index among them, for
+  columns with few distinct values spread over a wide range.
+*/
+struct dictionary {
+  static constexpr std::uint8_t id = 5;
+
+  template <std::integral T>
+  static void encode(std::span<const T> v, std::vector<std::byte>& out) {
+    // codes are handed out in first-seen order through an open-addressing table, then renumbered once the
+    // few distinct values are sorted; sorting the whole block instead costs a mispredicted branch per compare
+    const unsigned log_slots = static_cast<unsigned>(std::bit_width(std::max<std::size_t>(v.size(), 8) * 2 - 1));
+    std::vector<std::uint32_t> slots(std::size_t{1} << log_slots);
+    const std::size_t mask = slots.size() - 1;
+    std::vector<T> dict;
+    std::vector<std::uint32_t> codes(v.size());
+    for (std::size_t i = 0; i < v.size(); ++i) {
+      const auto key = static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<T>>(v[i]));
+      std::size_t h = static_cast<std::size_t>((key * 0x9e3779b97f4a7c15) >> (64 - log_slots));
+      while (slots[h] != 0 && dict[slots[h] - 1] != v[i]) h = (h + 1) & mask;
+      if (slots[h] == 0) {
+        dict.push_back(v[i]);
+        slots[h] = static_cast<std::uint32_t>(dict.size());
+      }
+      codes[i] = slots[h] - 1;
+    }
+    std::vector<std::uint32_t> order(dict.size());
+    for (std::uint32_t c = 0; c < order.size(); ++c) order[c] = c;
+    std::sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) { return dict[a] < dict[b]; });
+    std::vector<std::uint32_t> rank(dict.size());
+    std::vector<T> sorted(dict.size());
+    for (std::uint32_t r = 0; r < order.size(); ++r) {
+      rank[order[r]] = r;
+      sorted[r] = dict[order[r]];
+    }
+    dict.swap(sorted);
+    for (std::uint32_t& c: codes) c = rank[c];
+    impl::_column_put(out, static_cast<std::uint32_t>(dict.size()));
+    impl::_column_put_all(out, std::span<const T>{dict});
+    const auto w = static_cast<unsigned>(std::bit_width(dict.size() > 1 ? dict.size() - 1 : 0));
+    impl::_column_put(out, static_cast<std::uint8_t>(w));
+    impl::_pack<std::uint32_t>(codes, w, out);
+  }
+
+  template <std::integral T>
+  static void decode(impl::_column_reader& in, std::span<T> out) {
+    const std::size_t size = in.get<std::uint32_t>();
+    if (size > out.size()) impl::_column_malformed();
+    unsigned w = 0;
+    const auto expected = static_cast<unsigned>(std::bit_width(size > 1 ? size - 1 : 0));
+    // padded to every code the width can hold, so that a corrupt code reads a zero instead of past the end
+    std::vector<T> dict(std::size_t{1} << expected);
+    in.get_all(std::span<T>{dict.data(), size});
+    const std::byte* p = impl::_take_packed<std::uint32_t>(in, out.size(), w, expected);
+    if (w != expected) impl::_column_malformed();
+    const T* d = dict.data();
+    impl::_unpack<std::uint32_t>(p, out.size(), w, out.data(), [d](std::uint32_t x) { return d[x]; });
+  }
+};
+
+MINPP_SUBSPACE_END
+
+MINPP_NAMESPACE_BEGIN
+
+template <typename Tuple, typename... Codecs>
+class column_codec;
+
+/**
+  @brief Encodes sequences of tuples of integers column by column, element I with codec Codecs...[I] (see
+  minpp::codec), into blocks of a fixed number of rows that decode independently.
+  Layout, all little-endian: the magic "mpcc", the number of columns (u32), of rows (u64) and of rows per
+  block (u32), the number of blocks (u32), then the byte offset of every block from the start of the data
+  and of the end (u64 each), then the blocks. A block holds, for each column, the codec id (u8), the size of
+  the column's encoding (u32) and the encoding, so a single column of a block decodes without reading the
+  others.
+  Decoding is fastest into column spans (decode_column); decode and decode_block assemble tuples from
+  columns decoded a block at a time.
+  @note Decoding checks the format and every size against the data and throws std::invalid_argument on
+  anything that does not match, but it does not detect corrupted values.
+*/
+template <typename... Types, typename... Codecs>
+class column_codec<tuple<Types...>, Codecs...> {
+  static_assert(sizeof...(Types) == sizeof...(Codecs), "column_codec needs one codec per element");
+  static_assert((std::integral<Types> && ...), "column_codec encodes integral elements");
+  static_assert((!std::same_as<Types, bool> && ...), "column_codec does not encode bool; store it as std::uint8_t");
+
+  static constexpr char _magic[4] = {'m', 'p', 'c', 'c'};
+  static constexpr std::size_t _fixed_header = 4 + 4 + 8 + 4 + 4;
+
+  static constexpr std::size_t _header_size(std::size_t blocks) noexcept {
+    return _fixed_header + (blocks + 1) * sizeof(std::uint64_t);
+  }
+
+  public:
+  using tuple_type = tuple<Types...>;
+
+  /**
+    @throws std::invalid_argument if block_rows is 0.
+    @remarks A multiple of 64 keeps the last bit-packed group of every full block full.
+  */
+  explicit column_codec(std::size_t block_rows = 4096): _block_rows(block_rows) {
+    if (block_rows == 0 || block_rows > 0xffffffff) throw std::invalid_argument("minpp::column_codec: block_rows must be in [1, 2^32)");
+  }
+
+  std::size_t block_rows() const noexcept {
+    return _block_rows;
+  }
+
+  /**
+    @fn template<class InputIt> vector<byte> encode(InputIt first, InputIt last) const;
+    @returns The encoding of the tuples in [first, last), which may be any tuple-like elements whose
+    elements convert to Types....
+  */
+  template <std::input_iterator InputIt>
+  std::vector<std::byte> encode(InputIt first, InputIt last) const {
+    std::vector<std::byte> out;
+    std::vector<std::uint64_t> offsets;
+    tuple<std::vector<Types>...> columns;
+    std::uint64_t rows = 0;
+    minpp::apply([&](auto&... c) { (c.reserve(_block_rows), ...); }, columns);
+
+    /*
+    Blocks are written in place behind room for the header; when the row count is known up front the room
+    is exact and out is reserved at the raw size, so the only pass over the output is the encoding itself.
+    */
+    std::size_t expected_blocks = 0;
+    if constexpr (std::forward_iterator<InputIt>) {
+      const auto n = static_cast<std::size_t>(std::distance(first, last));
+      expected_blocks = (n + _block_rows - 1) / _block_rows;
+      offsets.reserve(expected_blocks);
+      out.reserve(_header_size(expected_blocks) + n * (sizeof(Types) + ...) + expected_blocks * sizeof...(Types) * 16);
+    }
+    out.resize(_header_size(expected_blocks));
+
+    auto flush = [&] {
+      offsets.push_back(out.size());
+      _encode_block(columns, out, std::index_sequence_for<Types...>{});
+      minpp::apply([](auto&... c) { (c.clear(), ...); }, columns);
+    };
+    for (; first != last; ++first) {
+      _append(columns, *first, std::index_sequence_for<Types...>{});
+      if (++rows % _block_rows == 0) flush();
+    }
+    if (rows % _block_rows != 0) flush();
+
+    const std::size_t header = _header_size(offsets.size());
+    if (header != _header_size(expected_blocks)) {
+      const std::size_t grow = header - _header_size(expected_blocks);
+      out.insert(out.begin(), grow, std::byte{});
+      for (std::uint64_t& o: offsets) o += grow;
+    }
+    std::vector<std::byte> head;
+    head.reserve(header);
+    for (char c: _magic) head.push_back(static_cast<std::byte>(c));
+    impl::_column_put(head, static_cast<std::uint32_t>(sizeof...(Types)));
+    impl::_column_put(head, rows);
+    impl::_column_put(head, static_cast<std::uint32_t>(_block_rows));
+    impl::_column_put(head, static_cast<std::uint32_t>(offsets.size()));
+    for (std::uint64_t o: offsets) impl::_column_put(head, o);
+    impl::_column_put(head, static_cast<std::uint64_t>(out.size()));
+    std::memcpy(out.data(), head.data(), header);
+    return out;
+  }
+
+  /**
+    @returns The number of rows encoded in data.
+  */
+  static std::size_t rows(std::span<const std::byte> data) {
+    return _header(data).rows;
+  }
+
+  /**
+    @returns The number of blocks in data; block b holds rows [b * block_rows, min((b + 1) * block_rows, rows)).
+  */
+  static std::size_t blocks(std::span<const std::byte> data) {
+    return _header(data).blocks;
+  }
+
+  /**
+    @brief Decodes column I of block b of data into out, which must hold the rows of the block.
+    @returns The number of values written.
+  */
+  template <std::size_t I>
+  static std::size_t decode_column(std::span<const std::byte> data, std::size_t b, std::span<std::tuple_element_t<I, tuple_type>> out) {
+    const _header_view h = _header(data);
+    const std::size_t n = h.block_size(b);
+    if (out.size() < n) throw std::invalid_argument("minpp::column_codec::decode_column: output span is too small");
+    impl::_column_reader r = h.block(b);
+    _skip_columns<I>(r);
+    _decode_one<I>(r, out.first(n));
+    return n;
+  }
+
+  /**
+    @brief Decodes column I of every block of data into out, which must hold rows(data) values.
+    @returns The number of values written.
+  */
+  template <std::size_t I>
+  static std::size_t decode_column(std::span<const std::byte> data, std::span<std::tuple_element_t<I, tuple_type>> out) {
+    const _header_view h = _header(data);
+    if (out.size() < h.rows) throw std::invalid_argument("minpp::column_codec::decode_column: output span is too small");
+    std::size_t at = 0;
+    for (std::size_t b = 0; b < h.blocks; ++b) {
+      const std::size_t n = h.block_size(b);
+      impl::_column_reader r = h.block(b);
+      _skip_columns<I>(r);
+      _decode_one<I>(r, out.subspan(at, n));
+      at += n;
+    }
+    return at;
+  }
+
+  /**
+    @fn template<class OutputIt> static OutputIt decode_block(span<const byte> data, size_t b, OutputIt out);
+    @brief Writes the tuples of block b of data to out.
+    @returns out past the last tuple written.
+  */
+  template <std::output_iterator<const tuple_type&> OutputIt>
+  static OutputIt decode_block(std::span<const std::byte> data, std::size_t b, OutputIt out) {
+    const _header_view h = _header(data);
+    tuple<std::vector<Types>...> columns;
+    return _decode_block(h, b, columns, out);
+  }
+
+  /**
+    @fn template<class OutputIt> static OutputIt decode(span<const byte> data, OutputIt out);
+    @brief Writes every tuple of data to out, in the order they were encoded.
+    @returns out past the last tuple written.
+  */
+  template <std::output_iterator<const tuple_type&> OutputIt>
+  static OutputIt decode(std::span<const std::byte> data, OutputIt out) {
+    const _header_view h = _header(data);
+    tuple<std::vector<Types>...> columns;
+    for (std::size_t b = 0; b < h.blocks; ++b) out = _decode_block(h, b, columns, out);
+    return out;
+  }
+
+  private:
+  struct _header_view {
+    std::span<const std::byte> data;
+    std::uint64_t rows;
+    std::size_t block_rows;
+    std::size_t blocks;
+    const std::byte* offsets;
+
+    std::size_t block_size(std::size_t b) const {
+      if (b >= blocks) throw std::out_of_range("minpp::column_codec: block index out of range");
+      return static_cast<std::size_t>(std::min<std::uint64_t>(block_rows, rows - b * block_rows));
+    }
+
+    impl::_column_reader block(std::size_t b) const {
+      const auto first = impl::_column_load<std::uint64_t>(offsets + b * sizeof(std::uint64_t));
+      const auto last = impl::_column_load<std::uint64_t>(offsets + (b + 1) * sizeof(std::uint64_t));
+      if (first > last || last > data.size()) impl::_column_malformed();
+      return {data.data() + first, data.data() + last};
+    }
+  };
+
+  static _header_view _header(std::span<const std::byte> data) {
+    impl::_column_reader r{data.data(), data.data() + data.size()};
+    if (std::memcmp(r.take(4), _magic, 4) != 0) impl::_column_malformed();
+    if (r.get<std::uint32_t>() != sizeof...(Types)) impl::_column_malformed();
+    _header_view h{data, r.get<std::uint64_t>(), r.get<std::uint32_t>(), r.get<std::uint32_t>(), nullptr};
+    if (h.block_rows == 0 || h.blocks != (h.rows + h.block_rows - 1) / h.block_rows) impl::_column_malformed();
+    h.offsets = r.take((h.blocks + 1) * sizeof(std::uint64_t));
+    return h;
+  }
+
+  template <typename Columns, typename E, std::size_t... Is>
+  static void _append(Columns& columns, const E& e, std::index_sequence<Is...>) {
+    using std::get;
+    (get<Is>(columns).push_back(static_cast<Types>(get<Is>(e))), ...);
+  }
+
+  template <typename Columns, std::size_t... Is>
+  static void _encode_block(const Columns& columns, std::vector<std::byte>& out, std::index_sequence<Is...>) {
+    (_encode_one<Codecs>(std::span<const Types>{get<Is>(columns)}, out), ...);
+  }
+
+  template <typename Codec, typename T>
+  static void _encode_one(std::span<const T> v, std::vector<std::byte>& out) {
+    impl::_column_put(out, Codec::id);
+    const std::size_t at = out.size();
+    impl::_column_put(out, std::uint32_t{0});
+    Codec::encode(v, out);
+    const auto size = _to_u32(out.size() - at - sizeof(std::uint32_t));
+    const auto le = impl::_to_little_endian(size);
+    std::memcpy(out.data() + at, &le, sizeof(le));
+  }
+
+  static std::uint32_t _to_u32(std::size_t n) {
+    if (n > 0xffffffff) throw std::length_error("minpp::column_codec: a column of a block encodes to 4 GiB or more");
+    return static_cast<std::uint32_t>(n);
+  }
+
+  template <std::size_t I>
+  static void _skip_columns(impl::_column_reader& r) {
+    for (std::size_t i = 0; i < I; ++i) {
+      r.take(1);
+      r.take(r.get<std::uint32_t>());
+    }
+  }
+
+  template <std::size_t I>
+  static void _decode_one(impl::_column_reader& r, std::span<std::tuple_element_t<I, tuple_type>> out) {
+    using codec = std::tuple_element_t<I, tuple<Codecs...>>;
+    if (r.get<std::uint8_t>() != codec::id) impl::_column_malformed();
+    const std::size_t size = r.get<std::uint32_t>();
+    impl::_column_reader column{r.take(size), r.p};
+    codec::decode(column, out);
+    if (column.p != column.end) impl::_column_malformed();
+  }
+
+  template <typename Columns, typename OutputIt>
+  static OutputIt _decode_block(const _header_view& h, std::size_t b, Columns& columns, OutputIt out) {
+    const std::size_t n = h.block_size(b);
+    impl::_column_reader r = h.block(b);
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      ((get<Is>(columns).resize(n), _decode_one<Is>(r, std::span{get<Is>(columns)})), ...);
+      for (std::size_t i = 0; i < n; ++i, ++out) *out = tuple_type{get<Is>(columns)[i]...};
+    }(std::index_sequence_for<Types...>{});
+    return out;
+  }
+
+  std::size_t _block_rows;
+};
+
+MINPP_NAMESPACE_END
+
+#endif
@@ -98,19 +98,19 @@ template <typename T, typename... Args>
 using is_list_constructible = typename impl::_is_list_constructible<T, template_type_holder<Args...>>;
 
 template <typename T, typename... Args>
-static constexpr bool is_list_constructible_v = is_list_constructible<T, Args...>::value;
+inline constexpr bool is_list_constructible_v = is_list_constructible<T, Args...>::value;
 
 template <typename T, T... Value_T>
 struct sum : public std::integral_constant<T, (Value_T + ...)> {};
 
 template <typename T, T... Value_T>
-static constexpr T sum_v = sum<T, Value_T...>::value;
+inline constexpr T sum_v = sum<T, Value_T...>::value;
 
 template <typename T, typename... Ts>
 struct count: public sum<std::size_t, (std::is_same_v<T, Ts>?1:0)...> {};
 
 template <typename T, typename... Ts>
-static constexpr T count_v = count<T, Ts...>::value;
+inline constexpr T count_v = count<T, Ts...>::value;
 
 /*
 Make a template parameterized by the template arguments types of other parameterized templates
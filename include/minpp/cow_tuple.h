@@ -0,0 +1,220 @@
+#ifndef MINPP_COW_TUPLE_H_
+#define MINPP_COW_TUPLE_H_
+#include "minpp/_minpp_macros.h"
+#include "minpp/tuple.h"
+
+#include <atomic>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+MINPP_IMPL_BEGIN
+
+/*
+The shared tuple and the number of cow tuples referring to it. With Concurrent the count is atomic: copies
+and releases may then happen on different threads, and a release that drops the count to zero synchronizes
+with the others (acq_rel) before it destroys the value.
+*/
+template <bool Concurrent, typename... Types>
+struct _cow_block {
+  using count_type = std::conditional_t<Concurrent, std::atomic<std::size_t>, std::size_t>;
+
+  count_type count;
+  tuple<Types...> value;
+
+  template <typename... Us>
+  explicit _cow_block(Us&&... us): count{1}, value(MINPP_FWD(us)...) {}
+
+  std::size_t load() const noexcept {
+    if constexpr (Concurrent) return count.load(std::memory_order_acquire);
+    else return count;
+  }
+
+  void acquire() noexcept {
+    if constexpr (Concurrent) count.fetch_add(1, std::memory_order_relaxed);
+    else ++count;
+  }
+
+  // returns whether this was the last reference
+  bool release() noexcept {
+    if constexpr (Concurrent) return count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    else return --count == 0;
+  }
+};
+
+MINPP_IMPL_END
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @brief A tuple that shares its value between copies: copying takes a reference, and the value is copied
+  only when it is modified through a copy that still shares it, so records that pass through stages that
+  only read them are never copied.
+  Reads (get on a const cow tuple, read(), comparisons) never copy; get on a non-const cow tuple and write()
+  first make the value unique, copying it if another cow tuple refers to it.
+  @note With Concurrent, the reference count is atomic, so copies of one value may be used, copied and
+  destroyed on different threads; without it they must stay on one thread. In both, one cow tuple is not
+  safe to modify from several threads at once, as for any object.
+  @remarks A moved-from cow tuple refers to no value; it may only be assigned to or destroyed.
+  Structured bindings to a non-const cow tuple use the non-const get and so make the value unique; bind
+  to std::as_const(t) to read without copying.
+*/
+template <bool Concurrent, typename... Types>
+class basic_cow_tuple {
+  using _block = impl::_cow_block<Concurrent, Types...>;
+
+  public:
+  using tuple_type = tuple<Types...>;
+
+  basic_cow_tuple() requires std::default_initializable<tuple_type>: _b{new _block()} {}
+
+  /**
+    @brief Constructs the shared tuple from us..., as tuple<Types...>(std::forward<Us>(us)...).
+  */
+  template <typename... Us>
+  explicit(sizeof...(Us) == 1) basic_cow_tuple(Us&&... us) requires
+    (sizeof...(Us) > 0) && ((sizeof...(Us) != 1) || (!std::is_same_v<std::remove_cvref_t<Us>, basic_cow_tuple> && ...)) &&
+    std::constructible_from<tuple_type, Us...>
+  : _b{new _block(MINPP_FWD(us)...)} {}
+
+  basic_cow_tuple(const basic_cow_tuple& other) noexcept: _b{other._b} {
+    if (_b) _b->acquire();
+  }
+
+  basic_cow_tuple(basic_cow_tuple&& other) noexcept: _b{std::exchange(other._b, nullptr)} {}
+
+  basic_cow_tuple& operator=(const basic_cow_tuple& other) noexcept {
+    basic_cow_tuple{other}.swap(*this);
+    return *this;
+  }
+
+  basic_cow_tuple& operator=(basic_cow_tuple&& other) noexcept {
+    basic_cow_tuple{std::move(other)}.swap(*this);
+    return *this;
+  }
+
+  ~basic_cow_tuple() {
+    if (_b && _b->release()) delete _b;
+  }
+
+  void swap(basic_cow_tuple& other) noexcept {
+    std::swap(_b, other._b);
+  }
+
+  friend void swap(basic_cow_tuple& a, basic_cow_tuple& b) noexcept {
+    a.swap(b);
+  }
+
+  /**
+    @returns The shared tuple, without copying it.
+  */
+  const tuple_type& read() const noexcept {
+    return _b->value;
+  }
+
+  /**
+    @returns The tuple, after copying it if other cow tuples refer to it, so that changes through the result
+    are seen by this cow tuple alone.
+  */
+  tuple_type& write() {
+    if (_b->load() != 1) _detach();
+    return _b->value;
+  }
+
+  /**
+    @returns The number of cow tuples referring to the value, 0 for a moved-from cow tuple. With Concurrent
+    the value may be stale by the time it is returned.
+  */
+  std::size_t use_count() const noexcept {
+    return _b ? _b->load() : 0;
+  }
+
+  /**
+    @returns Whether this and other refer to the same value. Comparisons still compare the elements, so
+    a shared value holding NaN does not compare equal to itself.
+  */
+  bool shares_with(const basic_cow_tuple& other) const noexcept {
+    return _b == other._b;
+  }
+
+  private:
+  void _detach() {
+    _block* copy = new _block(std::as_const(_b->value));
+    if (_b->release()) delete _b;
+    _b = copy;
+  }
+
+  _block* _b;
+};
+
+template <typename... Types>
+using cow_tuple = basic_cow_tuple<false, Types...>;
+
+template <typename... Types>
+using concurrent_cow_tuple = basic_cow_tuple<true, Types...>;
+
+/**
+  @fn template<size_t I, bool Concurrent, class... Types>
+  decltype(auto) get(const basic_cow_tuple<Concurrent, Types...>& t) noexcept;
+  @returns A const reference to element I of the shared tuple, without copying it.
+*/
+template <std::size_t I, bool Concurrent, typename... Types>
+decltype(auto) get(const basic_cow_tuple<Concurrent, Types...>& t) noexcept {
+  return get<I>(t.read());
+}
+
+/**
+  @fn template<size_t I, bool Concurrent, class... Types>
+  decltype(auto) get(basic_cow_tuple<Concurrent, Types...>& t);
+  @returns A reference to element I of t's own tuple, copying the tuple first if it is shared.
+*/
+template <std::size_t I, bool Concurrent, typename... Types>
+decltype(auto) get(basic_cow_tuple<Concurrent, Types...>& t) {
+  return get<I>(t.write());
+}
+
+template <std::size_t I, bool Concurrent, typename... Types>
+decltype(auto) get(basic_cow_tuple<Concurrent, Types...>&& t) {
+  return get<I>(std::move(t.write()));
+}
+
+template <std::size_t I, bool Concurrent, typename... Types>
+decltype(auto) get(const basic_cow_tuple<Concurrent, Types...>&& t) noexcept {
+  return get<I>(std::move(t.read()));
+}
+
+template <bool C, typename... TTypes, typename... UTypes>
+bool operator==(const basic_cow_tuple<C, TTypes...>& t, const basic_cow_tuple<C, UTypes...>& u) requires (sizeof...(TTypes) == sizeof...(UTypes)) {
+  return t.read() == u.read();
+}
+
+template <bool C, typename... TTypes, typename... UTypes>
+bool operator==(const basic_cow_tuple<C, TTypes...>& t, const tuple<UTypes...>& u) requires (sizeof...(TTypes) == sizeof...(UTypes)) {
+  return t.read() == u;
+}
+
+template <bool C, typename... TTypes, typename... UTypes>
+auto operator<=>(const basic_cow_tuple<C, TTypes...>& t, const basic_cow_tuple<C, UTypes...>& u) requires (sizeof...(TTypes) == sizeof...(UTypes)) {
+  return t.read() <=> u.read();
+}
+
+template <bool C, typename... TTypes, typename... UTypes>
+auto operator<=>(const basic_cow_tuple<C, TTypes...>& t, const tuple<UTypes...>& u) requires (sizeof...(TTypes) == sizeof...(UTypes)) {
+  return t.read() <=> u;
+}
+
+MINPP_NAMESPACE_END
+
+MINPP_STD_BEGIN
+
+template <bool Concurrent, typename... Types>
+struct tuple_size<minpp::basic_cow_tuple<Concurrent, Types...>>: std::integral_constant<std::size_t, sizeof...(Types)> {};
+
+template <std::size_t I, bool Concurrent, typename... Types>
+struct tuple_element<I, minpp::basic_cow_tuple<Concurrent, Types...>>: tuple_element<I, minpp::tuple<Types...>> {};
+
+MINPP_STD_END
+
+#endif
@@ -0,0 +1,260 @@
+#ifndef MINPP_DYNAMIC_TUPLE_H_
+#define MINPP_DYNAMIC_TUPLE_H_
+#include "minpp/_minpp_macros.h"
+#include "minpp/tuple.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @brief Runtime description of a column type: its size, alignment and how to construct, copy and destroy it.
+  Every type has exactly one descriptor, obtained with column_of<T>(), so descriptors compare by address.
+*/
+struct column_type {
+  std::size_t size;
+  std::size_t align;
+  void (*construct)(void* p);
+  void (*copy)(void* dst, const void* src);
+  void (*destroy)(void* p) noexcept;
+};
+
+MINPP_NAMESPACE_END
+
+MINPP_IMPL_BEGIN
+
+template <typename T>
+inline constexpr column_type _column_type{
+  sizeof(T),
+  alignof(T),
+  [](void* p) { ::new (p) T(); },
+  [](void* dst, const void* src) { ::new (dst) T(*static_cast<const T*>(src)); },
+  [](void* p) noexcept { static_cast<T*>(p)->~T(); }
+};
+
+constexpr std::size_t _align_up(std::size_t n, std::size_t align) noexcept {
+  return (n + align - 1) / align * align;
+}
+
+/*
+Size of tuple<Ts...> according to the rule tuple_layout uses: every tuple_leaf is a base holding a single
+non-empty member, so leaves are laid out in order, each at the next offset aligned for its type, and the
+whole is padded to the largest alignment. The array a homogeneous tuple is stored in follows the same rule.
+*/
+template <typename... Ts>
+constexpr std::size_t _tuple_layout_size() noexcept {
+  std::size_t end = 0;
+  std::size_t align = 1;
+  ((end = _align_up(end, alignof(Ts)) + sizeof(Ts), align = std::max(align, alignof(Ts))), ...);
+  return _align_up(std::max<std::size_t>(end, 1), align);
+}
+
+MINPP_IMPL_END
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @fn template<class T> constexpr const column_type* column_of() noexcept;
+  @returns The descriptor of T.
+  @pre T is a non-empty, copy constructible object type. Empty types are excluded because tuple stores them
+  in empty base leaves that take no space of their own.
+*/
+template <typename T>
+constexpr const column_type* column_of() noexcept {
+  static_assert(std::is_object_v<T> && !std::is_empty_v<T> && std::is_copy_constructible_v<T>,
+    "dynamic tuple columns must be non-empty, copy constructible object types");
+  return &impl::_column_type<T>;
+}
+
+/**
+  @brief Runtime layout of a row: the column types with offsets, size and alignment computed by the rule
+  the compiler applies to tuple's leaves, so a row laid out for Ts... has the layout of tuple<Ts...>.
+*/
+class tuple_layout {
+  public:
+  tuple_layout() = default;
+
+  tuple_layout(std::initializer_list<const column_type*> columns): tuple_layout(std::vector<const column_type*>(columns)) {}
+
+  explicit tuple_layout(std::vector<const column_type*> columns): _columns{std::move(columns)} {
+    _offsets.reserve(_columns.size());
+    std::size_t end = 0;
+    for (const column_type* c: _columns) {
+      end = impl::_align_up(end, c->align);
+      _offsets.push_back(end);
+      end += c->size;
+      _alignment = std::max(_alignment, c->align);
+    }
+    _size_bytes = impl::_align_up(std::max<std::size_t>(end, 1), _alignment);
+  }
+
+  template <typename... Ts>
+  static tuple_layout of() {
+    return tuple_layout{{column_of<Ts>()...}};
+  }
+
+  std::size_t size() const noexcept { return _columns.size(); }
+  std::size_t size_bytes() const noexcept { return _size_bytes; }
+  std::size_t alignment() const noexcept { return _alignment; }
+
+  const column_type& column(std::size_t i) const { return *_columns.at(i); }
+  std::size_t offset(std::size_t i) const { return _offsets.at(i); }
+
+  /**
+    @returns Whether a row of this layout can be viewed as a Tuple, i.e. Tuple is tuple<Ts...> and the
+    columns are exactly Ts....
+  */
+  template <typename Tuple>
+  bool matches() const noexcept {
+    return _matches(static_cast<Tuple*>(nullptr));
+  }
+
+  friend bool operator==(const tuple_layout& a, const tuple_layout& b) noexcept {
+    return a._columns == b._columns;
+  }
+
+  private:
+  template <typename... Ts>
+  bool _matches(tuple<Ts...>*) const noexcept {
+    static_assert(impl::_tuple_layout_size<Ts...>() == sizeof(tuple<Ts...>) && std::max({std::size_t{1}, alignof(Ts)...}) == alignof(tuple<Ts...>),
+      "tuple is not laid out as tuple_layout assumes on this compiler");
+    if (_columns.size() != sizeof...(Ts)) return false;
+    std::size_t i = 0;
+    return ((_columns[i++] == column_of<Ts>()) && ...);
+  }
+
+  std::vector<const column_type*> _columns;
+  std::vector<std::size_t> _offsets;
+  std::size_t _size_bytes = 1;
+  std::size_t _alignment = 1;
+};
+
+/**
+  @brief A row whose columns are only known at runtime, stored in memory obtained from an arena.
+  The row is laid out as described by its tuple_layout, which is the layout of the corresponding tuple, so
+  compiled code paths can view it as that tuple without copying (see as).
+  @note The layout is referenced, not copied, and must outlive the row. Storage is returned to the arena when
+  the row is destroyed; with a monotonic_buffer_resource that is a no-op and rows are released all at once.
+*/
+class dynamic_tuple {
+  public:
+  /**
+    @brief Value-initializes every column of a row with layout l, allocated from arena.
+  */
+  explicit dynamic_tuple(const tuple_layout& l, std::pmr::memory_resource* arena = std::pmr::get_default_resource())
+  : _layout{&l}, _arena{arena}, _data{static_cast<std::byte*>(arena->allocate(l.size_bytes(), l.alignment()))} {
+    std::size_t i = 0;
+    try {
+      for (; i < l.size(); ++i) l.column(i).construct(_data + l.offset(i));
+    }
+    catch (...) {
+      _destroy(i);
+      throw;
+    }
+  }
+
+  dynamic_tuple(const dynamic_tuple& other): dynamic_tuple(other, other._arena) {}
+
+  /**
+    @brief Copies other column by column into storage allocated from arena.
+  */
+  dynamic_tuple(const dynamic_tuple& other, std::pmr::memory_resource* arena)
+  : _layout{other._layout}, _arena{arena}, _data{static_cast<std::byte*>(arena->allocate(_layout->size_bytes(), _layout->alignment()))} {
+    std::size_t i = 0;
+    try {
+      for (; i < _layout->size(); ++i) _layout->column(i).copy(_data + _layout->offset(i), other._data + _layout->offset(i));
+    }
+    catch (...) {
+      _destroy(i);
+      throw;
+    }
+  }
+
+  dynamic_tuple(dynamic_tuple&& other) noexcept
+  : _layout{other._layout}, _arena{other._arena}, _data{std::exchange(other._data, nullptr)} {}
+
+  dynamic_tuple& operator=(dynamic_tuple other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~dynamic_tuple() {
+    if (_data) _destroy(_layout->size());
+  }
+
+  void swap(dynamic_tuple& other) noexcept {
+    std::swap(_layout, other._layout);
+    std::swap(_arena, other._arena);
+    std::swap(_data, other._data);
+  }
+
+  const tuple_layout& layout() const noexcept { return *_layout; }
+  std::size_t size() const noexcept { return _layout->size(); }
+
+  void* data() noexcept { return _data; }
+  const void* data() const noexcept { return _data; }
+
+  /**
+    @returns A reference to column i.
+    @throws std::out_of_range if i >= size(), std::bad_cast if column i is not a T.
+  */
+  template <typename T>
+  T& get(std::size_t i) {
+    return *static_cast<T*>(_checked<T>(i));
+  }
+
+  template <typename T>
+  const T& get(std::size_t i) const {
+    return *static_cast<const T*>(const_cast<dynamic_tuple&>(*this)._checked<T>(i));
+  }
+
+  /**
+    @returns The row viewed as a Tuple, without copying.
+    @throws std::bad_cast if layout().matches<Tuple>() is false.
+    @note The columns are constructed individually; the view relies on tuple having exactly the layout
+    tuple_layout computes, which matches checks at compile time.
+  */
+  template <typename Tuple>
+  Tuple& as() {
+    if (!_layout->matches<Tuple>()) throw std::bad_cast{};
+    return *std::launder(reinterpret_cast<Tuple*>(_data));
+  }
+
+  template <typename Tuple>
+  const Tuple& as() const {
+    return const_cast<dynamic_tuple&>(*this).as<Tuple>();
+  }
+
+  private:
+  template <typename T>
+  void* _checked(std::size_t i) {
+    if (&_layout->column(i) != column_of<T>()) throw std::bad_cast{};
+    return _data + _layout->offset(i);
+  }
+
+  void _destroy(std::size_t constructed) noexcept {
+    while (constructed-- > 0) _layout->column(constructed).destroy(_data + _layout->offset(constructed));
+    _arena->deallocate(_data, _layout->size_bytes(), _layout->alignment());
+  }
+
+  const tuple_layout* _layout;
+  std::pmr::memory_resource* _arena;
+  std::byte* _data;
+};
+
+inline void swap(dynamic_tuple& a, dynamic_tuple& b) noexcept {
+  a.swap(b);
+}
+
+MINPP_NAMESPACE_END
+
+#endif
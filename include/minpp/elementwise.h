@@ -0,0 +1,433 @@
+#ifndef MINPP_ELEMENTWISE_H_
+#define MINPP_ELEMENTWISE_H_
+#include "minpp/_minpp_macros.h"
+#include "minpp/tuple.h"
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/*
+Homogeneous expressions are evaluated in GCC/Clang vector types (__attribute__((vector_size))), which the
+compiler maps to SSE/AVX registers; MINPP_ELEMENTWISE_VECTOR_BYTES is the widest vector used, 16 by default
+and 32 or 64 when the target has AVX or AVX-512, so that no vector is passed in a way the target's ABI does
+not cover. Define MINPP_ELEMENTWISE_VECTOR_EXT as 0 to always evaluate element by element.
+*/
+#ifndef MINPP_ELEMENTWISE_VECTOR_EXT
+#if defined(__GNUC__) || defined(__clang__)
+#define MINPP_ELEMENTWISE_VECTOR_EXT 1
+#else
+#define MINPP_ELEMENTWISE_VECTOR_EXT 0
+#endif
+#endif
+
+#ifndef MINPP_ELEMENTWISE_VECTOR_BYTES
+#if defined(__AVX512F__)
+#define MINPP_ELEMENTWISE_VECTOR_BYTES 64
+#elif defined(__AVX__)
+#define MINPP_ELEMENTWISE_VECTOR_BYTES 32
+#else
+#define MINPP_ELEMENTWISE_VECTOR_BYTES 16
+#endif
+#endif
+
+MINPP_SUBSPACE_BEGIN(elementwise)
+
+template <typename Node>
+class expression;
+
+MINPP_SUBSPACE_END
+
+MINPP_IMPL_BEGIN
+
+template <typename T>
+concept _lane_type = std::is_arithmetic_v<T> && !std::same_as<T, bool>;
+
+template <typename T>
+inline constexpr bool _is_lane_tuple = false;
+
+template <typename... Types>
+inline constexpr bool _is_lane_tuple<tuple<Types...>> = (sizeof...(Types) > 0) && (_lane_type<Types> && ...);
+
+template <typename T>
+inline constexpr bool _is_elementwise_expression = false;
+
+template <typename Node>
+inline constexpr bool _is_elementwise_expression<elementwise::expression<Node>> = true;
+
+/*
+Expression nodes. A tuple operand is held by reference when it is an lvalue and by value when it is an
+rvalue, so that an expression built from temporaries can be kept; subexpressions and scalars are held by
+value. at<I>() computes element I of the node.
+*/
+template <typename Tuple>
+struct _tuple_node {
+  static constexpr std::size_t size = std::tuple_size_v<std::remove_cvref_t<Tuple>>;
+
+  Tuple t;
+
+  template <std::size_t I>
+  MINPP_ALWAYS_INLINE constexpr auto at() const {
+    return get<I>(t);
+  }
+};
+
+template <typename S>
+struct _scalar_node {
+  S s;
+};
+
+template <typename T>
+inline constexpr bool _is_scalar_node = false;
+
+template <typename S>
+inline constexpr bool _is_scalar_node<_scalar_node<S>> = true;
+
+// a scalar is converted to the type of the element it is combined with, as in std::valarray
+template <std::size_t I, typename Node, typename Other>
+MINPP_ALWAYS_INLINE constexpr auto _at(const Node& n, const Other& other) {
+  if constexpr (_is_scalar_node<Node>) return static_cast<decltype(other.template at<I>())>(n.s);
+  else return n.template at<I>();
+}
+
+template <typename Op, typename L, typename R>
+struct _binary_node {
+  using op = Op;
+  static constexpr std::size_t size = std::conditional_t<_is_scalar_node<L>, R, L>::size;
+
+  L l;
+  R r;
+
+  template <std::size_t I>
+  MINPP_ALWAYS_INLINE constexpr auto at() const {
+    return Op{}(_at<I>(l, r), _at<I>(r, l));
+  }
+};
+
+template <typename Op, typename X>
+struct _unary_node {
+  using op = Op;
+  static constexpr std::size_t size = X::size;
+
+  X x;
+
+  template <std::size_t I>
+  MINPP_ALWAYS_INLINE constexpr auto at() const {
+    return Op{}(x.template at<I>());
+  }
+};
+
+/*
+The operations are written once for scalars and vector types alike; min and max are spelled like std::min and
+std::max so that both paths agree on NaNs and ties.
+*/
+struct _plus {
+  template <typename A, typename B>
+  MINPP_ALWAYS_INLINE constexpr auto operator()(A a, B b) const { return a + b; }
+};
+
+struct _minus {
+  template <typename A, typename B>
+  MINPP_ALWAYS_INLINE constexpr auto operator()(A a, B b) const { return a - b; }
+};
+
+struct _multiplies {
+  template <typename A, typename B>
+  MINPP_ALWAYS_INLINE constexpr auto operator()(A a, B b) const { return a * b; }
+};
+
+struct _divides {
+  template <typename A, typename B>
+  MINPP_ALWAYS_INLINE constexpr auto operator()(A a, B b) const { return a / b; }
+};
+
+struct _min {
+  template <typename A>
+  MINPP_ALWAYS_INLINE constexpr A operator()(A a, A b) const { return b < a ? b : a; }
+};
+
+struct _max {
+  template <typename A>
+  MINPP_ALWAYS_INLINE constexpr A operator()(A a, A b) const { return a < b ? b : a; }
+};
+
+struct _negate {
+  template <typename A>
+  MINPP_ALWAYS_INLINE constexpr auto operator()(A a) const { return -a; }
+};
+
+template <typename Node, typename Is = std::make_index_sequence<Node::size>>
+struct _node_value;
+
+template <typename Node, std::size_t... Is>
+struct _node_value<Node, std::index_sequence<Is...>> {
+  using type = tuple<decltype(std::declval<const Node&>().template at<Is>())...>;
+};
+
+template <typename Node>
+using _node_value_t = typename _node_value<Node>::type;
+
+template <typename X>
+constexpr auto _node_of(X&& x) {
+  using D = std::remove_cvref_t<X>;
+  if constexpr (_is_elementwise_expression<D>) return MINPP_FWD(x).node();
+  else if constexpr (_is_lane_tuple<D>) {
+    if constexpr (std::is_lvalue_reference_v<X>) return _tuple_node<const D&>{x};
+    else return _tuple_node<D>{std::move(x)};
+  }
+  else return _scalar_node<D>{x};
+}
+
+template <typename X>
+concept _vector_operand = _is_lane_tuple<std::remove_cvref_t<X>> || _is_elementwise_expression<std::remove_cvref_t<X>>;
+
+template <typename X>
+concept _scalar_operand = _lane_type<std::remove_cvref_t<X>>;
+
+template <typename X>
+inline constexpr std::size_t _operand_size = decltype(_node_of(std::declval<X>()))::size;
+
+template <typename L, typename R>
+concept _elementwise_operands =
+  (_vector_operand<L> && _vector_operand<R> && _operand_size<L> == _operand_size<R>) ||
+  (_vector_operand<L> && _scalar_operand<R>) || (_scalar_operand<L> && _vector_operand<R>);
+
+template <typename Op, typename L, typename R>
+constexpr auto _make_binary(L&& l, R&& r) {
+  using node = _binary_node<Op, decltype(_node_of(MINPP_FWD(l))), decltype(_node_of(MINPP_FWD(r)))>;
+  return elementwise::expression<node>{node{_node_of(MINPP_FWD(l)), _node_of(MINPP_FWD(r))}};
+}
+
+#if MINPP_ELEMENTWISE_VECTOR_EXT
+
+/*
+A node whose elements, operands and intermediate results all have the same type T is evaluated in one vector
+of its N elements when N * sizeof(T) is a vector the target has: 16 bytes, or up to
+MINPP_ELEMENTWISE_VECTOR_BYTES. Other sizes are evaluated element by element: padding a 3-element tuple to 4
+lanes costs more in shuffles than it saves, and stops the compiler from vectorizing a loop over such tuples.
+*/
+template <typename T, typename Node>
+inline constexpr bool _uniform_node = false;
+
+template <typename T, typename Tuple>
+inline constexpr bool _uniform_node<T, _tuple_node<Tuple>> = []<std::size_t... Is>(std::index_sequence<Is...>) {
+  return (std::is_same_v<std::tuple_element_t<Is, std::remove_cvref_t<Tuple>>, T> && ...);
+}(std::make_index_sequence<_tuple_node<Tuple>::size>{});
+
+template <typename T, typename S>
+inline constexpr bool _uniform_node<T, _scalar_node<S>> = true;
+
+template <typename T, typename Node>
+inline constexpr bool _uniform_result = []<std::size_t... Is>(std::index_sequence<Is...>) {
+  return (std::is_same_v<std::tuple_element_t<Is, _node_value_t<Node>>, T> && ...);
+}(std::make_index_sequence<Node::size>{});
+
+template <typename T, typename Op, typename L, typename R>
+inline constexpr bool _uniform_node<T, _binary_node<Op, L, R>> =
+  _uniform_node<T, L> && _uniform_node<T, R> && _uniform_result<T, _binary_node<Op, L, R>>;
+
+template <typename T, typename Op, typename X>
+inline constexpr bool _uniform_node<T, _unary_node<Op, X>> = _uniform_node<T, X> && _uniform_result<T, _unary_node<Op, X>>;
+
+template <typename T, std::size_t N>
+using _vector_t [[gnu::vector_size(N * sizeof(T))]] = T;
+
+template <typename Node, typename T = std::tuple_element_t<0, _node_value_t<Node>>>
+inline constexpr bool _vectorizable = !std::is_same_v<T, long double> && std::has_single_bit(Node::size * sizeof(T)) &&
+  Node::size * sizeof(T) >= 16 && Node::size * sizeof(T) <= MINPP_ELEMENTWISE_VECTOR_BYTES && _uniform_node<T, Node>;
+
+template <typename T, std::size_t N, typename Node>
+MINPP_ALWAYS_INLINE constexpr _vector_t<T, N> _vector_of(const Node& n) {
+  if constexpr (_is_scalar_node<Node>) {
+    return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      return _vector_t<T, N>{(static_cast<void>(Is), static_cast<T>(n.s))...};
+    }(std::make_index_sequence<N>{});
+  }
+  else if constexpr (requires { n.t; }) {
+    return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      return _vector_t<T, N>{get<Is>(n.t)...};
+    }(std::make_index_sequence<N>{});
+  }
+  else if constexpr (requires { n.x; }) return typename Node::op{}(_vector_of<T, N>(n.x));
+  else return typename Node::op{}(_vector_of<T, N>(n.l), _vector_of<T, N>(n.r));
+}
+
+#endif
+
+template <typename Node>
+constexpr _node_value_t<Node> _eval(const Node& n) {
+#if MINPP_ELEMENTWISE_VECTOR_EXT
+  if constexpr (_vectorizable<Node>) {
+    if (!std::is_constant_evaluated()) {
+      using T = std::tuple_element_t<0, _node_value_t<Node>>;
+      const auto v = _vector_of<T, Node::size>(n);
+      return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        return _node_value_t<Node>{v[Is]...};
+      }(std::make_index_sequence<Node::size>{});
+    }
+  }
+#endif
+  return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    return _node_value_t<Node>{n.template at<Is>()...};
+  }(std::make_index_sequence<Node::size>{});
+}
+
+template <typename Node>
+constexpr auto _sum(const Node& n) {
+#if MINPP_ELEMENTWISE_VECTOR_EXT
+  if constexpr (_vectorizable<Node>) {
+    if (!std::is_constant_evaluated()) {
+      using T = std::tuple_element_t<0, _node_value_t<Node>>;
+      const auto v = _vector_of<T, Node::size>(n);
+      return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        return (... + v[Is]);
+      }(std::make_index_sequence<Node::size>{});
+    }
+  }
+#endif
+  return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    return (... + n.template at<Is>());
+  }(std::make_index_sequence<Node::size>{});
+}
+
+MINPP_IMPL_END
+
+MINPP_SUBSPACE_BEGIN(elementwise)
+
+/**
+  @brief An element-wise operation on tuples of arithmetic elements, evaluated when it is converted to its
+  value_type (or by eval), so that a whole expression such as a * s + b produces its result in one pass
+  without intermediate tuples.
+  @note An expression refers to the lvalue tuples it was built from; it must not outlive them.
+*/
+template <typename Node>
+class expression {
+  public:
+  using value_type = impl::_node_value_t<Node>;
+
+  static constexpr std::size_t size = Node::size;
+
+  constexpr explicit expression(Node node): _node(std::move(node)) {}
+
+  constexpr const Node& node() const& noexcept {
+    return _node;
+  }
+
+  constexpr Node&& node() && noexcept {
+    return std::move(_node);
+  }
+
+  /**
+    @returns The tuple of results.
+  */
+  constexpr value_type eval() const {
+    return impl::_eval(_node);
+  }
+
+  constexpr operator value_type() const {
+    return eval();
+  }
+
+  private:
+  Node _node;
+};
+
+/**
+  @brief Element-wise arithmetic on minpp::tuple, found after `using namespace minpp::elementwise;`.
+  Operands are tuples of arithmetic (non-bool) elements of the same size, expressions, or a scalar on one
+  side, which is applied to every element after being converted to that element's type, as in
+  std::valarray. Each element of the result has the type the operation gives its pair of elements.
+  @remarks When every element, operand and intermediate result has the same type, the expression is
+  computed in vector registers (see MINPP_ELEMENTWISE_VECTOR_EXT).
+*/
+template <typename L, typename R>
+constexpr auto operator+(L&& l, R&& r) requires impl::_elementwise_operands<L, R> {
+  return impl::_make_binary<impl::_plus>(MINPP_FWD(l), MINPP_FWD(r));
+}
+
+template <typename L, typename R>
+constexpr auto operator-(L&& l, R&& r) requires impl::_elementwise_operands<L, R> {
+  return impl::_make_binary<impl::_minus>(MINPP_FWD(l), MINPP_FWD(r));
+}
+
+template <typename L, typename R>
+constexpr auto operator*(L&& l, R&& r) requires impl::_elementwise_operands<L, R> {
+  return impl::_make_binary<impl::_multiplies>(MINPP_FWD(l), MINPP_FWD(r));
+}
+
+template <typename L, typename R>
+constexpr auto operator/(L&& l, R&& r) requires impl::_elementwise_operands<L, R> {
+  return impl::_make_binary<impl::_divides>(MINPP_FWD(l), MINPP_FWD(r));
+}
+
+template <typename X>
+constexpr auto operator-(X&& x) requires impl::_vector_operand<X> {
+  using node = impl::_unary_node<impl::_negate, decltype(impl::_node_of(MINPP_FWD(x)))>;
+  return expression<node>{node{impl::_node_of(MINPP_FWD(x))}};
+}
+
+/**
+  @fn template<class L, class R> constexpr auto min(L&& l, R&& r);
+  @returns The element-wise minimum of l and r, as std::min of each pair of elements.
+*/
+template <typename L, typename R>
+constexpr auto min(L&& l, R&& r) requires impl::_elementwise_operands<L, R> {
+  return impl::_make_binary<impl::_min>(MINPP_FWD(l), MINPP_FWD(r));
+}
+
+/**
+  @fn template<class L, class R> constexpr auto max(L&& l, R&& r);
+  @returns The element-wise maximum of l and r, as std::max of each pair of elements.
+*/
+template <typename L, typename R>
+constexpr auto max(L&& l, R&& r) requires impl::_elementwise_operands<L, R> {
+  return impl::_make_binary<impl::_max>(MINPP_FWD(l), MINPP_FWD(r));
+}
+
+/**
+  @fn template<class L, class R> constexpr auto dot(L&& l, R&& r);
+  @returns The sum of the products of the elements of l and r, added from the first element to the last.
+*/
+template <typename L, typename R>
+constexpr auto dot(L&& l, R&& r) requires impl::_vector_operand<L> && impl::_vector_operand<R> && impl::_elementwise_operands<L, R> {
+  return impl::_sum(impl::_make_binary<impl::_multiplies>(MINPP_FWD(l), MINPP_FWD(r)).node());
+}
+
+/**
+  @fn template<class X> constexpr auto eval(X&& x);
+  @returns The tuple of results of the expression x; a tuple is returned as it is.
+*/
+template <typename X>
+constexpr auto eval(X&& x) requires impl::_vector_operand<X> {
+  if constexpr (impl::_is_elementwise_expression<std::remove_cvref_t<X>>) return x.eval();
+  else return std::remove_cvref_t<X>(MINPP_FWD(x));
+}
+
+/**
+  @brief Compound assignment: t op= r assigns the result of t op r to t, which may also appear in r.
+*/
+template <typename... Types, typename R>
+constexpr tuple<Types...>& operator+=(tuple<Types...>& t, R&& r) requires impl::_elementwise_operands<tuple<Types...>&, R> {
+  return t = (t + MINPP_FWD(r)).eval();
+}
+
+template <typename... Types, typename R>
+constexpr tuple<Types...>& operator-=(tuple<Types...>& t, R&& r) requires impl::_elementwise_operands<tuple<Types...>&, R> {
+  return t = (t - MINPP_FWD(r)).eval();
+}
+
+template <typename... Types, typename R>
+constexpr tuple<Types...>& operator*=(tuple<Types...>& t, R&& r) requires impl::_elementwise_operands<tuple<Types...>&, R> {
+  return t = (t * MINPP_FWD(r)).eval();
+}
+
+template <typename... Types, typename R>
+constexpr tuple<Types...>& operator/=(tuple<Types...>& t, R&& r) requires impl::_elementwise_operands<tuple<Types...>&, R> {
+  return t = (t / MINPP_FWD(r)).eval();
+}
+
+MINPP_SUBSPACE_END
+
+#endif
@@ -0,0 +1,232 @@
+#ifndef MINPP_FORMAT_H_
+#define MINPP_FORMAT_H_
+#include "minpp/_minpp_macros.h"
+#include "minpp/tuple.h"
+
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#define MINPP_FORMAT_HAS_FD 1
+#else
+#define MINPP_FORMAT_HAS_FD 0
+#endif
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+MINPP_IMPL_BEGIN
+
+template <typename T>
+concept _text_field = std::same_as<T, bool> || std::same_as<T, char> || std::integral<T> || std::floating_point<T> ||
+  std::is_enum_v<T> || std::convertible_to<const T&, std::string_view>;
+
+template <typename Buffer>
+void _append(Buffer& out, const char* first, const char* last) {
+  out.insert(out.end(), first, last);
+}
+
+/*
+Numbers go through std::to_chars into a stack buffer large enough for any integer and for the shortest
+round-trip form of any double, then into out with a single insert; nothing touches a locale.
+*/
+template <typename Buffer, typename T>
+void _format_field(Buffer& out, const T& v) {
+  if constexpr (std::same_as<T, bool>) {
+    const std::string_view s = v ? "true" : "false";
+    _append(out, s.data(), s.data() + s.size());
+  }
+  else if constexpr (std::same_as<T, char>) out.push_back(v);
+  else if constexpr (std::is_enum_v<T>) _format_field(out, static_cast<std::underlying_type_t<T>>(v));
+  else if constexpr (std::integral<T> || std::floating_point<T>) {
+    char digits[64];
+    const auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), v);
+    _append(out, digits, end);
+  }
+  else {
+    const std::string_view s = v;
+    _append(out, s.data(), s.data() + s.size());
+  }
+}
+
+template <typename Buffer, typename Tuple, std::size_t... Is>
+void _format_tuple(Buffer& out, const Tuple& t, char delimiter, std::index_sequence<Is...>) {
+  ((Is == 0 ? void() : out.push_back(delimiter), _format_field(out, get<Is>(t))), ...);
+}
+
+template <typename Tuple>
+inline constexpr bool _text_row = []<std::size_t... Is>(std::index_sequence<Is...>) {
+  return (_text_field<std::remove_cvref_t<std::tuple_element_t<Is, Tuple>>> && ...);
+}(std::make_index_sequence<std::tuple_size_v<Tuple>>{});
+
+MINPP_IMPL_END
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @fn template<class Buffer, class... Types>
+  void format_to(Buffer& out, const tuple<Types...>& t, char delimiter = ',');
+  @brief Appends the elements of t to out, separated by delimiter. Integers and floating point numbers are
+  written with std::to_chars (floating point in the shortest form that reads back to the same value), bool as
+  true or false, char as itself, enumerations as their underlying value and strings as they are.
+  @note No quoting is done, so the output reads back with parse_delimited as long as no string element holds
+  the delimiter or a newline.
+  @remarks Buffer is a sequence container of char, e.g. std::string or std::vector<char>.
+*/
+template <typename Buffer, typename... Types>
+void format_to(Buffer& out, const tuple<Types...>& t, char delimiter = ',') {
+  static_assert(impl::_text_row<tuple<Types...>>, "elements must be arithmetic, enumerations or convertible to std::string_view");
+  impl::_format_tuple(out, t, delimiter, std::index_sequence_for<Types...>{});
+}
+
+/**
+  @fn template<class Buffer, class Rows>
+  void write_rows(Buffer& out, const Rows& rows, char delimiter = ',');
+  @brief Appends every tuple of the range rows to out as by format_to, each followed by '\n'.
+*/
+template <typename Buffer, typename Rows>
+void write_rows(Buffer& out, const Rows& rows, char delimiter = ',') requires (!std::integral<Buffer>) {
+  for (const auto& row: rows) {
+    minpp::format_to(out, row, delimiter);
+    out.push_back('\n');
+  }
+}
+
+#if MINPP_FORMAT_HAS_FD
+
+/**
+  @brief Formats tuples into a reusable buffer and writes it to a file descriptor whenever it holds
+  buffer_size bytes, so that a large dump costs one write call per buffer instead of stream calls per field.
+  @note The descriptor is not owned. The destructor flushes what is left and ignores errors; call flush()
+  first to see them.
+*/
+class row_writer {
+  public:
+  static constexpr std::size_t default_buffer_size = std::size_t{1} << 16;
+
+  explicit row_writer(int fd, char delimiter = ',', std::size_t buffer_size = default_buffer_size)
+  : _fd{fd}, _delimiter{delimiter}, _buffer_size{buffer_size} {
+    _buffer.reserve(buffer_size + 256);
+  }
+
+  row_writer(const row_writer&) = delete;
+  row_writer& operator=(const row_writer&) = delete;
+
+  ~row_writer() {
+    try {
+      flush();
+    }
+    catch (...) {}
+  }
+
+  /**
+    @brief Formats t and a newline into the buffer, writing the buffer out if it is full.
+    @throws std::system_error if write fails.
+  */
+  template <typename... Types>
+  void write(const tuple<Types...>& t) {
+    minpp::format_to(_buffer, t, _delimiter);
+    _buffer.push_back('\n');
+    if (_buffer.size() >= _buffer_size) flush();
+  }
+
+  template <typename Rows>
+  void write_rows(const Rows& rows) {
+    for (const auto& row: rows) write(row);
+  }
+
+  /**
+    @brief Writes the buffered rows, retrying partial and interrupted writes.
+    @throws std::system_error if write fails.
+  */
+  void flush() {
+    const char* p = _buffer.data();
+    std::size_t n = _buffer.size();
+    while (n > 0) {
+      const auto written = ::write(_fd, p, n);
+      if (written < 0) {
+        if (errno == EINTR) continue;
+        const int error = errno;
+        _buffer.erase(0, static_cast<std::size_t>(p - _buffer.data()));
+        throw std::system_error(error, std::generic_category(), "minpp::row_writer: write failed");
+      }
+      p += written;
+      n -= static_cast<std::size_t>(written);
+    }
+    _buffer.clear();
+  }
+
+  private:
+  int _fd;
+  char _delimiter;
+  std::size_t _buffer_size;
+  std::string _buffer;
+};
+
+/**
+  @fn template<class Rows>
+  void write_rows(int fd, const Rows& rows, char delimiter = ',');
+  @brief Writes every tuple of the range rows to fd as by format_to, each followed by '\n', through a
+  row_writer.
+  @throws std::system_error if write fails.
+*/
+template <typename Rows>
+void write_rows(int fd, const Rows& rows, char delimiter = ',') {
+  row_writer w{fd, delimiter};
+  w.write_rows(rows);
+  w.flush();
+}
+
+#endif
+
+MINPP_NAMESPACE_END
+
+#if defined(__cpp_lib_format)
+
+MINPP_STD_BEGIN
+
+/**
+  @brief Formats a tuple as (e0, e1, ...) with each element formatted by its own formatter, like the C++23
+  formatter for std::tuple. The n option drops the parentheses.
+*/
+template <typename... Types>
+struct formatter<minpp::tuple<Types...>, char> {
+  bool brackets = true;
+
+  constexpr auto parse(format_parse_context& ctx) {
+    auto it = ctx.begin();
+    if (it != ctx.end() && *it == 'n') {
+      brackets = false;
+      ++it;
+    }
+    if (it != ctx.end() && *it != '}') throw format_error("invalid format specification for minpp::tuple");
+    return it;
+  }
+
+  template <typename FormatContext>
+  auto format(const minpp::tuple<Types...>& t, FormatContext& ctx) const {
+    auto out = ctx.out();
+    if (brackets) *out++ = '(';
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      ((out = std::format_to(out, Is == 0 ? "{}" : ", {}", minpp::get<Is>(t))), ...);
+    }(std::index_sequence_for<Types...>{});
+    if (brackets) *out++ = ')';
+    return out;
+  }
+};
+
+MINPP_STD_END
+
+#endif
+
+#endif
@@ -0,0 +1,409 @@
+#ifndef MINPP_GROUP_BY_H_
+#define MINPP_GROUP_BY_H_
+#include "minpp/_minpp_macros.h"
+#include "minpp/projection.h"
+#include "minpp/thread_pool.h"
+#include "minpp/tuple.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+MINPP_IMPL_BEGIN
+
+// integers are summed in 64 bits of their signedness, like SQL's SUM; other types in their own type
+template <typename T>
+using _agg_sum_t = std::conditional_t<std::is_integral_v<T>, std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>, T>;
+
+template <typename Agg, typename Row>
+using _agg_state_t = std::remove_cvref_t<decltype(std::declval<const Agg&>().first(std::declval<const Row&>()))>;
+
+template <typename Agg, typename Row>
+using _agg_result_t = std::remove_cvref_t<decltype(std::declval<const Agg&>().finish(std::declval<_agg_state_t<Agg, Row>&&>()))>;
+
+/*
+Open addressing table from the key of a group to its running state. Groups are stored densely in the order
+they were first seen. An index slot is the high 32 bits of the hash above the group number + 1, as in
+tuple_interner, so a probe rejects most other groups without touching them and the index grows without
+rehashing the keys.
+*/
+template <typename Key, typename State>
+struct _group_table {
+  struct group {
+    Key key;
+    State state;
+  };
+
+  static constexpr std::size_t _initial_index = 64;
+  static constexpr std::uint64_t _tag_mask = ~std::uint64_t{0xffffffff};
+  // the index is kept at most 1/4 full while it fits in L2, where a probe past the home slot costs a
+  // mispredicted branch rather than a cache miss, and at most 1/2 full beyond
+  static constexpr std::size_t _sparse_index = std::size_t{1} << 15;
+
+  std::vector<std::uint64_t> index = std::vector<std::uint64_t>(_initial_index);
+  std::vector<group> groups;
+
+  static std::size_t _home(std::uint64_t h) noexcept {
+    return static_cast<std::size_t>(h >> 32);
+  }
+
+  void prefetch([[maybe_unused]] std::uint64_t h) const noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(index.data() + (_home(h) & (index.size() - 1)));
+#endif
+  }
+
+  // calls update on the state of the group of k, whose hash is h, or appends the group make() returns
+  template <typename K, typename Make, typename Update>
+  void upsert(std::uint64_t h, const K& k, Make&& make, Update&& update) {
+    const std::size_t mask = index.size() - 1;
+    const std::uint64_t tag = h & _tag_mask;
+    std::size_t i = _home(h) & mask;
+    for (; index[i] != 0; i = (i + 1) & mask) {
+      const std::uint64_t s = index[i];
+      if ((s & _tag_mask) == tag) {
+        group& g = groups[s - tag - 1];
+        if (k == g.key) {
+          update(g.state);
+          return;
+        }
+      }
+    }
+    const std::size_t n = groups.size();
+    if (n == 0xffffffff) throw std::length_error("minpp::group_by: more than 2^32 - 1 groups");
+    if ((index.size() <= _sparse_index ? 4 : 2) * (n + 1) > index.size()) {
+      _grow();
+      i = _free_slot(h);
+    }
+    groups.push_back(make());
+    index[i] = tag | (n + 1);
+  }
+
+  std::size_t _free_slot(std::uint64_t h) const noexcept {
+    const std::size_t mask = index.size() - 1;
+    std::size_t i = _home(h) & mask;
+    while (index[i] != 0) i = (i + 1) & mask;
+    return i;
+  }
+
+  void _grow() {
+    std::vector<std::uint64_t> old(2 * index.size());
+    index.swap(old);
+    for (std::uint64_t s: old) {
+      if (s != 0) index[_free_slot(s)] = s;
+    }
+  }
+};
+
+MINPP_IMPL_END
+
+MINPP_SUBSPACE_BEGIN(agg)
+
+/*
+An aggregator is a copyable object with const member functions over the rows of a group:
+  State first(const Row& r);          the state of a group whose first row is r
+  void update(State& s, const Row& r); folds a further row of the group into s
+  void merge(State& s, State&& o);     folds in the state of the same group over other rows (parallel mode)
+  Result finish(State&& s);            the value of the aggregate in the result row
+The ones below are the usual SQL aggregates; anything with these members can be passed along with them.
+*/
+
+/**
+  @brief The number of rows of the group, as a std::size_t.
+*/
+struct count_t {
+  template <typename Row>
+  constexpr std::size_t first(const Row&) const noexcept { return 1; }
+
+  template <typename Row>
+  constexpr void update(std::size_t& s, const Row&) const noexcept { ++s; }
+
+  constexpr void merge(std::size_t& s, std::size_t o) const noexcept { s += o; }
+
+  constexpr std::size_t finish(std::size_t s) const noexcept { return s; }
+};
+
+/**
+  @brief The sum of element I over the group, in 64 bits for integral elements.
+*/
+template <std::size_t I>
+struct sum_t {
+  template <typename Row>
+  constexpr auto first(const Row& r) const {
+    return impl::_agg_sum_t<std::remove_cvref_t<decltype(get<I>(r))>>(get<I>(r));
+  }
+
+  template <typename S, typename Row>
+  constexpr void update(S& s, const Row& r) const { s += get<I>(r); }
+
+  template <typename S>
+  constexpr void merge(S& s, S&& o) const { s += o; }
+
+  template <typename S>
+  constexpr S finish(S&& s) const { return std::move(s); }
+};
+
+/**
+  @brief The least value of element I over the group, compared with operator<.
+*/
+template <std::size_t I>
+struct min_t {
+  template <typename Row>
+  constexpr auto first(const Row& r) const {
+    return std::remove_cvref_t<decltype(get<I>(r))>(get<I>(r));
+  }
+
+  template <typename S, typename Row>
+  constexpr void update(S& s, const Row& r) const {
+    if (get<I>(r) < s) s = get<I>(r);
+  }
+
+  template <typename S>
+  constexpr void merge(S& s, S&& o) const {
+    if (o < s) s = std::move(o);
+  }
+
+  template <typename S>
+  constexpr S finish(S&& s) const { return std::move(s); }
+};
+
+/**
+  @brief The greatest value of element I over the group, compared with operator<.
+*/
+template <std::size_t I>
+struct max_t {
+  template <typename Row>
+  constexpr auto first(const Row& r) const {
+    return std::remove_cvref_t<decltype(get<I>(r))>(get<I>(r));
+  }
+
+  template <typename S, typename Row>
+  constexpr void update(S& s, const Row& r) const {
+    if (s < get<I>(r)) s = get<I>(r);
+  }
+
+  template <typename S>
+  constexpr void merge(S& s, S&& o) const {
+    if (s < o) s = std::move(o);
+  }
+
+  template <typename S>
+  constexpr S finish(S&& s) const { return std::move(s); }
+};
+
+/**
+  @brief The arithmetic mean of element I over the group, as a double.
+*/
+template <std::size_t I>
+struct mean_t {
+  template <typename Row>
+  constexpr tuple<double, std::size_t> first(const Row& r) const {
+    return {static_cast<double>(get<I>(r)), std::size_t{1}};
+  }
+
+  template <typename Row>
+  constexpr void update(tuple<double, std::size_t>& s, const Row& r) const {
+    get<0>(s) += static_cast<double>(get<I>(r));
+    ++get<1>(s);
+  }
+
+  constexpr void merge(tuple<double, std::size_t>& s, tuple<double, std::size_t>&& o) const {
+    get<0>(s) += get<0>(o);
+    get<1>(s) += get<1>(o);
+  }
+
+  constexpr double finish(tuple<double, std::size_t>&& s) const {
+    return get<0>(s) / static_cast<double>(get<1>(s));
+  }
+};
+
+inline constexpr count_t count{};
+
+template <std::size_t I>
+inline constexpr sum_t<I> sum{};
+
+template <std::size_t I>
+inline constexpr min_t<I> min{};
+
+template <std::size_t I>
+inline constexpr max_t<I> max{};
+
+template <std::size_t I>
+inline constexpr mean_t<I> mean{};
+
+MINPP_SUBSPACE_END
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @brief The rows of a range grouped by their elements KeyIdx..., to be aggregated with aggregate.
+  Returned by group_by; holds the range as std::views::all does, so a container passed as an rvalue is
+  moved in and one passed as an lvalue is referred to.
+*/
+template <typename View, std::size_t... KeyIdx>
+class grouping {
+  public:
+  using row_type = std::remove_cvref_t<std::ranges::range_reference_t<View>>;
+  using key_type = typename select_view<const row_type, KeyIdx...>::materialized_type;
+
+  template <typename... Aggs>
+  using result_type = tuple<std::remove_cvref_t<impl::_select_ref_t<const row_type, KeyIdx>>..., impl::_agg_result_t<Aggs, row_type>...>;
+
+  static_assert(sizeof...(KeyIdx) > 0, "group_by needs at least one key element");
+  static_assert(((KeyIdx < std::tuple_size_v<row_type>) && ...), "group_by index out of range");
+
+  constexpr explicit grouping(View v): _range(std::move(v)) {}
+
+  /**
+    @fn template<class... Aggs> vector<result_type<Aggs...>> aggregate(Aggs... aggs);
+    @returns One tuple per distinct key, holding the key elements followed by the result of each aggregator
+    over the rows of that key, in the order the keys first appear in the range.
+    @brief Hash aggregation in one pass over the range. The keys of a batch of rows are hashed and their index
+    slots prefetched before the batch is probed, so the cache misses of a table larger than the cache
+    overlap instead of being paid one row at a time.
+    @note With a forward range every element is read twice, once to hash it and once to aggregate it.
+    @throws std::length_error if there are 2^32 groups or more.
+  */
+  template <typename... Aggs>
+  std::vector<result_type<Aggs...>> aggregate(Aggs... aggs) {
+    using table = _table_t<Aggs...>;
+    const tuple<Aggs...> a{aggs...};
+    table t;
+    _fill(&t, 1, std::ranges::begin(_range), std::ranges::end(_range), a);
+    std::vector<result_type<Aggs...>> out;
+    out.reserve(t.groups.size());
+    _emit(t, a, out);
+    return out;
+  }
+
+  /**
+    @fn template<class... Aggs> vector<result_type<Aggs...>> aggregate(thread_pool& pool, Aggs... aggs);
+    @brief Partitioned parallel aggregation on pool. The range is split into one slice per worker; each slice
+    is aggregated into tables partitioned by hash, then every partition merges its partial tables with the
+    aggregators' merge, so no table is shared between threads.
+    @returns The same groups as aggregate(aggs...), in unspecified order.
+  */
+  template <typename... Aggs>
+    requires std::ranges::random_access_range<View> && std::ranges::sized_range<View>
+  std::vector<result_type<Aggs...>> aggregate(thread_pool& pool, Aggs... aggs) {
+    using table = _table_t<Aggs...>;
+    const tuple<Aggs...> a{aggs...};
+    const auto n = static_cast<std::size_t>(std::ranges::size(_range));
+    const std::size_t slices = std::clamp<std::size_t>(n / _min_slice_rows, 1, pool.size());
+    const std::size_t parts = std::bit_ceil(slices);
+    std::vector<table> partial(slices * parts);
+
+    auto aggregate_slice = [&](std::size_t k) {
+      const auto first = std::ranges::begin(_range);
+      _fill(partial.data() + k * parts, parts, first + static_cast<std::ptrdiff_t>(n * k / slices),
+        first + static_cast<std::ptrdiff_t>(n * (k + 1) / slices), a);
+    };
+    impl::_pool_fanout(pool, slices, aggregate_slice);
+
+    auto merge_partition = [&](std::size_t p) {
+      table& into = partial[p];
+      for (std::size_t k = 1; k < slices; ++k) {
+        table& from = partial[k * parts + p];
+        for (auto& g: from.groups) _merge(into, g, a);
+        from = table{};
+      }
+    };
+    impl::_pool_fanout(pool, parts, merge_partition);
+
+    std::size_t groups = 0;
+    for (std::size_t p = 0; p < parts; ++p) groups += partial[p].groups.size();
+    std::vector<result_type<Aggs...>> out;
+    out.reserve(groups);
+    for (std::size_t p = 0; p < parts; ++p) _emit(partial[p], a, out);
+    return out;
+  }
+
+  private:
+  static constexpr std::size_t _batch = 16;
+  static constexpr std::size_t _min_slice_rows = 1 << 14;
+
+  template <typename... Aggs>
+  using _table_t = impl::_group_table<key_type, tuple<impl::_agg_state_t<Aggs, row_type>...>>;
+
+  template <typename K>
+  static std::uint64_t _hash(const K& k) {
+    return impl::_hash_mix(hash_by<KeyIdx...>{}(k));
+  }
+
+  static std::uint64_t _hash_key(const key_type& k) {
+    return impl::_hash_mix(impl::_hash_elements(k, std::make_index_sequence<sizeof...(KeyIdx)>{}));
+  }
+
+  // the rows of [first, last) into the table of their hash among the power of two tables at t
+  template <typename Table, typename It, typename Sent, typename AggTuple>
+  static void _fill(Table* t, std::size_t tables, It first, Sent last, const AggTuple& a) {
+    const std::size_t mask = tables - 1;
+    if constexpr (std::forward_iterator<It>) {
+      std::uint64_t hashes[_batch];
+      while (first != last) {
+        std::size_t n = 0;
+        for (It it = first; n < _batch && it != last; ++n, ++it) {
+          hashes[n] = _hash(*it);
+          t[hashes[n] & mask].prefetch(hashes[n]);
+        }
+        for (std::size_t i = 0; i < n; ++i, ++first) _add(t[hashes[i] & mask], hashes[i], *first, a);
+      }
+    }
+    else {
+      for (; first != last; ++first) {
+        const auto& row = *first;
+        const std::uint64_t h = _hash(row);
+        _add(t[h & mask], h, row, a);
+      }
+    }
+  }
+
+  template <typename Table, typename AggTuple>
+  static void _add(Table& t, std::uint64_t h, const row_type& row, const AggTuple& a) {
+    [&]<std::size_t... As>(std::index_sequence<As...>) {
+      using state_type = decltype(Table::group::state);
+      t.upsert(h, select<KeyIdx...>(row),
+        [&] { return typename Table::group{select<KeyIdx...>(row).materialize(), state_type{get<As>(a).first(row)...}}; },
+        [&](state_type& s) { (get<As>(a).update(get<As>(s), row), ...); });
+    }(std::make_index_sequence<std::tuple_size_v<AggTuple>>{});
+  }
+
+  template <typename Table, typename AggTuple>
+  static void _merge(Table& into, typename Table::group& g, const AggTuple& a) {
+    [&]<std::size_t... As>(std::index_sequence<As...>) {
+      into.upsert(_hash_key(g.key), g.key,
+        [&] { return std::move(g); },
+        [&](auto& s) { (get<As>(a).merge(get<As>(s), std::move(get<As>(g.state))), ...); });
+    }(std::make_index_sequence<std::tuple_size_v<AggTuple>>{});
+  }
+
+  template <typename Table, typename AggTuple, typename Out>
+  static void _emit(Table& t, const AggTuple& a, Out& out) {
+    [&]<std::size_t... Ks, std::size_t... As>(std::index_sequence<Ks...>, std::index_sequence<As...>) {
+      for (auto& g: t.groups) out.emplace_back(std::move(get<Ks>(g.key))..., get<As>(a).finish(std::move(get<As>(g.state)))...);
+    }(std::make_index_sequence<sizeof...(KeyIdx)>{}, std::make_index_sequence<std::tuple_size_v<AggTuple>>{});
+  }
+
+  View _range;
+};
+
+/**
+  @fn template<size_t... KeyIdx, class R> grouping<views::all_t<R>, KeyIdx...> group_by(R&& r);
+  @returns The rows of r, which are tuple-like, grouped by their elements KeyIdx..., e.g.
+  group_by<0, 1>(rows).aggregate(agg::sum<2>, agg::count, agg::max<3>).
+*/
+template <std::size_t... KeyIdx, std::ranges::viewable_range R>
+grouping<std::views::all_t<R>, KeyIdx...> group_by(R&& r) {
+  return grouping<std::views::all_t<R>, KeyIdx...>{std::views::all(std::forward<R>(r))};
+}
+
+MINPP_NAMESPACE_END
+
+#endif
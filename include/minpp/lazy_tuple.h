@@ -0,0 +1,312 @@
+#ifndef MINPP_LAZY_TUPLE_H_
+#define MINPP_LAZY_TUPLE_H_
+#include "minpp/_minpp_macros.h"
+#include "minpp/tuple.h"
+
+#include <atomic>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @brief A computation standing in for an element of a lazy_tuple until the element is first read.
+*/
+template <typename F>
+struct deferred {
+  F fn;
+};
+
+/**
+  @fn template<class F> deferred<decay_t<F>> defer(F&& f);
+  @returns f wrapped so that a lazy_tuple element constructed from it is computed by f() on first access.
+*/
+template <typename F>
+deferred<std::decay_t<F>> defer(F&& f) {
+  return {std::forward<F>(f)};
+}
+
+MINPP_NAMESPACE_END
+
+MINPP_IMPL_BEGIN
+
+template <typename T>
+inline constexpr bool _is_deferred = false;
+
+template <typename F>
+inline constexpr bool _is_deferred<deferred<F>> = true;
+
+enum class _lazy_state : unsigned char { pending, running, ready };
+
+/*
+One element of a lazy_tuple: the value, or the thunk that computes it, in the same storage. Forcing moves the
+thunk out, constructs the value in place from its result and records the element as ready; if the thunk
+throws it is put back, so the next access tries again.
+In the concurrent slot the state is atomic: the thread that moves it from pending to running computes the
+value and the others wait on the state until it is ready (or pending again after an exception).
+*/
+template <typename T, bool Concurrent>
+class _lazy_slot {
+  using _state_type = std::conditional_t<Concurrent, std::atomic<_lazy_state>, _lazy_state>;
+  using _thunk_type = std::function<T()>;
+
+  public:
+  _lazy_slot() requires std::default_initializable<T>: _value{}, _state{_lazy_state::ready} {}
+
+  template <typename U>
+  _lazy_slot(U&& u) requires (!_is_deferred<std::remove_cvref_t<U>>) && std::constructible_from<T, U>
+  : _value(MINPP_FWD(u)), _state{_lazy_state::ready} {}
+
+  template <typename F>
+  _lazy_slot(deferred<F> d) requires std::convertible_to<std::invoke_result_t<F&>, T>
+  : _thunk(std::move(d.fn)), _state{_lazy_state::pending} {}
+
+  // copying reads the other slot, which for a concurrent slot may be forced by another thread at the same time
+  _lazy_slot(const _lazy_slot& other) requires Concurrent: _state{_lazy_state::ready} {
+    ::new (static_cast<void*>(std::addressof(_value))) T(other.get());
+  }
+
+  _lazy_slot(const _lazy_slot& other) requires (!Concurrent): _state{other._state} {
+    if (_state == _lazy_state::ready) ::new (static_cast<void*>(std::addressof(_value))) T(other._value);
+    else ::new (static_cast<void*>(std::addressof(_thunk))) _thunk_type(other._thunk);
+  }
+
+  _lazy_slot(_lazy_slot&& other) noexcept(std::is_nothrow_move_constructible_v<T>): _state{other._load()} {
+    if (_load() == _lazy_state::ready) ::new (static_cast<void*>(std::addressof(_value))) T(std::move(other._value));
+    else ::new (static_cast<void*>(std::addressof(_thunk))) _thunk_type(std::move(other._thunk));
+  }
+
+  _lazy_slot& operator=(const _lazy_slot& other) {
+    if (this != &other) {
+      _lazy_slot copy{other};
+      _destroy();
+      _construct_from(std::move(copy));
+    }
+    return *this;
+  }
+
+  _lazy_slot& operator=(_lazy_slot&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+      _destroy();
+      _construct_from(std::move(other));
+    }
+    return *this;
+  }
+
+  ~_lazy_slot() {
+    _destroy();
+  }
+
+  bool ready() const noexcept {
+    return _load() == _lazy_state::ready;
+  }
+
+  MINPP_ALWAYS_INLINE T& get() const {
+    if (!ready()) _force();
+    return _value;
+  }
+
+  private:
+  _lazy_state _load() const noexcept {
+    if constexpr (Concurrent) return _state.load(std::memory_order_acquire);
+    else return _state;
+  }
+
+  void _store(_lazy_state s) const noexcept {
+    if constexpr (Concurrent) {
+      _state.store(s, std::memory_order_release);
+      _state.notify_all();
+    }
+    else _state = s;
+  }
+
+  void _evaluate() const {
+    _thunk_type f = std::move(_thunk);
+    std::destroy_at(std::addressof(_thunk));
+    try {
+      ::new (static_cast<void*>(std::addressof(_value))) T(f());
+    }
+    catch (...) {
+      ::new (static_cast<void*>(std::addressof(_thunk))) _thunk_type(std::move(f));
+      _store(_lazy_state::pending);
+      throw;
+    }
+    _store(_lazy_state::ready);
+  }
+
+  void _force() const {
+    if constexpr (Concurrent) {
+      _lazy_state s = _state.load(std::memory_order_acquire);
+      while (s != _lazy_state::ready) {
+        if (s == _lazy_state::pending) {
+          if (_state.compare_exchange_weak(s, _lazy_state::running, std::memory_order_acquire)) {
+            _evaluate();
+            return;
+          }
+        }
+        else {
+          _state.wait(_lazy_state::running, std::memory_order_acquire);
+          s = _state.load(std::memory_order_acquire);
+        }
+      }
+    }
+    else _evaluate();
+  }
+
+  void _destroy() noexcept {
+    if (_load() == _lazy_state::ready) std::destroy_at(std::addressof(_value));
+    else std::destroy_at(std::addressof(_thunk));
+  }
+
+  void _construct_from(_lazy_slot&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    const _lazy_state s = other._load();
+    if (s == _lazy_state::ready) ::new (static_cast<void*>(std::addressof(_value))) T(std::move(other._value));
+    else ::new (static_cast<void*>(std::addressof(_thunk))) _thunk_type(std::move(other._thunk));
+    _store(s);
+  }
+
+  union {
+    mutable T _value;
+    mutable _thunk_type _thunk;
+  };
+  mutable _state_type _state;
+};
+
+MINPP_IMPL_END
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @brief A tuple whose elements are each either a value or a deferred computation (see defer) that runs on
+  the first access to the element and is cached in place, so fields that are expensive to derive are only
+  computed for the records that read them.
+  get<I> and force<I> compute element I if needed; comparisons compute elements left to right and stop at
+  the first one that decides the result. apply, structured bindings and to_tuple read, and so compute, every
+  element.
+  @note With Concurrent, elements may be computed by concurrent readers: one of them runs the computation and
+  the others wait for it. Without it, reads of an element that is not ready yet must not race. In both, a
+  computation that throws leaves the element pending, and copying a concurrent lazy tuple computes the
+  elements of the source.
+  @remarks Reading an element through a const lazy tuple still computes it; the cached value is mutable.
+*/
+template <bool Concurrent, typename... Types>
+class basic_lazy_tuple {
+  public:
+  basic_lazy_tuple() requires (std::default_initializable<Types> && ...) = default;
+
+  /**
+    @brief Initializes element i from us_i: a deferred<F> is kept and computed on first access, anything else
+    constructs the value.
+  */
+  template <typename... Us>
+  basic_lazy_tuple(Us&&... us) requires
+    (sizeof...(Us) == sizeof...(Types)) && (sizeof...(Us) > 0) &&
+    (std::constructible_from<impl::_lazy_slot<Types, Concurrent>, Us> && ...)
+  : _slots(MINPP_FWD(us)...) {}
+
+  /**
+    @returns Element I, computing it if it is not ready.
+  */
+  template <std::size_t I>
+  MINPP_ALWAYS_INLINE auto& force() {
+    return get<I>(_slots).get();
+  }
+
+  template <std::size_t I>
+  MINPP_ALWAYS_INLINE const auto& force() const {
+    return get<I>(_slots).get();
+  }
+
+  /**
+    @returns Whether element I holds its value, without computing it.
+  */
+  template <std::size_t I>
+  bool ready() const noexcept {
+    return get<I>(_slots).ready();
+  }
+
+  /**
+    @returns The values of every element, computing the ones that are not ready.
+  */
+  tuple<Types...> to_tuple() const {
+    return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      return tuple<Types...>{force<Is>()...};
+    }(std::index_sequence_for<Types...>{});
+  }
+
+  private:
+  tuple<impl::_lazy_slot<Types, Concurrent>...> _slots;
+};
+
+template <typename... Types>
+using lazy_tuple = basic_lazy_tuple<false, Types...>;
+
+template <typename... Types>
+using concurrent_lazy_tuple = basic_lazy_tuple<true, Types...>;
+
+/**
+  @fn template<size_t I, bool Concurrent, class... Types>
+  decltype(auto) get(basic_lazy_tuple<Concurrent, Types...>& t);
+  @returns A reference to element I of t, computing it if it is not ready.
+*/
+template <std::size_t I, bool Concurrent, typename... Types>
+auto& get(basic_lazy_tuple<Concurrent, Types...>& t) {
+  return t.template force<I>();
+}
+
+template <std::size_t I, bool Concurrent, typename... Types>
+const auto& get(const basic_lazy_tuple<Concurrent, Types...>& t) {
+  return t.template force<I>();
+}
+
+template <std::size_t I, bool Concurrent, typename... Types>
+auto&& get(basic_lazy_tuple<Concurrent, Types...>&& t) {
+  return std::move(t.template force<I>());
+}
+
+template <std::size_t I, bool Concurrent, typename... Types>
+const auto&& get(const basic_lazy_tuple<Concurrent, Types...>&& t) {
+  return std::move(t.template force<I>());
+}
+
+template <bool C1, typename... TTypes, bool C2, typename... UTypes>
+bool operator==(const basic_lazy_tuple<C1, TTypes...>& t, const basic_lazy_tuple<C2, UTypes...>& u) requires (sizeof...(TTypes) == sizeof...(UTypes)) {
+  return impl::_impl_tuple_eq(t, u, std::index_sequence_for<TTypes...>{});
+}
+
+template <bool C, typename... TTypes, typename... UTypes>
+bool operator==(const basic_lazy_tuple<C, TTypes...>& t, const tuple<UTypes...>& u) requires (sizeof...(TTypes) == sizeof...(UTypes)) {
+  return impl::_impl_tuple_eq(t, u, std::index_sequence_for<TTypes...>{});
+}
+
+template <bool C1, typename... TTypes, bool C2, typename... UTypes>
+auto operator<=>(const basic_lazy_tuple<C1, TTypes...>& t, const basic_lazy_tuple<C2, UTypes...>& u) requires (sizeof...(TTypes) == sizeof...(UTypes)) {
+  using R = std::common_comparison_category_t<_synth_three_way_result<TTypes, UTypes>...>;
+  return impl::_impl_tuple_three_way<R>(t, u, std::index_sequence_for<TTypes...>{});
+}
+
+template <bool C, typename... TTypes, typename... UTypes>
+auto operator<=>(const basic_lazy_tuple<C, TTypes...>& t, const tuple<UTypes...>& u) requires (sizeof...(TTypes) == sizeof...(UTypes)) {
+  using R = std::common_comparison_category_t<_synth_three_way_result<TTypes, impl::_unwrap_cacheline_t<UTypes>>...>;
+  return impl::_impl_tuple_three_way<R>(t, u, std::index_sequence_for<TTypes...>{});
+}
+
+MINPP_NAMESPACE_END
+
+MINPP_STD_BEGIN
+
+template <bool Concurrent, typename... Types>
+struct tuple_size<minpp::basic_lazy_tuple<Concurrent, Types...>>: std::integral_constant<std::size_t, sizeof...(Types)> {};
+
+template <std::size_t I, bool Concurrent, typename... Types>
+struct tuple_element<I, minpp::basic_lazy_tuple<Concurrent, Types...>>: tuple_element<I, minpp::tuple<Types...>> {};
+
+MINPP_STD_END
+
+#endif
@@ -0,0 +1,291 @@
+#ifndef MINPP_MEMOIZE_H_
+#define MINPP_MEMOIZE_H_
+#include "minpp/_minpp_macros.h"
+#include "minpp/projection.h"
+#include "minpp/tuple.h"
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @brief Counters of a memoized function, summed over its shards.
+*/
+struct memo_stats {
+  std::uint64_t hits = 0;
+  std::uint64_t misses = 0;
+  std::uint64_t evictions = 0;
+  std::size_t size = 0;
+  std::size_t capacity = 0;
+
+  /**
+    @returns hits / (hits + misses), 0 before the first call.
+  */
+  double hit_rate() const noexcept {
+    const std::uint64_t calls = hits + misses;
+    return calls ? static_cast<double>(hits) / static_cast<double>(calls) : 0.0;
+  }
+};
+
+MINPP_NAMESPACE_END
+
+MINPP_IMPL_BEGIN
+
+// the argument types of a callable with one non-template call operator, as std::function deduces them
+template <typename Sig>
+struct _memo_signature {};
+
+template <typename R, typename... Args>
+struct _memo_signature<std::function<R(Args...)>> {
+  using keys = tuple<std::remove_cvref_t<Args>...>;
+};
+
+template <typename F>
+using _memo_keys_t = typename _memo_signature<decltype(std::function{std::declval<F>()})>::keys;
+
+/*
+One shard of the cache: a fixed number of slots replaced in CLOCK order, and an open addressing index from
+hash to slot. A hit sets the slot's reference bit; an insertion into a full shard sweeps the hand over the
+slots, clearing reference bits, and replaces the first slot whose bit is already clear. The index is at
+least twice the capacity, probed linearly, and deletes by shifting the rest of the run back, so there are no
+tombstones to clean up.
+Everything is guarded by the mutex, counters included: they are only summed by stats().
+*/
+template <typename Key, typename Value>
+struct alignas(MINPP_CACHELINE_SIZE) _memo_shard {
+  struct entry {
+    Key key;
+    Value value;
+    std::uint64_t hash;
+    bool referenced;
+  };
+
+  static constexpr std::uint32_t _empty = 0;
+
+  std::mutex mutex;
+  std::vector<entry> slots;
+  std::vector<std::uint32_t> index; // slot + 1, or _empty
+  std::size_t capacity = 0;
+  std::size_t hand = 0;
+  std::uint64_t hits = 0;
+  std::uint64_t misses = 0;
+  std::uint64_t evictions = 0;
+
+  void reserve(std::size_t n) {
+    capacity = n;
+    slots.reserve(n);
+    index.assign(std::bit_ceil(std::max<std::size_t>(2 * n, 2)), _empty);
+  }
+
+  std::size_t mask() const noexcept {
+    return index.size() - 1;
+  }
+
+  template <typename Args>
+  entry* find(std::uint64_t h, const Args& args) noexcept {
+    for (std::size_t i = h & mask(); index[i] != _empty; i = (i + 1) & mask()) {
+      entry& e = slots[index[i] - 1];
+      if (e.hash == h && e.key == args) return &e;
+    }
+    return nullptr;
+  }
+
+  void unlink(const entry& e) noexcept {
+    const std::uint32_t target = static_cast<std::uint32_t>(&e - slots.data()) + 1;
+    std::size_t i = e.hash & mask();
+    while (index[i] != target) i = (i + 1) & mask();
+    // backward shift: move later members of the run into the hole unless they would precede their home
+    for (std::size_t j = (i + 1) & mask(); index[j] != _empty; j = (j + 1) & mask()) {
+      const std::size_t home = slots[index[j] - 1].hash & mask();
+      if (((j - home) & mask()) >= ((j - i) & mask())) {
+        index[i] = index[j];
+        i = j;
+      }
+    }
+    index[i] = _empty;
+  }
+
+  void link(std::size_t slot) noexcept {
+    std::size_t i = slots[slot].hash & mask();
+    while (index[i] != _empty) i = (i + 1) & mask();
+    index[i] = static_cast<std::uint32_t>(slot) + 1;
+  }
+
+  void insert(entry&& e) {
+    if (slots.size() < capacity) {
+      slots.push_back(std::move(e));
+      link(slots.size() - 1);
+      return;
+    }
+    while (slots[hand].referenced) {
+      slots[hand].referenced = false;
+      hand = (hand + 1) % capacity;
+    }
+    unlink(slots[hand]);
+    slots[hand] = std::move(e);
+    link(hand);
+    hand = (hand + 1) % capacity;
+    ++evictions;
+  }
+
+  void clear() noexcept {
+    slots.clear();
+    std::fill(index.begin(), index.end(), _empty);
+    hand = 0;
+  }
+};
+
+MINPP_IMPL_END
+
+MINPP_NAMESPACE_BEGIN
+
+template <typename F, typename Keys>
+class memoized;
+
+/**
+  @brief A function object that caches the results of F by argument, in a bounded table shared by all
+  threads that call it.
+  A call hashes its arguments through forward_as_tuple, so looking a result up copies nothing; only a miss
+  materializes the owning tuple<Keys...> that stays in the table as the key. The table is split into shards
+  that each hold a mutex, so calls that land in different shards do not contend, and each shard keeps a
+  fixed number of entries, replacing them in CLOCK order (an approximation of least recently used).
+  @note F runs outside the shard's lock, so it may take long or call the memoized function recursively.
+  Concurrent misses on the same arguments may each run F; the first result to be inserted is kept.
+  @remarks Results are returned by value, since the entry may be replaced as soon as the lock is released.
+  The capacity is split evenly between the shards, so one shard may evict while others still have room.
+*/
+template <typename F, typename... Keys>
+class memoized<F, tuple<Keys...>> {
+  static_assert((impl::_hashable<Keys> && ...), "memoized argument types must be hashable with std::hash");
+  static_assert((std::equality_comparable<Keys> && ...), "memoized argument types must be equality comparable");
+
+  public:
+  using key_type = tuple<Keys...>;
+  using result_type = std::remove_cvref_t<std::invoke_result_t<F&, const Keys&...>>;
+
+  private:
+  using _shard = impl::_memo_shard<key_type, result_type>;
+
+  public:
+  static_assert(!std::is_void_v<result_type>, "a memoized function must return a value");
+
+  /**
+    @param capacity The maximum number of results kept.
+    @param shards The number of shards, rounded up to a power of two and to at most capacity; 0 picks one
+    from the number of hardware threads.
+    @throws std::invalid_argument if capacity is 0.
+  */
+  memoized(F f, std::size_t capacity, std::size_t shards = 0): _f(std::move(f)) {
+    if (capacity == 0) throw std::invalid_argument("minpp::memoize: capacity must be positive");
+    if (shards == 0) shards = std::max(1u, std::thread::hardware_concurrency());
+    _shard_count = std::min(std::bit_ceil(shards), std::bit_floor(capacity));
+    _shard_bits = std::countr_zero(_shard_count);
+    _shards = std::make_unique<_shard[]>(_shard_count);
+    for (std::size_t i = 0; i < _shard_count; ++i) {
+      _shards[i].reserve(capacity / _shard_count + (i < capacity % _shard_count));
+    }
+  }
+
+  memoized(memoized&&) noexcept = default;
+  memoized& operator=(memoized&&) noexcept = default;
+
+  /**
+    @returns f(args...), from the table if these arguments are in it.
+  */
+  result_type operator()(const Keys&... args) {
+    const auto fwd = minpp::forward_as_tuple(args...);
+    const std::uint64_t h = impl::_hash_mix(impl::_hash_elements(fwd, std::index_sequence_for<Keys...>{}));
+    _shard& s = _shard_of(h);
+    {
+      std::lock_guard lk{s.mutex};
+      if (auto* e = s.find(h, fwd)) {
+        ++s.hits;
+        e->referenced = true;
+        return e->value;
+      }
+      ++s.misses;
+    }
+    result_type r = std::invoke(_f, args...);
+    {
+      std::lock_guard lk{s.mutex};
+      if (!s.find(h, fwd)) s.insert({key_type(args...), r, h, false});
+    }
+    return r;
+  }
+
+  /**
+    @returns The counters of every shard. Shards are read one after the other, so calls running at the same
+    time may be counted in some shards and not in others.
+  */
+  memo_stats stats() const {
+    memo_stats st;
+    for (std::size_t i = 0; i < _shard_count; ++i) {
+      _shard& s = _shards[i];
+      std::lock_guard lk{s.mutex};
+      st.hits += s.hits;
+      st.misses += s.misses;
+      st.evictions += s.evictions;
+      st.size += s.slots.size();
+      st.capacity += s.capacity;
+    }
+    return st;
+  }
+
+  /**
+    @brief Drops every cached result. The counters are kept.
+  */
+  void clear() {
+    for (std::size_t i = 0; i < _shard_count; ++i) {
+      std::lock_guard lk{_shards[i].mutex};
+      _shards[i].clear();
+    }
+  }
+
+  std::size_t shard_count() const noexcept {
+    return _shard_count;
+  }
+
+  private:
+  _shard& _shard_of(std::uint64_t h) const noexcept {
+    // the low bits start the probe within the shard, the high bits pick it
+    return _shards[_shard_bits ? h >> (64 - _shard_bits) : 0];
+  }
+
+  F _f;
+  std::unique_ptr<_shard[]> _shards;
+  std::size_t _shard_count = 0;
+  int _shard_bits = 0;
+};
+
+/**
+  @fn template<class... Args, class F>
+  auto memoize(F&& f, size_t capacity, size_t shards = 0);
+  @returns A memoized<decay_t<F>, tuple<Args...>> that caches up to capacity results of f, see memoized.
+  @brief The argument types Args... are deduced from f's call operator when they are not given, which needs a
+  function pointer or a callable whose operator() is not overloaded or a template.
+*/
+template <typename... Args, typename F>
+auto memoize(F&& f, std::size_t capacity, std::size_t shards = 0) {
+  if constexpr (sizeof...(Args) == 0) {
+    return memoized<std::decay_t<F>, impl::_memo_keys_t<std::decay_t<F>>>(std::forward<F>(f), capacity, shards);
+  }
+  else {
+    return memoized<std::decay_t<F>, tuple<std::remove_cvref_t<Args>...>>(std::forward<F>(f), capacity, shards);
+  }
+}
+
+MINPP_NAMESPACE_END
+
+#endif
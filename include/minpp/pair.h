@@ -2,6 +2,8 @@
 #define MINPP_PAIR_H_
 #include "minpp/_minpp_macros.h"
 
+#include <compare>
+
 MINPP_NAMESPACE_BEGIN
 
 template<typename _first_t, typename _second_t>
@@ -12,7 +14,7 @@ struct pair {
   first_t first;
   second_t second;
 
-  auto operator<=>(const pair&) = default;
+  auto operator<=>(const pair&) const = default;
 };
 
 MINPP_NAMESPACE_END
@@ -0,0 +1,246 @@
+#ifndef MINPP_PARSE_DELIMITED_H_
+#define MINPP_PARSE_DELIMITED_H_
+#include "minpp/_minpp_macros.h"
+#include "minpp/tuple.h"
+
+#include <array>
+#include <bit>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MINPP_PARSE_DELIMITED_SSE2 1
+#else
+#define MINPP_PARSE_DELIMITED_SSE2 0
+#endif
+
+MINPP_IMPL_BEGIN
+
+/*
+Finds delimiters and newlines 64 bytes at a time: each block is turned into a bit mask with one bit per
+delimiter or '\n', and the positions are then taken off the mask lowest bit first, so a block with many short
+fields is only compared once. The last partial block is copied into a zeroed buffer so that loads never read
+past the input.
+*/
+class _field_scanner {
+  public:
+  static constexpr std::size_t block_size = 64;
+
+  _field_scanner() = default;
+
+  _field_scanner(std::string_view input, char delimiter) noexcept
+  : _data{input.data()}, _size{input.size()}, _delimiter{delimiter} {
+    if (_size > 0) _mask = _block_mask(0);
+  }
+
+  // position of the next delimiter or newline, or the size of the input if there is none
+  std::size_t next() noexcept {
+    while (_mask == 0) {
+      _block += block_size;
+      if (_block >= _size) return _size;
+      _mask = _block_mask(_block);
+    }
+    const std::size_t pos = _block + static_cast<std::size_t>(std::countr_zero(_mask));
+    _mask &= _mask - 1;
+    return pos;
+  }
+
+  private:
+  std::uint64_t _block_mask(std::size_t offset) const noexcept {
+    const std::size_t n = _size - offset;
+    if (n >= block_size) return _structural(_data + offset, _delimiter);
+    alignas(16) char tail[block_size] = {};
+    std::memcpy(tail, _data + offset, n);
+    return _structural(tail, _delimiter) & ((std::uint64_t{1} << n) - 1);
+  }
+
+  static std::uint64_t _structural(const char* p, char delimiter) noexcept {
+    std::uint64_t mask = 0;
+#if MINPP_PARSE_DELIMITED_SSE2
+    const __m128i d = _mm_set1_epi8(delimiter);
+    const __m128i nl = _mm_set1_epi8('\n');
+    for (std::size_t i = 0; i < block_size; i += 16) {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+      const int bits = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, d), _mm_cmpeq_epi8(v, nl)));
+      mask |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(bits)) << i;
+    }
+#else
+    for (std::size_t i = 0; i < block_size; ++i) {
+      mask |= static_cast<std::uint64_t>(p[i] == delimiter || p[i] == '\n') << i;
+    }
+#endif
+    return mask;
+  }
+
+  const char* _data = nullptr;
+  std::size_t _size = 0;
+  std::size_t _block = 0;
+  std::uint64_t _mask = 0;
+  char _delimiter = ',';
+};
+
+[[noreturn]] inline void _parse_delimited_error(const char* what, std::size_t line) {
+  throw std::invalid_argument("minpp::parse_delimited: " + std::string{what} + " on line " + std::to_string(line));
+}
+
+template <typename T>
+concept _delimited_field = std::same_as<T, std::string_view> || std::same_as<T, bool> ||
+  std::integral<T> || std::floating_point<T> || std::constructible_from<T, std::string_view>;
+
+template <typename T>
+T _parse_field(std::string_view f, std::size_t line) {
+  if constexpr (std::same_as<T, std::string_view>) return f;
+  else if constexpr (std::same_as<T, bool>) {
+    if (f == "1" || f == "true") return true;
+    if (f == "0" || f == "false") return false;
+    _parse_delimited_error("malformed bool field", line);
+  }
+  else if constexpr (std::integral<T> || std::floating_point<T>) {
+    T v{};
+    const auto [end, ec] = std::from_chars(f.data(), f.data() + f.size(), v);
+    if (ec != std::errc{} || end != f.data() + f.size()) _parse_delimited_error("malformed numeric field", line);
+    return v;
+  }
+  else return T(f);
+}
+
+MINPP_IMPL_END
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @brief The rows of a delimited text buffer, parsed one at a time into Tuple as the range is iterated.
+  Each line is one row of exactly tuple_size_v<Tuple> fields separated by the delimiter. Integral and
+  floating point fields are converted with std::from_chars, bool fields accept 0, 1, false and true,
+  std::string_view fields refer into the buffer without copying, and any other field type is constructed from
+  the field's std::string_view. The row is then constructed from the converted fields.
+  @note Fields are not unquoted, so a field cannot contain the delimiter or a newline. A '\r' ending the last
+  field of a line is dropped, and empty lines are skipped.
+  @note The buffer must outlive the range and every row holding a std::string_view.
+  @throws std::invalid_argument from begin() and operator++ if a line has the wrong number of fields or a field
+  does not convert; the message names the line.
+*/
+template <typename Tuple>
+class delimited_rows {
+  static constexpr std::size_t _fields = std::tuple_size_v<Tuple>;
+
+  static_assert(_fields > 0, "rows need at least one field");
+  static_assert([]<std::size_t... Is>(std::index_sequence<Is...>) {
+    return (impl::_delimited_field<std::tuple_element_t<Is, Tuple>> && ...);
+  }(std::make_index_sequence<_fields>{}), "fields must be arithmetic, std::string_view or constructible from std::string_view");
+
+  public:
+  class iterator {
+    public:
+    using value_type = Tuple;
+    using difference_type = std::ptrdiff_t;
+    using iterator_concept = std::input_iterator_tag;
+
+    iterator() = default;
+
+    const Tuple& operator*() const noexcept { return *_row; }
+    const Tuple* operator->() const noexcept { return &*_row; }
+
+    iterator& operator++() {
+      _parse();
+      return *this;
+    }
+
+    void operator++(int) { ++*this; }
+
+    friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept { return !it._row; }
+
+    // the line the current row came from, starting at 1
+    std::size_t line() const noexcept { return _line; }
+
+    private:
+    friend class delimited_rows;
+
+    iterator(std::string_view input, char delimiter): _input{input}, _scanner{input, delimiter} {
+      _parse();
+    }
+
+    void _parse() {
+      // the scan state is kept in locals so that it stays in registers across the reads of the input
+      impl::_field_scanner scanner = _scanner;
+      const char* const data = _input.data();
+      const std::size_t size = _input.size();
+      std::size_t pos = _pos;
+      std::array<std::string_view, _fields> fields;
+      for (;;) {
+        if (pos >= size) {
+          _row.reset();
+          break;
+        }
+        ++_line;
+        std::size_t i = 0;
+        std::size_t end;
+        for (;; ++i) {
+          end = scanner.next();
+          if (end == size || data[end] == '\n') break;
+          if (i + 1 == _fields) impl::_parse_delimited_error("too many fields", _line);
+          fields[i] = std::string_view{data + pos, end - pos};
+          pos = end + 1;
+        }
+        std::string_view last{data + pos, end - pos};
+        if (!last.empty() && last.back() == '\r') last.remove_suffix(1);
+        pos = end + 1;
+        if (i == 0 && last.empty()) continue;
+        if (i + 1 != _fields) impl::_parse_delimited_error("too few fields", _line);
+        fields[i] = last;
+        _emplace(fields, std::make_index_sequence<_fields>{});
+        break;
+      }
+      _scanner = scanner;
+      _pos = pos;
+    }
+
+    template <std::size_t... Is>
+    void _emplace(const std::array<std::string_view, _fields>& fields, std::index_sequence<Is...>) {
+      _row.emplace(impl::_parse_field<std::tuple_element_t<Is, Tuple>>(fields[Is], _line)...);
+    }
+
+    std::string_view _input;
+    impl::_field_scanner _scanner;
+    std::size_t _pos = 0;
+    std::size_t _line = 0;
+    std::optional<Tuple> _row;
+  };
+
+  delimited_rows(std::string_view input, char delimiter) noexcept: _input{input}, _delimiter{delimiter} {}
+
+  iterator begin() const { return iterator{_input, _delimiter}; }
+  std::default_sentinel_t end() const noexcept { return {}; }
+
+  private:
+  std::string_view _input;
+  char _delimiter;
+};
+
+/**
+  @fn template<class Tuple>
+  delimited_rows<Tuple> parse_delimited(string_view input, char delimiter = ',');
+  @returns A range that parses input into Tuple rows while it is iterated, e.g.
+    for (const auto& [id, price, name]: parse_delimited<tuple<int64_t, double, string_view>>(buffer, '\t'))
+  @pre delimiter is neither '\n' nor '\r'.
+*/
+template <typename Tuple>
+delimited_rows<Tuple> parse_delimited(std::string_view input, char delimiter = ',') noexcept {
+  return delimited_rows<Tuple>{input, delimiter};
+}
+
+MINPP_NAMESPACE_END
+
+#endif
@@ -0,0 +1,234 @@
+#ifndef MINPP_PROJECTION_H_
+#define MINPP_PROJECTION_H_
+#include "minpp/_minpp_macros.h"
+#include "minpp/common_meta.h"
+#include "minpp/tuple.h"
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+MINPP_IMPL_BEGIN
+
+template <std::size_t J, std::size_t... Is>
+inline constexpr std::size_t _select_index = [] {
+  constexpr std::size_t indices[] = {Is...};
+  return indices[J];
+}();
+
+// the reference get<I> yields on an lvalue of Tuple: const T& for a const Tuple, X& for a reference element X&
+template <typename Tuple, std::size_t I>
+using _select_ref_t = decltype(get<I>(std::declval<Tuple&>()));
+
+template <typename T>
+concept _hashable = requires (const T& v) {
+  { std::hash<T>{}(v) } -> std::convertible_to<std::size_t>;
+};
+
+constexpr std::size_t _hash_combine(std::size_t seed, std::size_t h) noexcept {
+  return seed ^ (h + static_cast<std::size_t>(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2));
+}
+
+// 64-bit finalizer for tables that take bits from both ends of a combined hash, whose high bits are weak
+constexpr std::uint64_t _hash_mix(std::uint64_t h) noexcept {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+template <typename Tuple, std::size_t... Is>
+constexpr std::size_t _hash_elements(const Tuple& t, std::index_sequence<Is...>) {
+  std::size_t seed = sizeof...(Is);
+  ((seed = _hash_combine(seed, std::hash<std::remove_cvref_t<decltype(get<Is>(t))>>{}(get<Is>(t)))), ...);
+  return seed;
+}
+
+MINPP_IMPL_END
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @brief Non-owning view of the elements Is... of a tuple-like Tuple, in that order.
+  The view holds a pointer to the tuple and is tuple-like itself: get<J>(v) is a reference to
+  get<Is...[J]>(v.base()), so reading through the view never copies an element.
+  @note Constness is shallow, as for a tuple of references: get on a const view still yields the
+  references of the underlying tuple. Tuple may be const-qualified to make the view read-only.
+  @note The view does not extend the lifetime of the tuple.
+*/
+template <typename Tuple, std::size_t... Is>
+class select_view {
+  static_assert(((Is < std::tuple_size_v<std::remove_const_t<Tuple>>) && ...), "select index out of range");
+
+  public:
+  using materialized_type = tuple<std::remove_cvref_t<impl::_select_ref_t<Tuple, Is>>...>;
+
+  constexpr explicit select_view(Tuple& t) noexcept: _t{std::addressof(t)} {}
+
+  constexpr Tuple& base() const noexcept { return *_t; }
+
+  /**
+    @returns An owning tuple holding copies of the selected elements.
+  */
+  constexpr materialized_type materialize() const {
+    return materialized_type{get<Is>(*_t)...};
+  }
+
+  template <typename Alloc>
+  constexpr materialized_type materialize(std::allocator_arg_t, const Alloc& a) const {
+    return materialized_type{std::allocator_arg_t{}, a, get<Is>(*_t)...};
+  }
+
+  private:
+  Tuple* _t;
+};
+
+/**
+  @fn template<size_t... Is, class Tuple>
+  constexpr select_view<Tuple, Is...> select(Tuple& t) noexcept;
+  @returns A view of the elements Is... of t. Indices may repeat and appear in any order.
+  @note Selecting from an rvalue is ill-formed, since the view would dangle.
+*/
+template <std::size_t... Is, typename Tuple>
+constexpr select_view<Tuple, Is...> select(Tuple& t) noexcept {
+  return select_view<Tuple, Is...>{t};
+}
+
+template <std::size_t... Is, typename Tuple> requires (!std::is_lvalue_reference_v<Tuple>)
+void select(Tuple&& t) = delete;
+
+/**
+  @fn template<size_t J, class Tuple, size_t... Is>
+  constexpr tuple_element_t<J, select_view<Tuple, Is...>> get(const select_view<Tuple, Is...>& v) noexcept;
+  @returns A reference to the Jth selected element of the viewed tuple.
+*/
+template <std::size_t J, typename Tuple, std::size_t... Is>
+constexpr impl::_select_ref_t<Tuple, impl::_select_index<J, Is...>> get(const select_view<Tuple, Is...>& v) noexcept {
+  static_assert(J < sizeof...(Is), "get index out of range");
+  return get<impl::_select_index<J, Is...>>(v.base());
+}
+
+MINPP_NAMESPACE_END
+
+MINPP_STD_BEGIN
+
+template <typename Tuple, std::size_t... Is>
+struct tuple_size<minpp::select_view<Tuple, Is...>> : std::integral_constant<std::size_t, sizeof...(Is)> {};
+
+/**
+  @brief ::type is the reference type get<I> yields, so structured bindings of a view bind to the viewed
+  elements.
+*/
+template <std::size_t I, typename Tuple, std::size_t... Is>
+struct tuple_element<I, minpp::select_view<Tuple, Is...>> {
+  using type = minpp::impl::_select_ref_t<Tuple, minpp::impl::_select_index<I, Is...>>;
+};
+
+MINPP_STD_END
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @fn template<class T, size_t... Is, class U, size_t... Js>
+  constexpr bool operator==(const select_view<T, Is...>& t, const select_view<U, Js...>& u);
+  @returns true if get<i>(t) == get<i>(u) for all i, otherwise false.
+  @remarks Compares like the tuple operator==; also usable between a view and a tuple.
+*/
+template <typename T, std::size_t... Is, typename U, std::size_t... Js>
+constexpr bool operator==(const select_view<T, Is...>& t, const select_view<U, Js...>& u) {
+  static_assert(sizeof...(Is) == sizeof...(Js), "cannot compare views of different sizes");
+  return impl::_impl_tuple_eq(t, u, std::make_index_sequence<sizeof...(Is)>{});
+}
+
+template <typename T, std::size_t... Is, typename... UTypes>
+constexpr bool operator==(const select_view<T, Is...>& t, const tuple<UTypes...>& u) {
+  static_assert(sizeof...(Is) == sizeof...(UTypes), "cannot compare a view and a tuple of different sizes");
+  return impl::_impl_tuple_eq(t, u, std::make_index_sequence<sizeof...(Is)>{});
+}
+
+/**
+  @fn template<class T, size_t... Is, class U, size_t... Js>
+  constexpr auto operator<=>(const select_view<T, Is...>& t, const select_view<U, Js...>& u);
+  @brief Lexicographical comparison of the selected elements, short circuited like the tuple operator<=>.
+*/
+template <typename T, std::size_t... Is, typename U, std::size_t... Js>
+constexpr auto operator<=>(const select_view<T, Is...>& t, const select_view<U, Js...>& u) {
+  static_assert(sizeof...(Is) == sizeof...(Js), "cannot compare views of different sizes");
+  return impl::_impl_tuple_three_way<std::common_comparison_category_t<
+    _synth_three_way_result<std::remove_reference_t<impl::_select_ref_t<T, Is>>, std::remove_reference_t<impl::_select_ref_t<U, Js>>>...
+  >>(t, u, std::make_index_sequence<sizeof...(Is)>{});
+}
+
+template <typename T, std::size_t... Is, typename... UTypes>
+constexpr auto operator<=>(const select_view<T, Is...>& t, const tuple<UTypes...>& u) {
+  static_assert(sizeof...(Is) == sizeof...(UTypes), "cannot compare a view and a tuple of different sizes");
+  return impl::_impl_tuple_three_way<std::common_comparison_category_t<
+    _synth_three_way_result<std::remove_reference_t<impl::_select_ref_t<T, Is>>, std::remove_reference_t<impl::_unwrap_cacheline_t<UTypes>>>...
+  >>(t, u, std::make_index_sequence<sizeof...(Is)>{});
+}
+
+/**
+  @brief Strict weak ordering on the columns Is... of two tuple-likes, e.g. for std::sort.
+  No element is copied.
+*/
+template <std::size_t... Is>
+struct compare_by {
+  template <typename T, typename U>
+  constexpr bool operator()(const T& t, const U& u) const {
+    return (select<Is...>(t) <=> select<Is...>(u)) < 0;
+  }
+};
+
+/**
+  @brief Equality on the columns Is... of two tuple-likes, e.g. as the key equality of a hash map.
+*/
+template <std::size_t... Is>
+struct equal_by {
+  template <typename T, typename U>
+  constexpr bool operator()(const T& t, const U& u) const {
+    return select<Is...>(t) == select<Is...>(u);
+  }
+};
+
+/**
+  @brief Hash of the columns Is... of a tuple-like, consistent with equal_by<Is...>.
+  hash_by<Is...>{}(t) equals std::hash of select<Is...>(t).materialize().
+*/
+template <std::size_t... Is>
+struct hash_by {
+  template <typename T>
+  constexpr std::size_t operator()(const T& t) const {
+    return impl::_hash_elements(select<Is...>(t), std::index_sequence_for<std::integral_constant<std::size_t, Is>...>{});
+  }
+};
+
+MINPP_NAMESPACE_END
+
+MINPP_STD_BEGIN
+
+/**
+  @brief Enabled when every element type is hashable.
+*/
+template <typename... Types> requires (minpp::impl::_hashable<std::remove_cvref_t<minpp::impl::_unwrap_cacheline_t<Types>>> && ...)
+struct hash<minpp::tuple<Types...>> {
+  std::size_t operator()(const minpp::tuple<Types...>& t) const {
+    return minpp::impl::_hash_elements(t, std::index_sequence_for<Types...>{});
+  }
+};
+
+template <typename Tuple, std::size_t... Is>
+struct hash<minpp::select_view<Tuple, Is...>> {
+  std::size_t operator()(const minpp::select_view<Tuple, Is...>& v) const {
+    return minpp::hash_by<Is...>{}(v.base());
+  }
+};
+
+MINPP_STD_END
+
+#endif
@@ -0,0 +1,259 @@
+#ifndef MINPP_SORT_KEY_H_
+#define MINPP_SORT_KEY_H_
+#include "minpp/_minpp_macros.h"
+#include "minpp/tuple.h"
+
+#include <bit>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @brief Sort key specification: the listed columns sort in descending order, every other column ascending.
+*/
+template <std::size_t... Is>
+struct descending_columns {
+  template <std::size_t I>
+  static constexpr bool descending = ((I == Is) || ...);
+};
+
+MINPP_NAMESPACE_END
+
+MINPP_IMPL_BEGIN
+
+template <typename T>
+concept _sort_key_string = std::same_as<T, std::string> || std::same_as<T, std::string_view>;
+
+template <typename T>
+concept _sort_key_scalar = std::integral<T> || std::floating_point<T> || std::is_enum_v<T>;
+
+template <typename T>
+concept _sort_key_element = _sort_key_scalar<T> || _sort_key_string<T>;
+
+template <typename T>
+struct _sort_key_unsigned {
+  using type = std::make_unsigned_t<T>;
+};
+
+template <>
+struct _sort_key_unsigned<bool> {
+  using type = unsigned char;
+};
+
+template <>
+struct _sort_key_unsigned<float> {
+  using type = std::uint32_t;
+};
+
+template <>
+struct _sort_key_unsigned<double> {
+  using type = std::uint64_t;
+};
+
+/*
+Map a scalar onto an unsigned integer with the same order (for floats: -inf < ... < -0.0 == +0.0 < ... < +inf < NaN).
+*/
+template <typename T>
+constexpr auto _sort_key_bits(T v) noexcept {
+  if constexpr (std::is_enum_v<T>) return _sort_key_bits(static_cast<std::underlying_type_t<T>>(v));
+  else if constexpr (std::floating_point<T>) {
+    static_assert(sizeof(T) == 4 || sizeof(T) == 8, "only IEEE single and double precision are supported");
+    using U = typename _sort_key_unsigned<T>::type;
+    constexpr U sign = U{1} << (sizeof(U) * CHAR_BIT - 1);
+    if (v == T{0}) v = T{0}; // -0.0 and +0.0 compare equal, so they have to encode equally
+    if (v != v) v = std::numeric_limits<T>::quiet_NaN();
+    const U bits = std::bit_cast<U>(v);
+    return (bits & sign) ? static_cast<U>(~bits) : static_cast<U>(bits | sign);
+  }
+  else {
+    using U = typename _sort_key_unsigned<T>::type;
+    if constexpr (std::is_signed_v<T>) return static_cast<U>(static_cast<U>(v) ^ (U{1} << (sizeof(U) * CHAR_BIT - 1)));
+    else return static_cast<U>(v);
+  }
+}
+
+template <typename T, typename U>
+constexpr T _sort_key_from_bits(U bits) noexcept {
+  constexpr U sign = U{1} << (sizeof(U) * CHAR_BIT - 1);
+  if constexpr (std::is_enum_v<T>) return static_cast<T>(_sort_key_from_bits<std::underlying_type_t<T>>(bits));
+  else if constexpr (std::floating_point<T>) return std::bit_cast<T>((bits & sign) ? static_cast<U>(bits ^ sign) : static_cast<U>(~bits));
+  else if constexpr (std::same_as<T, bool>) return bits != 0;
+  else if constexpr (std::is_signed_v<T>) return static_cast<T>(static_cast<U>(bits ^ sign));
+  else return static_cast<T>(bits);
+}
+
+template <typename T>
+struct _sort_key_fixed_size: std::integral_constant<std::size_t, 0> {};
+
+template <_sort_key_scalar T>
+struct _sort_key_fixed_size<T>: std::integral_constant<std::size_t, sizeof(decltype(_sort_key_bits(T{})))> {};
+
+template <bool Descending, typename Buffer>
+constexpr void _sort_key_put(Buffer& out, const char* p, std::size_t n) {
+  if constexpr (Descending) {
+    for (std::size_t i = 0; i < n; ++i) out.push_back(static_cast<typename Buffer::value_type>(~static_cast<unsigned char>(p[i])));
+  }
+  else out.insert(out.end(), p, p + n);
+}
+
+// strings: 0x00 is escaped as 0x00 0xFF and the value is terminated by 0x00 0x01, which keeps prefixes ordered first
+inline constexpr char _sort_key_escape[2] = {'\x00', '\xff'};
+inline constexpr char _sort_key_terminator[2] = {'\x00', '\x01'};
+
+template <bool Descending, typename T, typename Buffer>
+constexpr void _sort_key_encode_one(const T& v, Buffer& out) {
+  if constexpr (_sort_key_string<T>) {
+    std::string_view s{v};
+    while (!s.empty()) {
+      const void* zero = std::memchr(s.data(), 0, s.size());
+      const std::size_t run = zero ? static_cast<std::size_t>(static_cast<const char*>(zero) - s.data()) : s.size();
+      _sort_key_put<Descending>(out, s.data(), run);
+      if (!zero) break;
+      _sort_key_put<Descending>(out, _sort_key_escape, 2);
+      s.remove_prefix(run + 1);
+    }
+    _sort_key_put<Descending>(out, _sort_key_terminator, 2);
+  }
+  else {
+    auto bits = _sort_key_bits(v);
+    char bytes[sizeof(bits)];
+    for (std::size_t i = sizeof(bits); i-- > 0; bits = static_cast<decltype(bits)>(bits >> CHAR_BIT)) {
+      bytes[i] = static_cast<char>(bits & 0xff);
+    }
+    _sort_key_put<Descending>(out, bytes, sizeof(bytes));
+  }
+}
+
+template <typename Spec, typename... Types, typename Buffer, std::size_t... Is>
+constexpr void _sort_key_encode(const tuple<Types...>& t, Buffer& out, std::index_sequence<Is...>) {
+  (_sort_key_encode_one<Spec::template descending<Is>>(get<Is>(t), out), ...);
+}
+
+[[noreturn]] inline void _sort_key_malformed() {
+  throw std::invalid_argument("minpp::decode_sort_key: malformed or truncated key");
+}
+
+template <bool Descending>
+constexpr unsigned char _sort_key_byte(std::string_view key, std::size_t pos) {
+  if (pos >= key.size()) _sort_key_malformed();
+  const auto b = static_cast<unsigned char>(key[pos]);
+  return Descending ? static_cast<unsigned char>(~b) : b;
+}
+
+template <bool Descending, typename T>
+constexpr T _sort_key_decode_one(std::string_view key, std::size_t& pos) {
+  if constexpr (_sort_key_string<T>) {
+    std::string s;
+    while (true) {
+      const unsigned char b = _sort_key_byte<Descending>(key, pos++);
+      if (b != 0) {
+        s.push_back(static_cast<char>(b));
+        continue;
+      }
+      const unsigned char marker = _sort_key_byte<Descending>(key, pos++);
+      if (marker == 0x01) return s;
+      if (marker != 0xff) _sort_key_malformed();
+      s.push_back('\0');
+    }
+  }
+  else {
+    decltype(_sort_key_bits(T{})) bits = 0;
+    for (std::size_t i = 0; i < sizeof(bits); ++i) {
+      bits = static_cast<decltype(bits)>((bits << CHAR_BIT) | _sort_key_byte<Descending>(key, pos++));
+    }
+    return _sort_key_from_bits<T>(bits);
+  }
+}
+
+template <typename Tuple, typename Spec>
+struct _sort_key_decoder;
+
+template <typename... Types, typename Spec>
+struct _sort_key_decoder<tuple<Types...>, Spec> {
+  template <std::size_t... Is>
+  static tuple<Types...> decode(std::string_view key, std::size_t& pos, std::index_sequence<Is...>) {
+    // braced initialization to sequence the reads from left to right
+    return tuple<Types...>{_sort_key_decode_one<Spec::template descending<Is>, Types>(key, pos)...};
+  }
+};
+
+MINPP_IMPL_END
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @fn template<class Spec = descending_columns<>, class... Types, class Buffer>
+  void encode_sort_key(const tuple<Types...>& t, Buffer& out, Spec = {});
+  @brief Appends an order-preserving binary key for t to out.
+  For two tuples a and b of the same type, memcmp order of their keys (shorter key first on a common prefix)
+  equals a <=> b, with the columns listed in Spec compared in reverse.
+  Supported element types are integral types, enumerations, float, double, std::string and std::string_view.
+  Integers and floats take their size in bytes; strings take their length plus two bytes, plus one per
+  embedded zero byte.
+  @note -0.0 and +0.0 encode equally; NaN sorts after +infinity.
+  @remarks Buffer is a contiguous container of char-sized elements, e.g. std::string or std::vector<unsigned char>.
+*/
+template <typename Spec = descending_columns<>, typename... Types, typename Buffer>
+constexpr void encode_sort_key(const tuple<Types...>& t, Buffer& out, Spec = {}) {
+  static_assert((impl::_sort_key_element<Types> && ...), "sort key elements must be integral, enum, float, double or string");
+  static_assert(sizeof(typename Buffer::value_type) == 1, "sort keys are written to a byte buffer");
+  impl::_sort_key_encode<Spec>(t, out, std::index_sequence_for<Types...>{});
+}
+
+/**
+  @fn template<class Tuple, class Spec = descending_columns<>>
+  Tuple decode_sort_key(string_view key, Spec = {});
+  @returns The tuple key was encoded from by encode_sort_key with the same Spec.
+  @pre Tuple holds no std::string_view (strings are unescaped into std::string).
+  @throws std::invalid_argument if key is truncated, malformed or has trailing bytes.
+*/
+template <typename Tuple, typename Spec = descending_columns<>>
+Tuple decode_sort_key(std::string_view key, Spec = {}) {
+  static_assert([]<std::size_t... Is>(std::index_sequence<Is...>) {
+    return (!std::same_as<std::tuple_element_t<Is, Tuple>, std::string_view> && ...);
+  }(std::make_index_sequence<std::tuple_size_v<Tuple>>{}), "decode into std::string instead of std::string_view");
+  std::size_t pos = 0;
+  Tuple t = impl::_sort_key_decoder<Tuple, Spec>::decode(key, pos, std::make_index_sequence<std::tuple_size_v<Tuple>>{});
+  if (pos != key.size()) impl::_sort_key_malformed();
+  return t;
+}
+
+/**
+  @fn template<class Spec = descending_columns<>, class InputIt, class Buffer>
+  void encode_sort_keys(InputIt first, InputIt last, Buffer& out, std::vector<std::size_t>& offsets, Spec = {});
+  @brief Batch encoder: appends the keys of the tuples in [first, last) back to back to out.
+  offsets receives one entry per key with its start in out, followed by the end of the last key, so key i
+  is out[offsets[i], offsets[i+1]).
+*/
+template <typename Spec = descending_columns<>, typename InputIt, typename Buffer>
+void encode_sort_keys(InputIt first, InputIt last, Buffer& out, std::vector<std::size_t>& offsets, Spec spec = {}) {
+  using tuple_type = std::remove_cvref_t<decltype(*first)>;
+  constexpr std::size_t fixed = []<std::size_t... Is>(std::index_sequence<Is...>) {
+    return (impl::_sort_key_fixed_size<std::tuple_element_t<Is, tuple_type>>::value + ... + 0);
+  }(std::make_index_sequence<std::tuple_size_v<tuple_type>>{});
+
+  if constexpr (std::random_access_iterator<InputIt>) {
+    const auto n = static_cast<std::size_t>(last - first);
+    out.reserve(out.size() + n * fixed);
+    offsets.reserve(offsets.size() + n + 1);
+  }
+  for (; first != last; ++first) {
+    offsets.push_back(out.size());
+    encode_sort_key(*first, out, spec);
+  }
+  offsets.push_back(out.size());
+}
+
+MINPP_NAMESPACE_END
+
+#endif
@@ -0,0 +1,355 @@
+#ifndef MINPP_SPLIT_TUPLE_H_
+#define MINPP_SPLIT_TUPLE_H_
+#include "minpp/_minpp_macros.h"
+#include "minpp/tuple.h"
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @brief Lists the fields of a split_tuple that are stored inline.
+*/
+template <typename... Types>
+struct hot {};
+
+/**
+  @brief Lists the fields of a split_tuple that are stored in a separately allocated block.
+*/
+template <typename... Types>
+struct cold {};
+
+/**
+  @brief Lists the fields of a split_tuple<tuple<Types...>, hot_at<Is...>> that are stored inline, by their
+  index in tuple<Types...>, in increasing order.
+*/
+template <std::size_t... Is>
+struct hot_at {};
+
+template <typename Record, typename Hot>
+class split_tuple;
+
+MINPP_NAMESPACE_END
+
+MINPP_IMPL_BEGIN
+
+template <typename Record, typename Hot>
+struct _split_layout;
+
+/*
+Where each logical field of a split_tuple lives: is_hot[I] tells the part and slot[I] the index within it.
+get, tuple_element and the comparisons go through this map, so the record keeps the indexing and the order
+of tuple<Types...> whichever fields are hot.
+*/
+template <typename... Types, std::size_t... Is>
+struct _split_layout<tuple<Types...>, hot_at<Is...>> {
+  static constexpr std::size_t size = sizeof...(Types);
+  static constexpr std::size_t hot_size = sizeof...(Is);
+  static constexpr std::size_t cold_size = size - hot_size;
+
+  static constexpr std::array<std::size_t, hot_size> hot_index{Is...};
+
+  static_assert(((Is < size) && ...), "hot_at index out of range");
+  static_assert([] {
+    for (std::size_t k = 1; k < hot_size; ++k) {
+      if (hot_index[k - 1] >= hot_index[k]) return false;
+    }
+    return true;
+  }(), "hot_at indices must be increasing");
+
+  static constexpr std::array<bool, size> is_hot = [] {
+    std::array<bool, size> r{};
+    for (std::size_t i: hot_index) r[i] = true;
+    return r;
+  }();
+
+  static constexpr std::array<std::size_t, size> slot = [] {
+    std::array<std::size_t, size> r{};
+    std::size_t h = 0, c = 0;
+    for (std::size_t i = 0; i < size; ++i) r[i] = is_hot[i] ? h++ : c++;
+    return r;
+  }();
+
+  static constexpr std::array<std::size_t, cold_size> cold_index = [] {
+    std::array<std::size_t, cold_size> r{};
+    std::size_t c = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+      if (!is_hot[i]) r[c++] = i;
+    }
+    return r;
+  }();
+
+  template <std::size_t I>
+  using field_t = std::tuple_element_t<I, std::tuple<Types...>>;
+
+  template <std::size_t... Cs>
+  static auto _cold_indices(std::index_sequence<Cs...>) -> std::index_sequence<cold_index[Cs]...>;
+
+  template <std::size_t... Fs>
+  static auto _fields(std::index_sequence<Fs...>) -> tuple<field_t<Fs>...>;
+
+  using record_type = tuple<Types...>;
+  using hot_indices = std::index_sequence<Is...>;
+  using cold_indices = decltype(_cold_indices(std::make_index_sequence<cold_size>{}));
+  using hot_type = decltype(_fields(hot_indices{}));
+  using cold_type = decltype(_fields(cold_indices{}));
+
+  using compare_category = std::common_comparison_category_t<
+    _synth_three_way_result<_unwrap_cacheline_t<Types>, _unwrap_cacheline_t<Types>>...>;
+};
+
+template <typename Seq>
+struct _hot_prefix;
+
+template <std::size_t... Is>
+struct _hot_prefix<std::index_sequence<Is...>> {
+  using type = hot_at<Is...>;
+};
+
+// hot<H...>, cold<C...> is tuple<H..., C...> with its first sizeof...(H) fields hot
+template <typename... H, typename... C>
+struct _split_layout<hot<H...>, cold<C...>>
+: _split_layout<tuple<H..., C...>, typename _hot_prefix<std::make_index_sequence<sizeof...(H)>>::type> {};
+
+/*
+The cold fields and the arena they came from, so that a split_tuple only spends one pointer on its cold part.
+The fields are constructed with uses-allocator construction, so pmr elements allocate from the same arena.
+*/
+template <typename Cold>
+struct _cold_block {
+  template <typename... Args>
+  explicit _cold_block(std::pmr::memory_resource* r, Args&&... args)
+  : arena{r}, fields(std::make_obj_using_allocator<Cold>(std::pmr::polymorphic_allocator<>{r}, std::forward<Args>(args)...)) {}
+
+  std::pmr::memory_resource* arena;
+  Cold fields;
+};
+
+template <typename Split, typename... Us>
+concept _split_tuple_args = !(sizeof...(Us) == 1 && (std::is_same_v<std::remove_cvref_t<Us>, Split> && ...));
+
+MINPP_IMPL_END
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @brief A record whose hot fields are stored inline and whose other fields live in a block allocated from an
+  arena, so that arrays of records stay dense in the fields a hot loop reads.
+  split_tuple<tuple<Types...>, hot_at<Is...>> keeps the fields Is... of tuple<Types...> inline; the fields
+  keep their logical indices: get<I> is the Ith of Types..., wherever it is stored, and tuple_size,
+  tuple_element, apply, structured bindings and comparisons treat the record as a tuple<Types...>, in
+  declaration order. Splitting a record therefore leaves every call site as it was.
+  split_tuple<hot<H...>, cold<C...>> is the same as split_tuple<tuple<H..., C...>, hot_at<0, ..., sizeof...(H) - 1>>.
+  @note The cold block is allocated from the memory resource of the allocator the record was constructed with
+  (the default resource otherwise), and copies allocate from the resource of the original, as
+  dynamic_tuple does. Records construct as uses-allocator types, so a std::pmr container places their cold
+  blocks in its own arena.
+  @note A moved-from record has no cold block; it may only be assigned to or destroyed.
+*/
+template <typename Record, typename Hot>
+class split_tuple {
+  using _layout = impl::_split_layout<Record, Hot>;
+  using _block = impl::_cold_block<typename _layout::cold_type>;
+
+  public:
+  using record_type = typename _layout::record_type;
+  using hot_type = typename _layout::hot_type;
+  using cold_type = typename _layout::cold_type;
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
+  static constexpr std::size_t hot_size = _layout::hot_size;
+
+  split_tuple(): split_tuple(std::allocator_arg, allocator_type{}) {}
+
+  split_tuple(std::allocator_arg_t, const allocator_type& a): _hot{}, _cold{_make_cold(a.resource())} {}
+
+  /**
+    @brief Initializes the fields, in logical order, with std::forward<Us>(us)....
+  */
+  template <typename... Us>
+  split_tuple(Us&&... us) requires
+    (sizeof...(Us) == _layout::size) && (sizeof...(Us) > 0) &&
+    impl::_split_tuple_args<split_tuple, Us...> &&
+    std::is_constructible_v<record_type, Us&&...>
+  : split_tuple(std::allocator_arg, allocator_type{}, std::forward<Us>(us)...) {}
+
+  template <typename... Us>
+  split_tuple(std::allocator_arg_t, const allocator_type& a, Us&&... us) requires
+    (sizeof...(Us) == _layout::size) && (sizeof...(Us) > 0) &&
+    impl::_split_tuple_args<split_tuple, Us...> &&
+    std::is_constructible_v<record_type, Us&&...>
+  : split_tuple(a, typename _layout::hot_indices{}, typename _layout::cold_indices{}, minpp::forward_as_tuple(std::forward<Us>(us)...)) {}
+
+  /**
+    @brief Splits a whole record.
+  */
+  explicit split_tuple(const record_type& t, const allocator_type& a = {})
+  : split_tuple(a, typename _layout::hot_indices{}, typename _layout::cold_indices{}, t) {}
+
+  split_tuple(const split_tuple& other)
+  : split_tuple(std::allocator_arg, other.get_allocator(), other) {}
+
+  split_tuple(std::allocator_arg_t, const allocator_type& a, const split_tuple& other)
+  : _hot{other._hot}, _cold{other._cold ? _make_cold(a.resource(), other._cold->fields) : nullptr} {}
+
+  split_tuple(split_tuple&& other) noexcept(std::is_nothrow_move_constructible_v<hot_type>)
+  : _hot{std::move(other._hot)}, _cold{std::exchange(other._cold, nullptr)} {}
+
+  split_tuple(std::allocator_arg_t, const allocator_type& a, split_tuple&& other)
+  : _hot{std::move(other._hot)}, _cold{nullptr} {
+    if (other._cold && other._cold->arena == a.resource()) _cold = std::exchange(other._cold, nullptr);
+    else if (other._cold) _cold = _make_cold(a.resource(), std::move(other._cold->fields));
+  }
+
+  /**
+    @brief Assigns the fields. The cold block keeps its arena; a record without one takes a copy of other's.
+  */
+  split_tuple& operator=(const split_tuple& other) {
+    if (this == &other) return *this;
+    if (_cold && other._cold) {
+      _hot = other._hot;
+      _cold->fields = other._cold->fields;
+    }
+    else {
+      split_tuple copy{other};
+      swap(copy);
+    }
+    return *this;
+  }
+
+  split_tuple& operator=(split_tuple&& other) {
+    _hot = std::move(other._hot);
+    if (_cold && other._cold && _cold->arena != other._cold->arena) _cold->fields = std::move(other._cold->fields);
+    else std::swap(_cold, other._cold);
+    return *this;
+  }
+
+  ~split_tuple() {
+    if (_cold) _free_cold(_cold);
+  }
+
+  void swap(split_tuple& other) noexcept(std::is_nothrow_swappable_v<hot_type>) {
+    using std::swap;
+    swap(_hot, other._hot);
+    swap(_cold, other._cold);
+  }
+
+  allocator_type get_allocator() const noexcept {
+    return _cold ? allocator_type{_cold->arena} : allocator_type{};
+  }
+
+  hot_type& hot_fields() noexcept { return _hot; }
+  const hot_type& hot_fields() const noexcept { return _hot; }
+
+  cold_type& cold_fields() noexcept { return _cold->fields; }
+  const cold_type& cold_fields() const noexcept { return _cold->fields; }
+
+  friend bool operator==(const split_tuple& a, const split_tuple& b) {
+    return impl::_impl_tuple_eq(a, b, std::make_index_sequence<_layout::size>{});
+  }
+
+  friend auto operator<=>(const split_tuple& a, const split_tuple& b) {
+    return impl::_impl_tuple_three_way<typename _layout::compare_category>(a, b, std::make_index_sequence<_layout::size>{});
+  }
+
+  private:
+  template <typename Args, std::size_t... Hs, std::size_t... Cs>
+  split_tuple(const allocator_type& a, std::index_sequence<Hs...>, std::index_sequence<Cs...>, Args&& args)
+  : _hot(get<Hs>(std::forward<Args>(args))...), _cold{_make_cold(a.resource(), get<Cs>(std::forward<Args>(args))...)} {}
+
+  template <typename... Args>
+  static _block* _make_cold(std::pmr::memory_resource* r, Args&&... args) {
+    void* p = r->allocate(sizeof(_block), alignof(_block));
+    try {
+      return ::new (p) _block(r, std::forward<Args>(args)...);
+    }
+    catch (...) {
+      r->deallocate(p, sizeof(_block), alignof(_block));
+      throw;
+    }
+  }
+
+  static void _free_cold(_block* b) noexcept {
+    std::pmr::memory_resource* r = b->arena;
+    b->~_block();
+    r->deallocate(b, sizeof(_block), alignof(_block));
+  }
+
+  hot_type _hot;
+  _block* _cold;
+};
+
+/**
+  @fn template<size_t I, class Record, class Hot>
+  constexpr decltype(auto) get(split_tuple<Record, Hot>& t) noexcept;
+  @returns A reference to the Ith field of t in logical order, wherever it is stored.
+*/
+template <std::size_t I, typename Record, typename Hot>
+constexpr decltype(auto) get(split_tuple<Record, Hot>& t) noexcept {
+  using layout = impl::_split_layout<Record, Hot>;
+  static_assert(I < layout::size, "get index out of range");
+  if constexpr (layout::is_hot[I]) return get<layout::slot[I]>(t.hot_fields());
+  else return get<layout::slot[I]>(t.cold_fields());
+}
+
+template <std::size_t I, typename Record, typename Hot>
+constexpr decltype(auto) get(const split_tuple<Record, Hot>& t) noexcept {
+  using layout = impl::_split_layout<Record, Hot>;
+  static_assert(I < layout::size, "get index out of range");
+  if constexpr (layout::is_hot[I]) return get<layout::slot[I]>(t.hot_fields());
+  else return get<layout::slot[I]>(t.cold_fields());
+}
+
+template <std::size_t I, typename Record, typename Hot>
+constexpr decltype(auto) get(split_tuple<Record, Hot>&& t) noexcept {
+  using layout = impl::_split_layout<Record, Hot>;
+  static_assert(I < layout::size, "get index out of range");
+  if constexpr (layout::is_hot[I]) return get<layout::slot[I]>(std::move(t.hot_fields()));
+  else return get<layout::slot[I]>(std::move(t.cold_fields()));
+}
+
+template <std::size_t I, typename Record, typename Hot>
+constexpr decltype(auto) get(const split_tuple<Record, Hot>&& t) noexcept {
+  using layout = impl::_split_layout<Record, Hot>;
+  static_assert(I < layout::size, "get index out of range");
+  if constexpr (layout::is_hot[I]) return get<layout::slot[I]>(std::move(t.hot_fields()));
+  else return get<layout::slot[I]>(std::move(t.cold_fields()));
+}
+
+template <typename Record, typename Hot>
+void swap(split_tuple<Record, Hot>& a, split_tuple<Record, Hot>& b) noexcept(noexcept(a.swap(b))) {
+  a.swap(b);
+}
+
+template <typename Record, typename Hot>
+bool operator==(const split_tuple<Record, Hot>& s, const typename split_tuple<Record, Hot>::record_type& t) {
+  return impl::_impl_tuple_eq(s, t, std::make_index_sequence<std::tuple_size_v<split_tuple<Record, Hot>>>{});
+}
+
+template <typename Record, typename Hot>
+auto operator<=>(const split_tuple<Record, Hot>& s, const typename split_tuple<Record, Hot>::record_type& t) {
+  using layout = impl::_split_layout<Record, Hot>;
+  return impl::_impl_tuple_three_way<typename layout::compare_category>(s, t, std::make_index_sequence<layout::size>{});
+}
+
+MINPP_NAMESPACE_END
+
+MINPP_STD_BEGIN
+
+template <typename Record, typename Hot>
+struct tuple_size<minpp::split_tuple<Record, Hot>>: std::integral_constant<std::size_t, minpp::impl::_split_layout<Record, Hot>::size> {};
+
+template <std::size_t I, typename Record, typename Hot>
+struct tuple_element<I, minpp::split_tuple<Record, Hot>>: tuple_element<I, typename minpp::impl::_split_layout<Record, Hot>::record_type> {};
+
+MINPP_STD_END
+
+#endif
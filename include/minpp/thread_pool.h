@@ -0,0 +1,272 @@
+#ifndef MINPP_THREAD_POOL_H_
+#define MINPP_THREAD_POOL_H_
+#include "minpp/_minpp_macros.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+MINPP_IMPL_BEGIN
+
+/*
+Intrusive unit of work. The submitter owns the storage and keeps it alive until run has been called.
+*/
+struct _pool_task {
+  void (*run)(_pool_task*) noexcept;
+};
+
+MINPP_IMPL_END
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @brief Small work-stealing thread pool.
+  Every worker owns a deque: it pushes and pops its own work at the back and steals from the front of
+  the other workers' deques when it runs dry. Work submitted from outside the pool is distributed round
+  robin. Tasks are intrusive, so scheduling does not allocate.
+  @note The destructor runs every task that is still queued before joining the workers.
+*/
+class thread_pool {
+  public:
+  explicit thread_pool(std::size_t threads = std::max(1u, std::thread::hardware_concurrency()))
+  : _queues(std::max<std::size_t>(threads, 1)) {
+    _workers.reserve(_queues.size());
+    for (std::size_t i = 0; i < _queues.size(); ++i) _workers.emplace_back([this, i] { _work(i); });
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  ~thread_pool() {
+    {
+      std::lock_guard lk{_sleep_mutex};
+      _stop = true;
+    }
+    _sleep_cv.notify_all();
+    for (auto& w: _workers) w.join();
+  }
+
+  std::size_t size() const noexcept { return _queues.size(); }
+
+  /**
+    @brief Runs f on one of the workers. Exceptions thrown by f terminate the program.
+  */
+  template <typename F>
+  void post(F&& f) {
+    struct posted: impl::_pool_task {
+      std::decay_t<F> fn;
+    };
+    std::unique_ptr<posted> t{new posted{{[](impl::_pool_task* self) noexcept {
+      std::unique_ptr<posted> p{static_cast<posted*>(self)};
+      p->fn();
+    }}, std::forward<F>(f)}};
+    // owned by the queue once _submit returns
+    _submit(t.get());
+    t.release();
+  }
+
+  /**
+    @brief Runs one queued task on the calling thread, if there is any.
+    @returns Whether a task was run.
+    Used by threads that wait on work submitted to this pool, so that waiting inside a task cannot
+    starve the pool.
+  */
+  bool run_pending_task() noexcept {
+    impl::_pool_task* t = _pop(_current_index());
+    if (!t) return false;
+    t->run(t);
+    return true;
+  }
+
+  // throws only before t is queued
+  void _submit(impl::_pool_task* t) {
+    const std::size_t self = _current_index();
+    const std::size_t target = self != _npos ? self : _next.fetch_add(1, std::memory_order_relaxed) % _queues.size();
+    {
+      std::lock_guard lk{_queues[target].mutex};
+      _queues[target].tasks.push_back(t);
+    }
+    _queued.fetch_add(1);
+    _wake();
+  }
+
+  /*
+  Submits nodes[first, n), intrusive tasks owned by the caller. If a submission throws, the nodes not yet
+  queued run on the calling thread instead, so every node runs exactly once either way and the caller may
+  wait for all of them before its storage goes away.
+  */
+  template <typename Node>
+  void _submit_all(Node* nodes, std::size_t first, std::size_t n) noexcept {
+    std::size_t i = first;
+    try {
+      for (; i < n; ++i) _submit(&nodes[i]);
+    }
+    catch (...) {
+      for (; i < n; ++i) nodes[i].run(&nodes[i]);
+    }
+  }
+
+  private:
+  static constexpr std::size_t _npos = static_cast<std::size_t>(-1);
+
+  struct alignas(MINPP_CACHELINE_SIZE) _queue {
+    std::mutex mutex;
+    std::deque<impl::_pool_task*> tasks;
+  };
+
+  std::size_t _current_index() const noexcept {
+    return _tls_pool == this ? _tls_index : _npos;
+  }
+
+  impl::_pool_task* _pop(std::size_t self) noexcept {
+    if (_queued.load(std::memory_order_relaxed) == 0) return nullptr;
+    if (self != _npos) {
+      std::lock_guard lk{_queues[self].mutex};
+      if (!_queues[self].tasks.empty()) {
+        impl::_pool_task* t = _queues[self].tasks.back();
+        _queues[self].tasks.pop_back();
+        _queued.fetch_sub(1, std::memory_order_relaxed);
+        return t;
+      }
+    }
+    const std::size_t start = self != _npos ? self + 1 : 0;
+    for (std::size_t k = 0; k < _queues.size(); ++k) {
+      auto& victim = _queues[(start + k) % _queues.size()];
+      std::lock_guard lk{victim.mutex};
+      if (!victim.tasks.empty()) {
+        impl::_pool_task* t = victim.tasks.front();
+        victim.tasks.pop_front();
+        _queued.fetch_sub(1, std::memory_order_relaxed);
+        return t;
+      }
+    }
+    return nullptr;
+  }
+
+  void _wake() noexcept {
+    if (_sleepers.load() > 0) {
+      { std::lock_guard lk{_sleep_mutex}; }
+      _sleep_cv.notify_one();
+    }
+  }
+
+  void _work(std::size_t index) {
+    _tls_pool = this;
+    _tls_index = index;
+    while (true) {
+      if (impl::_pool_task* t = _pop(index)) {
+        t->run(t);
+        continue;
+      }
+      std::unique_lock lk{_sleep_mutex};
+      _sleepers.fetch_add(1);
+      while (!_stop && _queued.load() == 0) _sleep_cv.wait(lk);
+      _sleepers.fetch_sub(1);
+      if (_stop && _queued.load() == 0) return;
+    }
+  }
+
+  inline static thread_local const thread_pool* _tls_pool = nullptr;
+  inline static thread_local std::size_t _tls_index = _npos;
+
+  std::vector<_queue> _queues;
+  std::vector<std::thread> _workers;
+  std::atomic<std::size_t> _next{0};
+  std::atomic<std::size_t> _queued{0};
+  std::atomic<std::size_t> _sleepers{0};
+  std::mutex _sleep_mutex;
+  std::condition_variable _sleep_cv;
+  bool _stop = false;
+};
+
+MINPP_NAMESPACE_END
+
+MINPP_IMPL_BEGIN
+
+/*
+Completion count of a batch of tasks submitted with _submit_all, whose storage belongs to a submitter that
+waits for them. The task that arrives last calls release as its last access to the batch.
+*/
+struct _pool_completion {
+  std::atomic<std::size_t> remaining;
+  std::atomic<bool> done{false};
+
+  // whether this was the last task of the batch
+  bool arrive() noexcept {
+    return remaining.fetch_sub(1, std::memory_order_acq_rel) == 1;
+  }
+
+  void release() noexcept {
+    remaining.notify_all();
+    // last access to *this: the waiting thread may destroy the batch as soon as it observes done
+    done.store(true, std::memory_order_release);
+  }
+
+  // helps with the queued work of pool until the last task has released the batch
+  void wait(thread_pool& pool) noexcept {
+    while (true) {
+      const std::size_t left = remaining.load(std::memory_order_acquire);
+      if (left == 0) break;
+      if (!pool.run_pending_task()) remaining.wait(left, std::memory_order_acquire);
+    }
+    while (!done.load(std::memory_order_acquire)) std::this_thread::yield();
+  }
+};
+
+/*
+Runs f(0), ..., f(n - 1) on pool and waits for them, the calling thread running f(0) and helping with queued
+work meanwhile; when_all does the same for a fixed set of callables. Rethrows the exception of the lowest i
+whose call threw, after every call has finished.
+*/
+template <typename F>
+void _pool_fanout(thread_pool& pool, std::size_t n, F& f) {
+  struct state;
+  struct node: _pool_task {
+    state* self;
+    std::size_t i;
+  };
+  struct state {
+    F& f;
+    std::vector<node> nodes;
+    std::vector<std::exception_ptr> errors;
+    _pool_completion batch;
+
+    static void run(_pool_task* t) noexcept {
+      node* nd = static_cast<node*>(t);
+      state* self = nd->self;
+      try {
+        self->f(nd->i);
+      }
+      catch (...) {
+        self->errors[nd->i] = std::current_exception();
+      }
+      if (self->batch.arrive()) self->batch.release();
+    }
+  };
+
+  if (n == 0) return;
+  state s{f, std::vector<node>(n), std::vector<std::exception_ptr>(n), {n}};
+  for (std::size_t i = 0; i < n; ++i) {
+    s.nodes[i].run = &state::run;
+    s.nodes[i].self = &s;
+    s.nodes[i].i = i;
+  }
+  pool._submit_all(s.nodes.data(), 1, n);
+  state::run(&s.nodes[0]);
+  s.batch.wait(pool);
+  for (const std::exception_ptr& e: s.errors) {
+    if (e) std::rethrow_exception(e);
+  }
+}
+
+MINPP_IMPL_END
+
+#endif
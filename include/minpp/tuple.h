@@ -6,6 +6,7 @@
 
 #include <concepts>
 #include <functional>
+#include <span>
 #include <type_traits>
 #include <utility>
 
@@ -14,15 +15,77 @@ MINPP_NAMESPACE_BEGIN
 template<typename... Types>
 struct tuple;
 
+/**
+  @brief Element wrapper that gives a tuple element a cache line of its own.
+  An element declared as cacheline<T> is aligned to MINPP_CACHELINE_SIZE and padded to a multiple of it, so
+  elements that different threads update do not share a line. Access by index (get<I>, apply,
+  tuple_element, structured bindings) unwraps it and sees the T.
+*/
+template <typename T>
+struct cacheline {
+  alignas(MINPP_CACHELINE_SIZE) T value{};
+
+  constexpr cacheline() = default;
+
+  template <typename U>
+  constexpr cacheline(U&& u) noexcept(std::is_nothrow_constructible_v<T, U>) requires
+    (!std::is_same_v<std::remove_cvref_t<U>, cacheline>) && std::is_constructible_v<T, U>
+  : value(std::forward<U>(u)) {}
+
+  template <typename U>
+  constexpr cacheline& operator=(U&& u) noexcept(std::is_nothrow_assignable_v<T&, U>) requires
+    (!std::is_same_v<std::remove_cvref_t<U>, cacheline>) && std::is_assignable_v<T&, U> {
+    value = std::forward<U>(u);
+    return *this;
+  }
+
+  friend constexpr void swap(cacheline& a, cacheline& b) noexcept(std::is_nothrow_swappable_v<T>) {
+    using std::swap;
+    swap(a.value, b.value);
+  }
+};
+
+/**
+  @brief A tuple whose every element is on its own cache line, i.e. tuple<cacheline<Types>...>.
+*/
+template <typename... Types>
+using aligned_tuple = tuple<cacheline<Types>...>;
+
 MINPP_NAMESPACE_END
 
 MINPP_IMPL_BEGIN
 
 struct _select_tuple_leaf_ctor {};
 
+// tags the element-wise allocator-extended constructors of _tuple_t, which would otherwise also match a whole
+// tuple passed as the only element of a 1-tuple
+struct _select_elementwise_ctor {};
+
+template <typename... Us>
+inline constexpr bool _leading_allocator_arg = false;
+
+template <typename U, typename... Us>
+inline constexpr bool _leading_allocator_arg<U, Us...> = std::is_same_v<std::remove_cvref_t<U>, std::allocator_arg_t>;
+
+template <typename... Ts>
+concept _copy_assignable_elements = (std::assignable_from<Ts&, const Ts&> && ...);
+
+template <typename... Ts>
+concept _move_assignable_elements = (std::assignable_from<Ts&, Ts&&> && ...);
+
+// reference elements assign through, so only tuples of trivially assignable objects assign bitwise
+template <typename... Ts>
+concept _trivially_copy_assignable_elements = _copy_assignable_elements<Ts...> && ((!std::is_reference_v<Ts> && std::is_trivially_copy_assignable_v<Ts>) && ...);
+
+template <typename... Ts>
+concept _trivially_move_assignable_elements = _move_assignable_elements<Ts...> && ((!std::is_reference_v<Ts> && std::is_trivially_move_assignable_v<Ts>) && ...);
+
+/*
+value is public so that tuple is a structural type (C++20 [temp.param]) and usable as a non-type template
+argument; it is only reached through _impl_at and _impl_at_type_leaf.
+*/
 template<std::size_t I, typename T>
 struct tuple_leaf {
-  private:
   T value{};
 
   template<std::size_t, typename>
@@ -50,14 +113,14 @@ struct tuple_leaf {
   constexpr tuple_leaf() = default;
 
   template <typename U>
-  constexpr tuple_leaf(U&& v) requires requires {
+  MINPP_ALWAYS_INLINE constexpr tuple_leaf(U&& v) noexcept(std::is_nothrow_constructible_v<T, U>) requires requires {
     requires !std::is_arithmetic_v<T>;
-  }: value(std::forward<U>(v)) {}
+  }: value(MINPP_FWD(v)) {}
 
   template <typename U>
-  constexpr tuple_leaf(U&& v) requires requires {
+  MINPP_ALWAYS_INLINE constexpr tuple_leaf(U&& v) noexcept(std::is_nothrow_constructible_v<T, U>) requires requires {
     requires std::is_arithmetic_v<T>;
-  }: value{std::forward<U>(v)} {}
+  }: value{MINPP_FWD(v)} {}
 
   template <typename U>
   constexpr tuple_leaf(_select_tuple_leaf_ctor, const tuple_leaf<I, U>& v): tuple_leaf(v.value) {}
@@ -67,8 +130,8 @@ struct tuple_leaf {
 
   template <typename Alloc>
   constexpr tuple_leaf(std::allocator_arg_t, const Alloc& a) requires requires {
-    !leading_allocator_constructible<T, Alloc>;
-    !trailing_allocator_constructible<T, Alloc>;
+    requires !leading_allocator_constructible<T, Alloc>;
+    requires !trailing_allocator_constructible<T, Alloc>;
   }
   : tuple_leaf{} {}
 
@@ -77,21 +140,24 @@ struct tuple_leaf {
   : value(std::allocator_arg_t{}, a) {}
 
   template <typename Alloc>
-  constexpr tuple_leaf(std::allocator_arg_t, const Alloc& a) requires trailing_allocator_constructible<T, Alloc>
+  constexpr tuple_leaf(std::allocator_arg_t, const Alloc& a) requires requires {
+    requires !leading_allocator_constructible<T, Alloc>;
+    requires trailing_allocator_constructible<T, Alloc>;
+  }
   : value(a) {}
 
   template <typename Alloc, typename U>
   constexpr tuple_leaf(std::allocator_arg_t, const Alloc& a, U&& v) requires requires {
-    !leading_allocator_constructible<T, Alloc, U>;
-    !trailing_allocator_constructible<T, Alloc, U>;
+    requires !leading_allocator_constructible<T, Alloc, U>;
+    requires !trailing_allocator_constructible<T, Alloc, U>;
     requires !std::is_arithmetic_v<T>;
   }
   : value(std::forward<U>(v)) {}
 
   template <typename Alloc, typename U>
   constexpr tuple_leaf(std::allocator_arg_t, const Alloc& a, U&& v) requires requires {
-    !leading_allocator_constructible<T, Alloc, U>;
-    !trailing_allocator_constructible<T, Alloc, U>;
+    requires !leading_allocator_constructible<T, Alloc, U>;
+    requires !trailing_allocator_constructible<T, Alloc, U>;
     requires std::is_arithmetic_v<T>;
   }
   : value{std::forward<U>(v)} {}
@@ -101,7 +167,10 @@ struct tuple_leaf {
   : value(std::allocator_arg_t{}, a, std::forward<U>(v)) {}
 
   template <typename Alloc, typename U>
-  constexpr tuple_leaf(std::allocator_arg_t, const Alloc& a, U&& v) requires trailing_allocator_constructible<T, Alloc, U>
+  constexpr tuple_leaf(std::allocator_arg_t, const Alloc& a, U&& v) requires requires {
+    requires !leading_allocator_constructible<T, Alloc, U>;
+    requires trailing_allocator_constructible<T, Alloc, U>;
+  }
   : value(std::forward<U>(v), a) {}
 
   template <typename Alloc, typename U>
@@ -126,13 +195,14 @@ struct tuple_t_from_size {
       constexpr _tuple_t() = default;
 
       // § 20.5.3.1 2)
-      constexpr _tuple_t(const T&... v) : tuple_leaf<Is, T>{v}... {}
+      MINPP_ALWAYS_INLINE constexpr _tuple_t(const T&... v) : tuple_leaf<Is, T>{v}... {}
 
       // § 20.5.3.1 3)
       template <typename... UTypes>
-      constexpr _tuple_t(UTypes&&... u) requires requires {
+      MINPP_ALWAYS_INLINE constexpr _tuple_t(UTypes&&... u) noexcept((std::is_nothrow_constructible_v<T, UTypes> && ...)) requires requires {
         requires sizeof...(UTypes) == sizeof...(T);
-      } : tuple_leaf<Is, T>{std::forward<UTypes>(u)}... {}
+        requires !_leading_allocator_arg<UTypes...>;
+      } : tuple_leaf<Is, T>{MINPP_FWD(u)}... {}
 
       // § 20.5.3.1 4)
       _tuple_t(const _tuple_t&) = default;
@@ -170,11 +240,11 @@ struct tuple_t_from_size {
 
       // § 20.5.3.1 11)
       template <typename Alloc>
-      constexpr _tuple_t(std::allocator_arg_t, const Alloc& a, const T&... v) : tuple_leaf<Is, T>{std::allocator_arg_t{}, a, v}... {}
+      constexpr _tuple_t(std::allocator_arg_t, const Alloc& a, _select_elementwise_ctor, const T&... v) : tuple_leaf<Is, T>{std::allocator_arg_t{}, a, v}... {}
 
       // § 20.5.3.1 12)
       template <typename Alloc, typename... UTypes>
-      constexpr _tuple_t(std::allocator_arg_t, const Alloc& a, UTypes&&... u) requires requires {
+      constexpr _tuple_t(std::allocator_arg_t, const Alloc& a, _select_elementwise_ctor, UTypes&&... u) requires requires {
         requires sizeof...(UTypes) == sizeof...(T);
       } : tuple_leaf<Is, T>{std::allocator_arg_t{}, a, std::forward<UTypes>(u)}... {}
 
@@ -204,25 +274,30 @@ struct tuple_t_from_size {
 
 
       // § 20.5.3.2
+      // defaulted when every element assigns trivially, so that such tuples are trivially copyable
+      _tuple_t& operator=(const _tuple_t&) requires _trivially_copy_assignable_elements<T...> = default;
+      _tuple_t& operator=(_tuple_t&&) requires _trivially_move_assignable_elements<T...> = default;
+
+      // assign through _impl_at so that reference elements assign to the referred object
       constexpr _tuple_t& operator=(const _tuple_t& u) noexcept((std::is_nothrow_copy_assignable_v<T> && ...)) {
-        (tuple_leaf<Is, T>::operator=(static_cast<const tuple_leaf<Is, T>&>(u)), ...);
+        ((_impl_at<Is>(*this) = _impl_at<Is>(u)), ...);
         return *this;
       }
 
       constexpr _tuple_t& operator=(_tuple_t&& u) noexcept((std::is_nothrow_move_assignable_v<T> && ...)) {
-        (tuple_leaf<Is, T>::operator=(static_cast<tuple_leaf<Is, T>&&>(u)), ...);
+        ((_impl_at<Is>(*this) = _impl_at<Is>(std::move(u))), ...);
         return *this;
       }
 
       template <typename... UTypes>
-      constexpr _tuple_t& operator=(const _tuple_t<UTypes...>& u) {
-        (tuple_leaf<Is, T>::operator=(get<Is>(u)), ...);
+      constexpr _tuple_t& operator=(const tuple<UTypes...>& u) {
+        ((_impl_at<Is>(*this) = _impl_at<Is>(u)), ...);
         return *this;
       }
 
       template <typename... UTypes>
-      constexpr _tuple_t& operator=(_tuple_t<UTypes...>&& u) {
-        (tuple_leaf<Is, T>::operator=(get<Is>(u)), ...);
+      constexpr _tuple_t& operator=(tuple<UTypes...>&& u) {
+        ((_impl_at<Is>(*this) = _impl_at<Is>(std::move(u))), ...);
         return *this;
       }
 
@@ -236,53 +311,243 @@ struct tuple_t_from_size {
   using tuple_t = typename make_same_parameterized_value<std::size_t>::of_t<_tuple_t_with_size, std::make_index_sequence<I>>::template _tuple_t<T...>;
 };
 
+template <typename T>
+inline constexpr bool _array_storable_element = std::is_object_v<T> && !std::is_array_v<T>;
+
+template <typename T>
+inline constexpr bool _array_storable_element<cacheline<T>> = false;
+
+// tuples of two or more elements of one object type are stored as an array, see _array_tuple_t
+template <typename T, typename... Ts>
+inline constexpr bool _array_storable = MINPP_HOMOGENEOUS_ARRAY_STORAGE && (sizeof...(Ts) > 0) &&
+  (std::is_same_v<T, Ts> && ...) && _array_storable_element<T>;
+
+// builds an element the way tuple_leaf initializes its value, so that both storages accept the same arguments
+template <typename T, typename U>
+MINPP_ALWAYS_INLINE constexpr T _array_element(U&& u) {
+  if constexpr (std::is_arithmetic_v<T>) return T{MINPP_FWD(u)};
+  else return static_cast<T>(MINPP_FWD(u));
+}
+
+template <typename T, typename Alloc, typename... U>
+constexpr T _array_element_alloc(const Alloc& a, U&&... u) {
+  if constexpr (leading_allocator_constructible<T, Alloc, U...>) return T(std::allocator_arg_t{}, a, std::forward<U>(u)...);
+  else if constexpr (trailing_allocator_constructible<T, Alloc, U...>) return T(std::forward<U>(u)..., a);
+  else if constexpr (sizeof...(U) == 0) return T{};
+  else return _array_element<T>(std::forward<U>(u)...);
+}
+
+/*
+Storage of tuple<T, ..., T>: the elements in one array instead of a chain of tuple_leaf bases, with the same
+constructors, assignments and swap as _tuple_t so that tuple does not tell them apart. The layout is the same
+(N consecutive Ts), but the elements can also be indexed at run time, so loops over them vectorize, and a
+tuple of many elements instantiates one class instead of one leaf per element.
+value is public so that tuple stays a structural type.
+*/
+template <typename T, std::size_t N, typename Is = std::make_index_sequence<N>>
+struct _array_tuple_t;
+
+template <typename T, std::size_t N, std::size_t... Is>
+struct _array_tuple_t<T, N, std::index_sequence<Is...>> {
+  T value[N];
+
+  // value-initializes each element like tuple_leaf's T value{}; a {} member initializer on the array would
+  // copy-list-initialize them and reject explicit default constructors
+  constexpr _array_tuple_t() noexcept(std::is_nothrow_default_constructible_v<T>) : value{(static_cast<void>(Is), T())...} {}
+
+  template <typename... UTypes>
+  MINPP_ALWAYS_INLINE constexpr _array_tuple_t(UTypes&&... u) noexcept((std::is_nothrow_constructible_v<T, UTypes> && ...)) requires requires {
+    requires sizeof...(UTypes) == N;
+    requires !_leading_allocator_arg<UTypes...>;
+  } : value{_array_element<T>(MINPP_FWD(u))...} {}
+
+  _array_tuple_t(const _array_tuple_t&) = default;
+
+  _array_tuple_t(_array_tuple_t&&) = default;
+
+  template <template <typename...> typename _Tuple_Like, typename... UTypes>
+  constexpr _array_tuple_t(const _Tuple_Like<UTypes...>& v) requires requires {
+    requires !std::derived_from<_Tuple_Like<UTypes...>, _array_tuple_t>;
+    { ((get<Is>(v), void()), ...) };
+  }
+  : value{_array_element<T>(get<Is>(v))...} {}
+
+  template <template <typename...> typename _Tuple_Like, typename... UTypes>
+  constexpr _array_tuple_t(_Tuple_Like<UTypes...>&& v) requires requires {
+    requires !std::derived_from<_Tuple_Like<UTypes...>, _array_tuple_t>;
+    { ((get<Is>(std::move(v)), void()), ...) };
+  }
+  : value{_array_element<T>(get<Is>(std::move(v)))...} {}
+
+  template <typename Alloc>
+  constexpr _array_tuple_t(std::allocator_arg_t, const Alloc& a) : value{(static_cast<void>(Is), _array_element_alloc<T>(a))...} {}
+
+  template <typename Alloc, typename... UTypes>
+  constexpr _array_tuple_t(std::allocator_arg_t, const Alloc& a, _select_elementwise_ctor, UTypes&&... u) requires requires {
+    requires sizeof...(UTypes) == N;
+  } : value{_array_element_alloc<T>(a, std::forward<UTypes>(u))...} {}
+
+  template <typename Alloc, template <typename...> typename _Tuple_Like, typename... UTypes>
+  constexpr _array_tuple_t(std::allocator_arg_t, const Alloc& a, const _Tuple_Like<UTypes...>& v) requires requires {
+    { ((get<Is>(v), void()), ...) };
+  }
+  : value{_array_element_alloc<T>(a, get<Is>(v))...} {}
+
+  template <typename Alloc, template <typename...> typename _Tuple_Like, typename... UTypes>
+  constexpr _array_tuple_t(std::allocator_arg_t, const Alloc& a, _Tuple_Like<UTypes...>&& v) requires requires {
+    { ((get<Is>(std::move(v)), void()), ...) };
+  }
+  : value{_array_element_alloc<T>(a, get<Is>(std::move(v)))...} {}
+
+  _array_tuple_t& operator=(const _array_tuple_t&) requires _trivially_copy_assignable_elements<T> = default;
+  _array_tuple_t& operator=(_array_tuple_t&&) requires _trivially_move_assignable_elements<T> = default;
+
+  constexpr _array_tuple_t& operator=(const _array_tuple_t& u) noexcept(std::is_nothrow_copy_assignable_v<T>) {
+    ((value[Is] = u.value[Is]), ...);
+    return *this;
+  }
+
+  constexpr _array_tuple_t& operator=(_array_tuple_t&& u) noexcept(std::is_nothrow_move_assignable_v<T>) {
+    ((value[Is] = std::move(u.value[Is])), ...);
+    return *this;
+  }
+
+  template <typename... UTypes>
+  constexpr _array_tuple_t& operator=(const tuple<UTypes...>& u) {
+    ((value[Is] = get<Is>(u)), ...);
+    return *this;
+  }
+
+  template <typename... UTypes>
+  constexpr _array_tuple_t& operator=(tuple<UTypes...>&& u) {
+    ((value[Is] = get<Is>(std::move(u))), ...);
+    return *this;
+  }
+
+  constexpr void swap(_array_tuple_t& other) noexcept(std::is_nothrow_swappable_v<T>) {
+    using std::swap;
+    (swap(value[Is], other.value[Is]), ...);
+  }
+};
+
+template <typename... Types>
+struct _tuple_storage {
+  using type = typename tuple_t_from_size<sizeof...(Types)>::template tuple_t<Types...>;
+};
+
+template <typename T, typename... Ts> requires _array_storable<T, Ts...>
+struct _tuple_storage<T, Ts...> {
+  using type = _array_tuple_t<T, sizeof...(Ts) + 1>;
+};
+
 struct ignore_t
 {
   template <typename T>
   constexpr ignore_t& operator=(T&&) { return *this; }
 };
 
+template <typename T>
+struct _unwrap_cacheline {
+  using type = T;
+};
+
+template <typename T>
+struct _unwrap_cacheline<cacheline<T>> {
+  using type = T;
+};
+
+// the element type seen through get for a declared element type
+template <typename T>
+using _unwrap_cacheline_t = typename _unwrap_cacheline<T>::type;
+
 template<std::size_t I, typename T>
 T _impl_typeof_helper(const tuple_leaf<I, T>&);
 
 template<std::size_t I, typename T>
-constexpr T& _impl_at(tuple_leaf<I, T>& leaf) noexcept {
+T _impl_typeof_helper(const tuple_leaf<I, cacheline<T>>&);
+
+template<std::size_t I, typename T>
+MINPP_ALWAYS_INLINE constexpr T& _impl_at(tuple_leaf<I, T>& leaf) noexcept {
   return leaf.value;
 }
 
 template<std::size_t I, typename T>
-constexpr const T& _impl_at(const tuple_leaf<I, T>& leaf) noexcept {
+MINPP_ALWAYS_INLINE constexpr const T& _impl_at(const tuple_leaf<I, T>& leaf) noexcept {
   return leaf.value;
 }
 
 template<std::size_t I, typename T>
-constexpr T&& _impl_at(tuple_leaf<I, T>&& leaf) noexcept {
+MINPP_ALWAYS_INLINE constexpr T&& _impl_at(tuple_leaf<I, T>&& leaf) noexcept {
   return static_cast<T&&>(leaf.value);
 }
 
 template<std::size_t I, typename T>
-constexpr const T&& _impl_at(const tuple_leaf<I, T>&& leaf) noexcept {
+MINPP_ALWAYS_INLINE constexpr const T&& _impl_at(const tuple_leaf<I, T>&& leaf) noexcept {
   return static_cast<const T&&>(leaf.value);
 }
 
+// cacheline elements are reached through the wrapper
+template<std::size_t I, typename T>
+MINPP_ALWAYS_INLINE constexpr T& _impl_at(tuple_leaf<I, cacheline<T>>& leaf) noexcept {
+  return leaf.value.value;
+}
+
+template<std::size_t I, typename T>
+MINPP_ALWAYS_INLINE constexpr const T& _impl_at(const tuple_leaf<I, cacheline<T>>& leaf) noexcept {
+  return leaf.value.value;
+}
+
+template<std::size_t I, typename T>
+MINPP_ALWAYS_INLINE constexpr T&& _impl_at(tuple_leaf<I, cacheline<T>>&& leaf) noexcept {
+  return static_cast<T&&>(leaf.value.value);
+}
+
+template<std::size_t I, typename T>
+MINPP_ALWAYS_INLINE constexpr const T&& _impl_at(const tuple_leaf<I, cacheline<T>>&& leaf) noexcept {
+  return static_cast<const T&&>(leaf.value.value);
+}
+
+template<std::size_t I, typename T, std::size_t N, typename Is>
+T _impl_typeof_helper(const _array_tuple_t<T, N, Is>&);
+
+template<std::size_t I, typename T, std::size_t N, typename Is>
+MINPP_ALWAYS_INLINE constexpr T& _impl_at(_array_tuple_t<T, N, Is>& t) noexcept {
+  return t.value[I];
+}
+
+template<std::size_t I, typename T, std::size_t N, typename Is>
+MINPP_ALWAYS_INLINE constexpr const T& _impl_at(const _array_tuple_t<T, N, Is>& t) noexcept {
+  return t.value[I];
+}
+
+template<std::size_t I, typename T, std::size_t N, typename Is>
+MINPP_ALWAYS_INLINE constexpr T&& _impl_at(_array_tuple_t<T, N, Is>&& t) noexcept {
+  return static_cast<T&&>(t.value[I]);
+}
+
+template<std::size_t I, typename T, std::size_t N, typename Is>
+MINPP_ALWAYS_INLINE constexpr const T&& _impl_at(const _array_tuple_t<T, N, Is>&& t) noexcept {
+  return static_cast<const T&&>(t.value[I]);
+}
+
 
 template<typename T, std::size_t I>
-constexpr T& _impl_at_type_leaf(tuple_leaf<I, T>& leaf) noexcept {
+MINPP_ALWAYS_INLINE constexpr T& _impl_at_type_leaf(tuple_leaf<I, T>& leaf) noexcept {
   return leaf.value;
 }
 
 template<typename T, std::size_t I>
-constexpr const T& _impl_at_type_leaf(const tuple_leaf<I, T>& leaf) noexcept {
+MINPP_ALWAYS_INLINE constexpr const T& _impl_at_type_leaf(const tuple_leaf<I, T>& leaf) noexcept {
   return leaf.value;
 }
 
 template<typename T, std::size_t I>
-constexpr T&& _impl_at_type_leaf(tuple_leaf<I, T>&& leaf) noexcept {
+MINPP_ALWAYS_INLINE constexpr T&& _impl_at_type_leaf(tuple_leaf<I, T>&& leaf) noexcept {
   return static_cast<T&&>(leaf.value);
 }
 
 template<typename T, std::size_t I>
-constexpr const T&& _impl_at_type_leaf(const tuple_leaf<I, T>&& leaf) noexcept {
+MINPP_ALWAYS_INLINE constexpr const T&& _impl_at_type_leaf(const tuple_leaf<I, T>&& leaf) noexcept {
   return static_cast<const T&&>(leaf.value);
 }
 
@@ -291,9 +556,9 @@ MINPP_IMPL_END
 MINPP_NAMESPACE_BEGIN
 
 template<typename... Types>
-struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t<Types...> {
+struct tuple: public impl::_tuple_storage<Types...>::type {
 
-  using _impl = typename impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t<Types...>;
+  using _impl = typename impl::_tuple_storage<Types...>::type;
   
   /**
     @fn constexpr explicit(see below ) tuple();
@@ -313,7 +578,7 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
     @remarks The expression inside explicit is equivalent to:
       !conjunction_v<is_convertible<const Types&, Types>...>
   */
-  constexpr explicit(!(std::is_convertible_v<const Types&, Types> && ...)) tuple(const Types&... v) requires requires {
+  MINPP_ALWAYS_INLINE constexpr explicit(!(std::is_convertible_v<const Types&, Types> && ...)) tuple(const Types&... v) requires requires {
     // requires sizeof...(Types) > 0; // sizeof...(Types) == 0 instantiate specialized tuple template
     requires (std::copy_constructible<Types> && ...);
   }
@@ -328,12 +593,11 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
       !conjunction_v<is_convertible<UTypes, Types>...>
   */
   template <typename... UTypes>
-  constexpr explicit(!(std::is_convertible_v<UTypes, Types> && ...)) tuple(UTypes&&... u) requires requires {
-    requires sizeof...(Types) == sizeof...(UTypes);
-    // requires sizeof...(Types) > 0; // sizeof...(Types) == 0 instantiate specialized tuple template
-    requires (std::constructible_from<Types, UTypes> && ...);
-  }
-  : _impl{std::forward<UTypes>(u)...} {}
+  MINPP_ALWAYS_INLINE constexpr explicit(!(std::is_convertible_v<UTypes, Types> && ...)) tuple(UTypes&&... u)
+    noexcept((std::is_nothrow_constructible_v<Types, UTypes> && ...)) requires
+    (sizeof...(Types) == sizeof...(UTypes)) &&
+    (std::constructible_from<Types, UTypes> && ...)
+  : _impl{MINPP_FWD(u)...} {}
 
   /**
     @fn tuple(const tuple&) = default;
@@ -362,18 +626,10 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
       !conjunction_v<is_convertible<const UTypes&, Types>...>
   */
   template <typename... UTypes>
-  constexpr explicit(!(std::is_convertible_v<const UTypes&, Types> && ...)) tuple(const tuple<UTypes...>& v) requires requires {
-    requires sizeof...(Types) == sizeof...(UTypes);
-    requires (std::constructible_from<Types, const UTypes&> && ...);
-    requires requires {
-      requires sizeof...(Types) != 1 ||
-      requires {
-        requires !(std::convertible_to<const tuple<UTypes>&, Types> && ...);
-        requires !(std::constructible_from<Types, const tuple<UTypes>&> && ...);
-        !std::same_as<tuple<Types...>, tuple<UTypes...>>;
-      };
-    };
-  }
+  constexpr explicit(!(std::is_convertible_v<const UTypes&, Types> && ...)) tuple(const tuple<UTypes...>& v) requires
+    (sizeof...(Types) == sizeof...(UTypes)) &&
+    (std::constructible_from<Types, const UTypes&> && ...) &&
+    (sizeof...(Types) != 1 || (!(std::convertible_to<const tuple<UTypes>&, Types> && ...) && !(std::constructible_from<Types, const tuple<UTypes>&> && ...)))
   : _impl{v} {}
 
 #if MINPP_STD_COMPAT
@@ -387,17 +643,10 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
       !conjunction_v<is_convertible<const UTypes&, Types>...>
   */
   template <typename... UTypes>
-  constexpr explicit(!(std::is_convertible_v<const UTypes&, Types> && ...)) tuple(const std::tuple<UTypes...>& v) requires requires {
-    requires sizeof...(Types) == sizeof...(UTypes);
-    requires (std::constructible_from<Types, const UTypes&> && ...);
-    requires requires {
-      requires sizeof...(Types) != 1 ||
-      requires {
-        requires !(std::convertible_to<const tuple<UTypes>&, Types> && ...);
-        requires !(std::constructible_from<Types, const tuple<UTypes>&> && ...);
-      };
-    };
-  }
+  constexpr explicit(!(std::is_convertible_v<const UTypes&, Types> && ...)) tuple(const std::tuple<UTypes...>& v) requires
+    (sizeof...(Types) == sizeof...(UTypes)) &&
+    (std::constructible_from<Types, const UTypes&> && ...) &&
+    (sizeof...(Types) != 1 || (!(std::convertible_to<const tuple<UTypes>&, Types> && ...) && !(std::constructible_from<Types, const tuple<UTypes>&> && ...)))
   : _impl{v} {}
 
 #endif
@@ -411,18 +660,10 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
       !conjunction_v<is_convertible<UTypes, Types>...>
   */
   template <typename... UTypes>
-  constexpr explicit(!(std::is_convertible_v<UTypes, Types> && ...)) tuple(tuple<UTypes...>&& v) requires requires {
-    requires sizeof...(Types) == sizeof...(UTypes);
-    requires (std::constructible_from<Types, UTypes> && ...);
-    requires requires {
-      requires sizeof...(Types) != 1 ||
-      requires {
-        requires !(std::convertible_to<tuple<UTypes>, Types> && ...);
-        requires !(std::constructible_from<Types, tuple<UTypes>> && ...);
-        !std::same_as<tuple<Types...>, tuple<UTypes...>>;
-      };
-    };
-  }
+  constexpr explicit(!(std::is_convertible_v<UTypes, Types> && ...)) tuple(tuple<UTypes...>&& v) requires
+    (sizeof...(Types) == sizeof...(UTypes)) &&
+    (std::constructible_from<Types, UTypes> && ...) &&
+    (sizeof...(Types) != 1 || (!(std::convertible_to<tuple<UTypes>, Types> && ...) && !(std::constructible_from<Types, tuple<UTypes>> && ...)))
   : _impl{std::move(v)} {}
 
 #if MINPP_STD_COMPAT
@@ -436,17 +677,10 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
       !conjunction_v<is_convertible<UTypes, Types>...>
   */
   template <typename... UTypes>
-  constexpr explicit(!(std::is_convertible_v<UTypes, Types> && ...)) tuple(std::tuple<UTypes...>&& v) requires requires {
-    requires sizeof...(Types) == sizeof...(UTypes);
-    requires (std::constructible_from<Types, UTypes> && ...);
-    requires requires {
-      requires sizeof...(Types) != 1 ||
-      requires {
-        requires !(std::convertible_to<tuple<UTypes>, Types> && ...);
-        requires !(std::constructible_from<Types, tuple<UTypes>> && ...);
-      };
-    };
-  }
+  constexpr explicit(!(std::is_convertible_v<UTypes, Types> && ...)) tuple(std::tuple<UTypes...>&& v) requires
+    (sizeof...(Types) == sizeof...(UTypes)) &&
+    (std::constructible_from<Types, UTypes> && ...) &&
+    (sizeof...(Types) != 1 || (!(std::convertible_to<tuple<UTypes>, Types> && ...) && !(std::constructible_from<Types, tuple<UTypes>> && ...)))
   : _impl{std::move(v)} {}
 
 #endif
@@ -462,10 +696,9 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
       !is_convertible_v<const U1&, T0> || !is_convertible_v<const U2&, T1>
   */
   template <typename... UTypes>
-  constexpr explicit(!(std::is_convertible_v<const UTypes&, Types> && ...)) tuple(const std::pair<UTypes...>& v) requires requires {
-    requires sizeof...(Types) == 2;
-    requires (std::constructible_from<Types, const UTypes&> && ...);
-  }
+  constexpr explicit(!(std::is_convertible_v<const UTypes&, Types> && ...)) tuple(const std::pair<UTypes...>& v) requires
+    (sizeof...(Types) == 2) &&
+    (std::constructible_from<Types, const UTypes&> && ...)
   : _impl{v} {}
 
 #endif
@@ -482,10 +715,9 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
       !is_convertible_v<U1, T0> || !is_convertible_v<U2, T1>
   */
   template <typename... UTypes>
-  constexpr explicit(!(std::is_convertible_v<const UTypes&, Types> && ...)) tuple(std::pair<UTypes...>&& v) requires requires {
-    requires sizeof...(Types) == 2;
-    requires (std::constructible_from<Types, UTypes> && ...);
-  }
+  constexpr explicit(!(std::is_convertible_v<const UTypes&, Types> && ...)) tuple(std::pair<UTypes...>&& v) requires
+    (sizeof...(Types) == 2) &&
+    (std::constructible_from<Types, UTypes> && ...)
   : _impl{std::move(v)} {}
 
 #endif
@@ -498,9 +730,8 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
     Equivalent to the preceding constructors except that each element is constructed with usesallocator construction (20.10.7.2).
   */
   template <typename Alloc>
-  constexpr explicit(!(minpp::is_list_constructible_v<Types> && ...)) tuple(std::allocator_arg_t, const Alloc& a) requires requires {
-    requires (std::constructible_from<std::type_identity_t<Types>> && ...); // std::type_identity_t cuz g++ doesn't want to be nice with me
-  }
+  constexpr explicit(!(minpp::is_list_constructible_v<Types> && ...)) tuple(std::allocator_arg_t, const Alloc& a) requires
+    (std::constructible_from<std::type_identity_t<Types>> && ...) // std::type_identity_t cuz g++ doesn't want to be nice with me
   : _impl{std::allocator_arg_t{}, a} {}
 
   /**
@@ -511,10 +742,9 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
     Equivalent to the preceding constructors except that each element is constructed with usesallocator construction (20.10.7.2).
   */
   template <typename Alloc, typename... UTypes>
-  constexpr explicit(!(std::is_convertible_v<const Types&, Types> && ...)) tuple(std::allocator_arg_t, const Alloc& a, const Types&... v) requires requires {
-    requires (std::constructible_from<std::type_identity_t<Types>> && ...); // std::type_identity_t cuz g++ doesn't want to be nice with me
-  }
-  : _impl{std::allocator_arg_t{}, a, v...} {}
+  constexpr explicit(!(std::is_convertible_v<const Types&, Types> && ...)) tuple(std::allocator_arg_t, const Alloc& a, const Types&... v) requires
+    (std::constructible_from<std::type_identity_t<Types>> && ...) // std::type_identity_t cuz g++ doesn't want to be nice with me
+  : _impl{std::allocator_arg_t{}, a, impl::_select_elementwise_ctor{}, v...} {}
 
   /**
     @fn template<class Alloc, class... UTypes>
@@ -524,12 +754,10 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
     Equivalent to the preceding constructors except that each element is constructed with usesallocator construction (20.10.7.2).
   */
   template <typename Alloc, typename... UTypes>
-  constexpr explicit(!(std::is_convertible_v<UTypes, Types> && ...)) tuple(std::allocator_arg_t, const Alloc& a, UTypes&&... u) requires requires {
-    requires sizeof...(Types) == sizeof...(UTypes);
-    // requires sizeof...(Types) > 0; // sizeof...(Types) == 0 instantiate specialized tuple template
-    requires (std::constructible_from<Types, UTypes> && ...);
-  }
-  : _impl{std::allocator_arg_t{}, a, std::forward<UTypes>(u)...} {}
+  constexpr explicit(!(std::is_convertible_v<UTypes, Types> && ...)) tuple(std::allocator_arg_t, const Alloc& a, UTypes&&... u) requires
+    (sizeof...(Types) == sizeof...(UTypes)) &&
+    (std::constructible_from<Types, UTypes> && ...)
+  : _impl{std::allocator_arg_t{}, a, impl::_select_elementwise_ctor{}, std::forward<UTypes>(u)...} {}
 
   /**
     @fn template<class Alloc>
@@ -539,9 +767,8 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
     Equivalent to the preceding constructors except that each element is constructed with usesallocator construction (20.10.7.2).
   */
   template <typename Alloc>
-  constexpr tuple(std::allocator_arg_t, const Alloc& a, const tuple& u) requires requires {
-    requires (std::copy_constructible<std::type_identity_t<Types>> && ...); // std::type_identity_t cuz g++ doesn't want to be nice with me
-  }
+  constexpr tuple(std::allocator_arg_t, const Alloc& a, const tuple& u) requires
+    (std::copy_constructible<std::type_identity_t<Types>> && ...) // std::type_identity_t cuz g++ doesn't want to be nice with me
   : _impl{std::allocator_arg_t{}, a, u} {}
 
   /**
@@ -552,9 +779,8 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
     Equivalent to the preceding constructors except that each element is constructed with usesallocator construction (20.10.7.2).
   */
   template <typename Alloc>
-  constexpr tuple(std::allocator_arg_t, const Alloc& a, tuple&& u) requires requires {
-    requires (std::move_constructible<std::type_identity_t<Types>> && ...); // std::type_identity_t cuz g++ doesn't want to be nice with me
-  }
+  constexpr tuple(std::allocator_arg_t, const Alloc& a, tuple&& u) requires
+    (std::move_constructible<std::type_identity_t<Types>> && ...) // std::type_identity_t cuz g++ doesn't want to be nice with me
   : _impl{std::allocator_arg_t{}, a, std::move(u)} {}
 
   /**
@@ -565,18 +791,10 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
     Equivalent to the preceding constructors except that each element is constructed with usesallocator construction (20.10.7.2).
   */
   template <typename Alloc, typename... UTypes>
-  constexpr explicit(!(std::is_convertible_v<const UTypes&, Types> && ...)) tuple(std::allocator_arg_t, const Alloc& a, const tuple<UTypes...>& v) requires requires {
-    requires sizeof...(Types) == sizeof...(UTypes);
-    requires (std::constructible_from<Types, const UTypes&> && ...);
-    requires requires {
-      requires sizeof...(Types) != 1 ||
-      requires {
-        requires !(std::convertible_to<const tuple<UTypes>&, Types> && ...);
-        requires !(std::constructible_from<Types, const tuple<UTypes>&> && ...);
-        !std::same_as<tuple<Types...>, tuple<UTypes...>>;
-      };
-    };
-  }
+  constexpr explicit(!(std::is_convertible_v<const UTypes&, Types> && ...)) tuple(std::allocator_arg_t, const Alloc& a, const tuple<UTypes...>& v) requires
+    (sizeof...(Types) == sizeof...(UTypes)) &&
+    (std::constructible_from<Types, const UTypes&> && ...) &&
+    (sizeof...(Types) != 1 || (!(std::convertible_to<const tuple<UTypes>&, Types> && ...) && !(std::constructible_from<Types, const tuple<UTypes>&> && ...)))
   : _impl{std::allocator_arg_t{}, a, v} {}
 
 #if MINPP_STD_COMPAT
@@ -589,17 +807,10 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
     Equivalent to the preceding constructors except that each element is constructed with usesallocator construction (20.10.7.2).
   */
   template <typename Alloc, typename... UTypes>
-  constexpr explicit(!(std::is_convertible_v<const UTypes&, Types> && ...)) tuple(std::allocator_arg_t, const Alloc& a, const std::tuple<UTypes...>& v) requires requires {
-    requires sizeof...(Types) == sizeof...(UTypes);
-    requires (std::constructible_from<Types, const UTypes&> && ...);
-    requires requires {
-      requires sizeof...(Types) != 1 ||
-      requires {
-        requires !(std::convertible_to<const tuple<UTypes>&, Types> && ...);
-        requires !(std::constructible_from<Types, const tuple<UTypes>&> && ...);
-      };
-    };
-  }
+  constexpr explicit(!(std::is_convertible_v<const UTypes&, Types> && ...)) tuple(std::allocator_arg_t, const Alloc& a, const std::tuple<UTypes...>& v) requires
+    (sizeof...(Types) == sizeof...(UTypes)) &&
+    (std::constructible_from<Types, const UTypes&> && ...) &&
+    (sizeof...(Types) != 1 || (!(std::convertible_to<const tuple<UTypes>&, Types> && ...) && !(std::constructible_from<Types, const tuple<UTypes>&> && ...)))
   : _impl{std::allocator_arg_t{}, a, v} {}
 
 #endif
@@ -612,18 +823,10 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
     Equivalent to the preceding constructors except that each element is constructed with usesallocator construction (20.10.7.2).
   */
   template <typename Alloc, typename... UTypes>
-  constexpr explicit(!(std::is_convertible_v<UTypes, Types> && ...)) tuple(std::allocator_arg_t, const Alloc& a, tuple<UTypes...>&& v) requires requires {
-    requires sizeof...(Types) == sizeof...(UTypes);
-    requires (std::constructible_from<Types, UTypes> && ...);
-    requires requires {
-      requires sizeof...(Types) != 1 ||
-      requires {
-        requires !(std::convertible_to<tuple<UTypes>, Types> && ...);
-        requires !(std::constructible_from<Types, tuple<UTypes>> && ...);
-        !std::same_as<tuple<Types...>, tuple<UTypes...>>;
-      };
-    };
-  }
+  constexpr explicit(!(std::is_convertible_v<UTypes, Types> && ...)) tuple(std::allocator_arg_t, const Alloc& a, tuple<UTypes...>&& v) requires
+    (sizeof...(Types) == sizeof...(UTypes)) &&
+    (std::constructible_from<Types, UTypes> && ...) &&
+    (sizeof...(Types) != 1 || (!(std::convertible_to<tuple<UTypes>, Types> && ...) && !(std::constructible_from<Types, tuple<UTypes>> && ...)))
   : _impl{std::allocator_arg_t{}, a, std::move(v)} {}
 
 #if MINPP_STD_COMPAT
@@ -636,17 +839,10 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
     Equivalent to the preceding constructors except that each element is constructed with usesallocator construction (20.10.7.2).
   */
   template <typename Alloc, typename... UTypes>
-  constexpr explicit(!(std::is_convertible_v<UTypes, Types> && ...)) tuple(std::allocator_arg_t, const Alloc& a, std::tuple<UTypes...>&& v) requires requires {
-    requires sizeof...(Types) == sizeof...(UTypes);
-    requires (std::constructible_from<Types, UTypes> && ...);
-    requires requires {
-      requires sizeof...(Types) != 1 ||
-      requires {
-        requires !(std::convertible_to<tuple<UTypes>, Types> && ...);
-        requires !(std::constructible_from<Types, tuple<UTypes>> && ...);
-      };
-    };
-  }
+  constexpr explicit(!(std::is_convertible_v<UTypes, Types> && ...)) tuple(std::allocator_arg_t, const Alloc& a, std::tuple<UTypes...>&& v) requires
+    (sizeof...(Types) == sizeof...(UTypes)) &&
+    (std::constructible_from<Types, UTypes> && ...) &&
+    (sizeof...(Types) != 1 || (!(std::convertible_to<tuple<UTypes>, Types> && ...) && !(std::constructible_from<Types, tuple<UTypes>> && ...)))
   : _impl{std::allocator_arg_t{}, a, std::move(v)} {}
 
 #endif
@@ -661,10 +857,9 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
     Equivalent to the preceding constructors except that each element is constructed with usesallocator construction (20.10.7.2).
   */
   template <typename Alloc, typename... UTypes>
-  constexpr explicit(!(std::is_convertible_v<const UTypes&, Types> && ...)) tuple(std::allocator_arg_t, const Alloc& a, const std::pair<UTypes...>& v) requires requires {
-    requires sizeof...(Types) == 2;
-    requires (std::constructible_from<Types, const UTypes&> && ...);
-  }
+  constexpr explicit(!(std::is_convertible_v<const UTypes&, Types> && ...)) tuple(std::allocator_arg_t, const Alloc& a, const std::pair<UTypes...>& v) requires
+    (sizeof...(Types) == 2) &&
+    (std::constructible_from<Types, const UTypes&> && ...)
   : _impl{std::allocator_arg_t{}, a, v} {}
 
 #endif
@@ -679,10 +874,9 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
     Equivalent to the preceding constructors except that each element is constructed with usesallocator construction (20.10.7.2).
   */
   template <typename Alloc, typename... UTypes>
-  constexpr explicit(!(std::is_convertible_v<const UTypes&, Types> && ...)) tuple(std::allocator_arg_t, const Alloc& a, std::pair<UTypes...>&& v) requires requires {
-    requires sizeof...(Types) == 2;
-    requires (std::constructible_from<Types, UTypes> && ...);
-  }
+  constexpr explicit(!(std::is_convertible_v<const UTypes&, Types> && ...)) tuple(std::allocator_arg_t, const Alloc& a, std::pair<UTypes...>&& v) requires
+    (sizeof...(Types) == 2) &&
+    (std::constructible_from<Types, UTypes> && ...)
   : _impl{std::allocator_arg_t{}, a, std::move(v)} {}
 
 #endif
@@ -695,9 +889,9 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
     Assigns each element of u to the corresponding element of *this. 
     @remarks This operator is defined as deleted unless is_copy_assignable_v<Ti> is true for all i.
   */
-  constexpr tuple& operator=(const tuple& u) noexcept((std::is_nothrow_copy_assignable_v<Types> && ...)) requires requires {
-    requires (std::assignable_from<Types&, const Types&> && ...);
-  } {
+  tuple& operator=(const tuple&) requires impl::_trivially_copy_assignable_elements<Types...> = default;
+
+  constexpr tuple& operator=(const tuple& u) noexcept((std::is_nothrow_copy_assignable_v<Types> && ...)) requires impl::_copy_assignable_elements<Types...> {
     _impl::operator=(u);
     return *this;
   }
@@ -711,9 +905,9 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
       is_nothrow_move_assignable_v<Ti>
     where Ti is the ith type in Types.
   */
-  constexpr tuple& operator=(tuple&& u) noexcept((std::is_nothrow_move_assignable_v<Types> && ...)) requires requires {
-    requires (std::assignable_from<Types&, Types&&> && ...);
-  } {
+  tuple& operator=(tuple&&) requires impl::_trivially_move_assignable_elements<Types...> = default;
+
+  constexpr tuple& operator=(tuple&& u) noexcept((std::is_nothrow_move_assignable_v<Types> && ...)) requires impl::_move_assignable_elements<Types...> {
     _impl::operator=(std::move(u));
     return *this;
   }
@@ -763,23 +957,77 @@ struct tuple: public impl::tuple_t_from_size<sizeof...(Types)>::template tuple_t
   }
 
   template <std::size_t I>
-  constexpr decltype(auto) operator[](std::integral_constant<std::size_t, I>) & {
+  MINPP_ALWAYS_INLINE constexpr decltype(auto) operator[](std::integral_constant<std::size_t, I>) & {
     return impl::_impl_at<I>(*this);
   }
 
   template <std::size_t I>
-  constexpr decltype(auto) operator[](std::integral_constant<std::size_t, I>) && {
-    return impl::_impl_at<I>(std::forward<tuple&&>(*this));
+  MINPP_ALWAYS_INLINE constexpr decltype(auto) operator[](std::integral_constant<std::size_t, I>) && {
+    return impl::_impl_at<I>(static_cast<tuple&&>(*this));
   }
 
   template <std::size_t I>
-  constexpr decltype(auto) operator[](std::integral_constant<std::size_t, I>) const & {
+  MINPP_ALWAYS_INLINE constexpr decltype(auto) operator[](std::integral_constant<std::size_t, I>) const & {
     return impl::_impl_at<I>(*this);
   }
 
   template <std::size_t I>
-  constexpr decltype(auto) operator[](std::integral_constant<std::size_t, I>) const && {
-    return impl::_impl_at<I>(std::forward<const tuple&&>(*this));
+  MINPP_ALWAYS_INLINE constexpr decltype(auto) operator[](std::integral_constant<std::size_t, I>) const && {
+    return impl::_impl_at<I>(static_cast<const tuple&&>(*this));
+  }
+
+  /**
+    @fn constexpr T& operator[](size_t i) & noexcept; // only if every type in Types is the same object type T
+    @returns A reference to the ith element.
+    @pre i < sizeof...(Types).
+    @note A tuple of two or more elements of one object type (other than cacheline) stores them in an array,
+    which can be indexed at run time, and viewed through data() and std::span. Define
+    MINPP_HOMOGENEOUS_ARRAY_STORAGE as false to store them as any other tuple.
+  */
+  MINPP_ALWAYS_INLINE constexpr auto& operator[](std::size_t i) & noexcept requires impl::_array_storable<Types...> {
+    return this->value[i];
+  }
+
+  MINPP_ALWAYS_INLINE constexpr auto&& operator[](std::size_t i) && noexcept requires impl::_array_storable<Types...> {
+    return std::move(this->value[i]);
+  }
+
+  MINPP_ALWAYS_INLINE constexpr auto& operator[](std::size_t i) const & noexcept requires impl::_array_storable<Types...> {
+    return this->value[i];
+  }
+
+  MINPP_ALWAYS_INLINE constexpr auto&& operator[](std::size_t i) const && noexcept requires impl::_array_storable<Types...> {
+    return std::move(this->value[i]);
+  }
+
+  /**
+    @fn constexpr T* data() noexcept; // only if every type in Types is the same object type T
+    @returns A pointer to the first of the sizeof...(Types) contiguous elements.
+  */
+  MINPP_ALWAYS_INLINE constexpr auto* data() noexcept requires impl::_array_storable<Types...> {
+    return this->value;
+  }
+
+  MINPP_ALWAYS_INLINE constexpr const auto* data() const noexcept requires impl::_array_storable<Types...> {
+    return this->value;
+  }
+
+  /**
+    @fn template<class U, size_t Extent> constexpr operator span<U, Extent>() & noexcept;
+    @returns A span over the elements, of static or dynamic extent. U is T or const T.
+  */
+  template <typename U, std::size_t Extent>
+  constexpr operator std::span<U, Extent>() & noexcept requires
+    impl::_array_storable<Types...> && ((std::is_same_v<U, Types> && ...) || (std::is_same_v<U, const Types> && ...)) &&
+    (Extent == sizeof...(Types) || Extent == std::dynamic_extent) {
+    return std::span<U, Extent>(this->value, sizeof...(Types));
+  }
+
+  template <typename U, std::size_t Extent>
+  constexpr operator std::span<U, Extent>() const & noexcept requires
+    impl::_array_storable<Types...> && (std::is_same_v<U, const Types> && ...) &&
+    (Extent == sizeof...(Types) || Extent == std::dynamic_extent) {
+    return std::span<U, Extent>(this->value, sizeof...(Types));
   }
 };
 
@@ -842,7 +1090,7 @@ template <template <typename...> typename _T, typename... _Us> requires requires
 struct enable_expand_type_with_template_args<_T<_Us...>>: public std::true_type {};
 
 template <typename T>
-static constexpr bool enable_expand_type_with_template_args_v = enable_expand_type_with_template_args<T>::value;
+inline constexpr bool enable_expand_type_with_template_args_v = enable_expand_type_with_template_args<T>::value;
 
 MINPP_NAMESPACE_END
 
@@ -854,23 +1102,23 @@ concept Once_T = requires {
 };
 
 template <typename T, typename... Ts>
-constexpr T& _impl_at_type_l(tuple<Ts...>& t) noexcept requires impl::Once_T<T, Ts...> {
+MINPP_ALWAYS_INLINE constexpr T& _impl_at_type_l(tuple<Ts...>& t) noexcept requires impl::Once_T<T, Ts...> {
   return _impl_at_type_leaf<T>(t);
 }
 
 template <typename T, typename... Ts>
-constexpr const T& _impl_at_type_cl(const tuple<Ts...>& t) noexcept requires impl::Once_T<T, Ts...> {
+MINPP_ALWAYS_INLINE constexpr const T& _impl_at_type_cl(const tuple<Ts...>& t) noexcept requires impl::Once_T<T, Ts...> {
   return _impl_at_type_leaf<T>(t);
 }
 
 template <typename T, typename... Ts>
-constexpr T&& _impl_at_type_r(tuple<Ts...>&& t) noexcept requires impl::Once_T<T, Ts...> {
-  return _impl_at_type_leaf<T>(std::forward<minpp::tuple<Ts...>&&>(t));
+MINPP_ALWAYS_INLINE constexpr T&& _impl_at_type_r(tuple<Ts...>&& t) noexcept requires impl::Once_T<T, Ts...> {
+  return _impl_at_type_leaf<T>(static_cast<minpp::tuple<Ts...>&&>(t));
 }
 
 template <typename T, typename... Ts>
-constexpr const T&& _impl_at_type_cr(const tuple<Ts...>&& t) noexcept requires impl::Once_T<T, Ts...> {
-  return _impl_at_type_leaf<T>(std::forward<const minpp::tuple<Ts...>&&>(t));
+MINPP_ALWAYS_INLINE constexpr const T&& _impl_at_type_cr(const tuple<Ts...>&& t) noexcept requires impl::Once_T<T, Ts...> {
+  return _impl_at_type_leaf<T>(static_cast<const minpp::tuple<Ts...>&&>(t));
 }
 
 MINPP_IMPL_END
@@ -1095,7 +1343,7 @@ struct tuple_size<minpp::tuple<Types...>> : std::integral_constant<std::size_t,
 */
 template <std::size_t I, typename... T>
 struct tuple_element<I, minpp::tuple<T...>> {
-  using type = decltype(_impl_typeof_helper<I>(minpp::tuple<T...>{}));
+  using type = decltype(_impl_typeof_helper<I>(std::declval<const minpp::tuple<T...>&>()));
 };
 
 MINPP_STD_END
@@ -1111,7 +1359,7 @@ MINPP_NAMESPACE_BEGIN
   function, code where the type depended on a template parameter would have required using the template keyword.
 */
 template <std::size_t I, typename... Types>
-constexpr decltype(auto) get(minpp::tuple<Types...>& t) noexcept {
+MINPP_ALWAYS_INLINE constexpr decltype(auto) get(minpp::tuple<Types...>& t) noexcept {
   return minpp::impl::_impl_at<I>(t);
 }
 
@@ -1127,8 +1375,8 @@ constexpr decltype(auto) get(minpp::tuple<Types...>& t) noexcept {
   function, code where the type depended on a template parameter would have required using the template keyword.
 */
 template <std::size_t I, typename... Types>
-constexpr decltype(auto) get(minpp::tuple<Types...>&& t) noexcept {
-  return minpp::impl::_impl_at<I>(std::forward<minpp::tuple<Types...>&&>(t));
+MINPP_ALWAYS_INLINE constexpr decltype(auto) get(minpp::tuple<Types...>&& t) noexcept {
+  return minpp::impl::_impl_at<I>(static_cast<minpp::tuple<Types...>&&>(t));
 }
 
 /**
@@ -1144,7 +1392,7 @@ constexpr decltype(auto) get(minpp::tuple<Types...>&& t) noexcept {
   function, code where the type depended on a template parameter would have required using the template keyword.
 */
 template <std::size_t I, typename... Types>
-constexpr decltype(auto) get(const minpp::tuple<Types...>& t) noexcept {
+MINPP_ALWAYS_INLINE constexpr decltype(auto) get(const minpp::tuple<Types...>& t) noexcept {
   return minpp::impl::_impl_at<I>(t);
 }
 
@@ -1158,8 +1406,8 @@ constexpr decltype(auto) get(const minpp::tuple<Types...>& t) noexcept {
   function, code where the type depended on a template parameter would have required using the template keyword.
 */
 template <std::size_t I, typename... Types>
-constexpr decltype(auto) get(const minpp::tuple<Types...>&& t) noexcept {
-  return minpp::impl::_impl_at<I>(std::forward<const minpp::tuple<Types...>&&>(t));
+MINPP_ALWAYS_INLINE constexpr decltype(auto) get(const minpp::tuple<Types...>&& t) noexcept {
+  return minpp::impl::_impl_at<I>(static_cast<const minpp::tuple<Types...>&&>(t));
 }
 
 /**
@@ -1172,7 +1420,7 @@ constexpr decltype(auto) get(const minpp::tuple<Types...>&& t) noexcept {
   function, code where the type depended on a template parameter would have required using the template keyword.
 */
 template <typename T, typename... Types>
-constexpr T& get(minpp::tuple<Types...>& t) noexcept {
+MINPP_ALWAYS_INLINE constexpr T& get(minpp::tuple<Types...>& t) noexcept {
   return minpp::impl::_impl_at_type_l<T>(t);
 }
 
@@ -1186,8 +1434,8 @@ constexpr T& get(minpp::tuple<Types...>& t) noexcept {
   function, code where the type depended on a template parameter would have required using the template keyword.
 */
 template <typename T, typename... Types>
-constexpr T&& get(minpp::tuple<Types...>&& t) noexcept {
-  return minpp::impl::_impl_at_type_r<T>(std::forward<minpp::tuple<Types...>&&>(t));
+MINPP_ALWAYS_INLINE constexpr T&& get(minpp::tuple<Types...>&& t) noexcept {
+  return minpp::impl::_impl_at_type_r<T>(static_cast<minpp::tuple<Types...>&&>(t));
 }
 
 /**
@@ -1200,7 +1448,7 @@ constexpr T&& get(minpp::tuple<Types...>&& t) noexcept {
   function, code where the type depended on a template parameter would have required using the template keyword.
 */
 template <typename T, typename... Types>
-constexpr const T& get(const minpp::tuple<Types...>& t) noexcept {
+MINPP_ALWAYS_INLINE constexpr const T& get(const minpp::tuple<Types...>& t) noexcept {
   return minpp::impl::_impl_at_type_cl<T>(t);
 }
 
@@ -1214,8 +1462,8 @@ constexpr const T& get(const minpp::tuple<Types...>& t) noexcept {
   function, code where the type depended on a template parameter would have required using the template keyword.
 */
 template <typename T, typename... Types>
-constexpr const T&& get(const minpp::tuple<Types...>&& t) noexcept {
-  return minpp::impl::_impl_at_type_cr<T>(std::forward<const minpp::tuple<Types...>&&>(t));
+MINPP_ALWAYS_INLINE constexpr const T&& get(const minpp::tuple<Types...>&& t) noexcept {
+  return minpp::impl::_impl_at_type_cr<T>(static_cast<const minpp::tuple<Types...>&&>(t));
 }
 
 MINPP_NAMESPACE_END
@@ -1251,7 +1499,7 @@ MINPP_NAMESPACE_BEGIN
 */
 template <typename... TTypes, typename... UTypes>
 constexpr bool operator==(const tuple<TTypes...>& t, const tuple<UTypes...>& u) {
-  return _impl_tuple_eq(t, u, std::make_index_sequence<sizeof...(TTypes)>{});
+  return impl::_impl_tuple_eq(t, u, std::make_index_sequence<sizeof...(TTypes)>{});
 }
 
 /**
@@ -1270,7 +1518,7 @@ constexpr bool operator==(const tuple<TTypes...>& t, const tuple<UTypes...>& u)
 */
 template <typename... TTypes, typename... UTypes>
 constexpr auto operator<=>(const tuple<TTypes...>& t, const tuple<UTypes...>& u) {
-  return _impl_tuple_three_way<std::common_comparison_category_t<_synth_three_way_result<TTypes, UTypes>...>>(t, u, std::make_index_sequence<sizeof...(TTypes)>{});
+  return impl::_impl_tuple_three_way<std::common_comparison_category_t<_synth_three_way_result<impl::_unwrap_cacheline_t<TTypes>, impl::_unwrap_cacheline_t<UTypes>>...>>(t, u, std::make_index_sequence<sizeof...(TTypes)>{});
 }
 
 MINPP_NAMESPACE_END
@@ -0,0 +1,424 @@
+#ifndef MINPP_TUPLE_INTERNER_H_
+#define MINPP_TUPLE_INTERNER_H_
+#include "minpp/_minpp_macros.h"
+#include "minpp/projection.h"
+#include "minpp/tuple.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+MINPP_IMPL_BEGIN
+
+template <typename T>
+inline constexpr bool _is_string_view = false;
+
+template <typename C, typename Traits>
+inline constexpr bool _is_string_view<std::basic_string_view<C, Traits>> = true;
+
+/*
+Storage for the interned tuples that never moves them: segment k holds 1024 << k elements, so element i
+is found with a bit scan and 23 segments cover every 32-bit id. Only writers allocate segments and they
+are serialized by the interner; in the concurrent store the segment pointers are atomic, so readers that
+were handed an id look its element up without a lock.
+*/
+template <typename T, bool Concurrent>
+class _segmented_store {
+  static constexpr unsigned _first_bits = 10;
+  static constexpr unsigned _segments = 33 - _first_bits;
+
+  using _pointer = std::conditional_t<Concurrent, std::atomic<T*>, T*>;
+
+  public:
+  _segmented_store() noexcept: _segment{} {}
+
+  _segmented_store(const _segmented_store&) = delete;
+  _segmented_store& operator=(const _segmented_store&) = delete;
+
+  ~_segmented_store() {
+    std::size_t left = _size;
+    for (unsigned k = 0; k < _segments; ++k) {
+      T* p = _load(k);
+      if (!p) break;
+      const std::size_t n = std::min(left, _segment_size(k));
+      std::destroy_n(p, n);
+      left -= n;
+      std::allocator<T>{}.deallocate(p, _segment_size(k));
+    }
+  }
+
+  MINPP_ALWAYS_INLINE const T& operator[](std::size_t i) const noexcept {
+    return *_address(i);
+  }
+
+  // constructs element _size; the caller publishes it
+  template <typename... Us>
+  T& emplace_back(Us&&... us) {
+    const auto [k, offset] = _locate(_size);
+    if (offset == 0 && !_load(k)) {
+      T* p = std::allocator<T>{}.allocate(_segment_size(k));
+      if constexpr (Concurrent) _segment[k].store(p, std::memory_order_release);
+      else _segment[k] = p;
+    }
+    T* e = std::construct_at(_load(k) + offset, MINPP_FWD(us)...);
+    ++_size;
+    return *e;
+  }
+
+  std::size_t size() const noexcept {
+    return _size;
+  }
+
+  private:
+  static constexpr std::size_t _segment_size(unsigned k) noexcept {
+    return std::size_t{1} << (_first_bits + k);
+  }
+
+  MINPP_ALWAYS_INLINE static std::pair<unsigned, std::size_t> _locate(std::size_t i) noexcept {
+    const std::size_t j = i + (std::size_t{1} << _first_bits);
+    const unsigned k = static_cast<unsigned>(std::bit_width(j)) - 1 - _first_bits;
+    return {k, j - _segment_size(k)};
+  }
+
+  MINPP_ALWAYS_INLINE T* _load(unsigned k) const noexcept {
+    if constexpr (Concurrent) return _segment[k].load(std::memory_order_acquire);
+    else return _segment[k];
+  }
+
+  MINPP_ALWAYS_INLINE T* _address(std::size_t i) const noexcept {
+    const auto [k, offset] = _locate(i);
+    return _load(k) + offset;
+  }
+
+  _pointer _segment[_segments];
+  std::size_t _size = 0;
+};
+
+/*
+Bump allocator for the characters of interned string views. Blocks are never freed before the interner,
+so the views stay valid; a string longer than a block gets a block of its own.
+*/
+class _char_arena {
+  static constexpr std::size_t _block_size = 64 * 1024;
+
+  public:
+  template <typename C>
+  const C* store(const C* s, std::size_t n) {
+    const std::size_t bytes = n * sizeof(C);
+    if (bytes == 0) return s;
+    std::size_t at = (_used + alignof(C) - 1) & ~(alignof(C) - 1);
+    if (_blocks.empty() || at + bytes > _capacity) {
+      _capacity = std::max(_block_size, bytes);
+      _blocks.push_back(std::make_unique_for_overwrite<std::byte[]>(_capacity));
+      at = 0;
+    }
+    std::byte* p = _blocks.back().get() + at;
+    std::copy_n(reinterpret_cast<const std::byte*>(s), bytes, p);
+    _used = at + bytes;
+    _total += bytes;
+    return reinterpret_cast<const C*>(p);
+  }
+
+  std::size_t bytes() const noexcept {
+    return _total;
+  }
+
+  private:
+  std::vector<std::unique_ptr<std::byte[]>> _blocks;
+  std::size_t _used = 0;
+  std::size_t _capacity = 0;
+  std::size_t _total = 0;
+};
+
+MINPP_IMPL_END
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @brief Maps each distinct tuple<Types...> it is given to a dense 32-bit id, in the order they were first
+  seen, and keeps one copy of every such tuple, so repeated composite keys can be replaced by ids that take
+  4 bytes and compare as integers.
+  Every interned tuple is stored once, in segments that never move, and elements of a basic_string_view type
+  have their characters copied into the interner: the view in the stored tuple points there, not to the
+  caller's buffer. Looking a tuple up hashes its elements in place and copies nothing; only a tuple that has
+  not been seen is stored. operator[] returns the tuple of an id in constant time.
+  @note With Concurrent, intern, find and operator[] may be called from several threads at once: lookups
+  share a reader lock on the index, insertions take it exclusively, and operator[] takes no lock. An id may
+  only be passed to operator[] on a thread that got it from the interner or from a thread that did.
+  @remarks Ids are never reused; the interner holds at most 2^32 - 1 tuples.
+*/
+template <bool Concurrent, typename... Types>
+class basic_tuple_interner {
+  static_assert((impl::_hashable<Types> && ...), "interned element types must be hashable with std::hash");
+  static_assert((std::equality_comparable<Types> && ...), "interned element types must be equality comparable");
+
+  struct _none {};
+  using _mutex_type = std::conditional_t<Concurrent, std::shared_mutex, _none>;
+
+  public:
+  using id_type = std::uint32_t;
+  using tuple_type = tuple<Types...>;
+
+  basic_tuple_interner(): _index(_initial_index, 0) {}
+
+  basic_tuple_interner(const basic_tuple_interner&) = delete;
+  basic_tuple_interner& operator=(const basic_tuple_interner&) = delete;
+
+  /**
+    @returns The id of (vs...), storing the tuple first if it has not been interned.
+    @throws std::length_error if the interner already holds 2^32 - 1 tuples.
+  */
+  id_type intern(const Types&... vs) {
+    const auto fwd = minpp::forward_as_tuple(vs...);
+    const std::uint64_t h = _hash(fwd);
+    if constexpr (Concurrent) {
+      {
+        std::shared_lock lk{_mutex};
+        if (const auto id = _find(h, fwd)) return *id;
+      }
+      std::unique_lock lk{_mutex};
+      return _intern(h, fwd);
+    }
+    else return _intern(h, fwd);
+  }
+
+  id_type intern(const tuple_type& t) {
+    return minpp::apply([this](const Types&... vs) { return intern(vs...); }, t);
+  }
+
+  /**
+    @fn template<class InputIt, class OutputIt> OutputIt intern_all(InputIt first, InputIt last, OutputIt out);
+    @brief Batch intern: writes the id of every tuple-like element of [first, last) to out, in order.
+    All the hashes are computed before the index is probed, and the probes run ahead of the comparisons, so
+    the cache misses on the index overlap. With Concurrent, the batch takes the index lock twice, shared to
+    look up and exclusive to insert what it did not find, rather than once per tuple.
+    @returns out past the last id written.
+  */
+  template <std::input_iterator InputIt, std::output_iterator<id_type> OutputIt>
+  OutputIt intern_all(InputIt first, InputIt last, OutputIt out) {
+    std::vector<std::iter_value_t<InputIt>> held;
+    std::vector<std::uint64_t> hashes;
+    std::vector<id_type> ids;
+    if constexpr (std::forward_iterator<InputIt>) {
+      const auto n = static_cast<std::size_t>(std::distance(first, last));
+      hashes.reserve(n);
+      ids.reserve(n);
+      for (InputIt it = first; it != last; ++it) hashes.push_back(_hash(_forward(*it)));
+      _intern_batch(first, hashes, ids);
+    }
+    else {
+      for (; first != last; ++first) held.push_back(*first);
+      hashes.reserve(held.size());
+      for (const auto& e: held) hashes.push_back(_hash(_forward(e)));
+      _intern_batch(held.begin(), hashes, ids);
+    }
+    return std::copy(ids.begin(), ids.end(), out);
+  }
+
+  /**
+    @returns The id of (vs...) if it has been interned, without storing it.
+  */
+  std::optional<id_type> find(const Types&... vs) const {
+    const auto fwd = minpp::forward_as_tuple(vs...);
+    const std::uint64_t h = _hash(fwd);
+    if constexpr (Concurrent) {
+      std::shared_lock lk{_mutex};
+      return _find(h, fwd);
+    }
+    else return _find(h, fwd);
+  }
+
+  std::optional<id_type> find(const tuple_type& t) const {
+    return minpp::apply([this](const Types&... vs) { return find(vs...); }, t);
+  }
+
+  /**
+    @returns The tuple interned as id. The reference stays valid as long as the interner.
+    @note id must have been returned by this interner.
+  */
+  MINPP_ALWAYS_INLINE const tuple_type& operator[](id_type id) const noexcept {
+    return _tuples[id];
+  }
+
+  /**
+    @throws std::out_of_range if id has not been returned by this interner.
+  */
+  const tuple_type& at(id_type id) const {
+    if (id >= size()) throw std::out_of_range("minpp::tuple_interner::at: unknown id");
+    return _tuples[id];
+  }
+
+  /**
+    @returns The number of distinct tuples interned, which is also the next id.
+  */
+  std::size_t size() const noexcept {
+    if constexpr (Concurrent) return _size.load(std::memory_order_acquire);
+    else return _tuples.size();
+  }
+
+  /**
+    @returns The bytes of string characters copied into the interner.
+  */
+  std::size_t string_bytes() const {
+    if constexpr (Concurrent) {
+      std::shared_lock lk{_mutex};
+      return _strings.bytes();
+    }
+    else return _strings.bytes();
+  }
+
+  private:
+  static constexpr std::size_t _initial_index = 64;
+  static constexpr std::uint64_t _empty = 0;
+  static constexpr std::size_t _lookahead = 8;
+
+  /*
+  An index slot is the high 32 bits of the hash above id + 1, so that a probe rejects most other tuples
+  without touching them, and the index can grow without rehashing the tuples. The slot of a hash is its
+  high bits masked, since those are the bits stored.
+  */
+  static std::uint64_t _slot(std::uint64_t h, id_type id) noexcept {
+    return (h & ~std::uint64_t{0xffffffff}) | (std::uint64_t{id} + 1);
+  }
+
+  static std::size_t _home(std::uint64_t h) noexcept {
+    return static_cast<std::size_t>(h >> 32);
+  }
+
+  template <typename Fwd>
+  static std::uint64_t _hash(const Fwd& fwd) {
+    return impl::_hash_mix(impl::_hash_elements(fwd, std::index_sequence_for<Types...>{}));
+  }
+
+  // the elements of a tuple-like e, by reference where they are Types and converted to Types where not
+  template <typename E>
+  static auto _forward(const E& e) {
+    return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      using std::get;
+      return tuple<std::conditional_t<std::is_same_v<std::remove_cvref_t<decltype(get<Is>(e))>, Types>, const Types&, Types>...>(get<Is>(e)...);
+    }(std::index_sequence_for<Types...>{});
+  }
+
+  template <typename Fwd>
+  std::optional<id_type> _find(std::uint64_t h, const Fwd& fwd) const noexcept {
+    const std::size_t mask = _index.size() - 1;
+    const std::uint64_t tag = h & ~std::uint64_t{0xffffffff};
+    for (std::size_t i = _home(h) & mask; _index[i] != _empty; i = (i + 1) & mask) {
+      const std::uint64_t s = _index[i];
+      if ((s & ~std::uint64_t{0xffffffff}) == tag) {
+        const id_type id = static_cast<id_type>(s - tag - 1);
+        if (_tuples[id] == fwd) return id;
+      }
+    }
+    return std::nullopt;
+  }
+
+  template <typename Fwd>
+  id_type _intern(std::uint64_t h, const Fwd& fwd) {
+    if (const auto id = _find(h, fwd)) return *id;
+    return _insert(h, fwd);
+  }
+
+  template <typename Fwd>
+  id_type _insert(std::uint64_t h, const Fwd& fwd) {
+    const std::size_t n = _tuples.size();
+    if (n == 0xffffffff) throw std::length_error("minpp::tuple_interner: more than 2^32 - 1 tuples");
+    if (2 * (n + 1) > _index.size()) _grow();
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      _tuples.emplace_back(_own(get<Is>(fwd))...);
+    }(std::index_sequence_for<Types...>{});
+    const id_type id = static_cast<id_type>(n);
+    _place(_slot(h, id));
+    if constexpr (Concurrent) _size.store(n + 1, std::memory_order_release);
+    return id;
+  }
+
+  template <typename T>
+  decltype(auto) _own(const T& v) {
+    if constexpr (impl::_is_string_view<T>) return T(_strings.store(v.data(), v.size()), v.size());
+    else return v;
+  }
+
+  void _place(std::uint64_t s) noexcept {
+    const std::size_t mask = _index.size() - 1;
+    std::size_t i = _home(s) & mask;
+    while (_index[i] != _empty) i = (i + 1) & mask;
+    _index[i] = s;
+  }
+
+  void _grow() {
+    std::vector<std::uint64_t> old(2 * _index.size(), _empty);
+    _index.swap(old);
+    for (std::uint64_t s: old) {
+      if (s != _empty) _place(s);
+    }
+  }
+
+  template <typename It>
+  void _intern_batch(It first, const std::vector<std::uint64_t>& hashes, std::vector<id_type>& ids) {
+    ids.resize(hashes.size());
+    if constexpr (Concurrent) {
+      std::vector<std::size_t> missed;
+      {
+        std::shared_lock lk{_mutex};
+        It it = first;
+        for (std::size_t i = 0; i < hashes.size(); ++i, ++it) {
+          if (i + _lookahead < hashes.size()) _prefetch(hashes[i + _lookahead]);
+          if (const auto id = _find(hashes[i], _forward(*it))) ids[i] = *id;
+          else missed.push_back(i);
+        }
+      }
+      if (missed.empty()) return;
+      std::unique_lock lk{_mutex};
+      It it = first;
+      std::size_t at = 0;
+      for (std::size_t i: missed) {
+        std::advance(it, i - at);
+        at = i;
+        ids[i] = _intern(hashes[i], _forward(*it));
+      }
+    }
+    else {
+      It it = first;
+      for (std::size_t i = 0; i < hashes.size(); ++i, ++it) {
+        if (i + _lookahead < hashes.size()) _prefetch(hashes[i + _lookahead]);
+        ids[i] = _intern(hashes[i], _forward(*it));
+      }
+    }
+  }
+
+  void _prefetch([[maybe_unused]] std::uint64_t h) const noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(_index.data() + (_home(h) & (_index.size() - 1)));
+#endif
+  }
+
+  std::vector<std::uint64_t> _index;
+  impl::_segmented_store<tuple_type, Concurrent> _tuples;
+  impl::_char_arena _strings;
+  [[no_unique_address]] mutable _mutex_type _mutex;
+  [[no_unique_address]] std::conditional_t<Concurrent, std::atomic<std::size_t>, _none> _size{};
+};
+
+template <typename... Types>
+using tuple_interner = basic_tuple_interner<false, Types...>;
+
+template <typename... Types>
+using concurrent_tuple_interner = basic_tuple_interner<true, Types...>;
+
+MINPP_NAMESPACE_END
+
+#endif
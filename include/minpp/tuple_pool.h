@@ -0,0 +1,184 @@
+#ifndef MINPP_TUPLE_POOL_H_
+#define MINPP_TUPLE_POOL_H_
+#include "minpp/_minpp_macros.h"
+#include "minpp/tuple.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+MINPP_IMPL_BEGIN
+
+/*
+A free slot of a pool. While a slot is in use the same storage holds the row. The first slot of a batch in
+the global list links to the next batch.
+*/
+struct _pool_node {
+  _pool_node* next;
+  _pool_node* next_batch;
+};
+
+/*
+A singly linked run of free slots that moves between a local cache and the global list as a unit.
+*/
+struct _pool_batch {
+  _pool_node* head = nullptr;
+  std::size_t count = 0;
+};
+
+MINPP_IMPL_END
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @brief Slab allocator for tuple<Types...> rows.
+  Rows are carved from slabs aligned to MINPP_CACHELINE_SIZE. Threads allocate and free through a
+  local_cache, which keeps a private free list that is used without synchronization; surplus rows go back to
+  the pool's global list in batches, and an empty cache refills with a whole batch, so the global lock is
+  taken once per batch_size rows at most.
+  @note The pool must outlive its caches and rows. Destroying the pool releases the slabs without destroying
+  rows that are still in use.
+*/
+template <typename... Types>
+class tuple_pool {
+  public:
+  using value_type = tuple<Types...>;
+
+  static constexpr std::size_t slot_align = std::max(alignof(value_type), alignof(impl::_pool_node));
+  static constexpr std::size_t slot_size = (std::max(sizeof(value_type), sizeof(impl::_pool_node)) + slot_align - 1) / slot_align * slot_align;
+
+  explicit tuple_pool(std::size_t rows_per_slab = 256, std::size_t batch_size = 64)
+  : _rows_per_slab{std::max<std::size_t>(rows_per_slab, 1)}, _batch_size{std::max<std::size_t>(batch_size, 1)} {}
+
+  tuple_pool(const tuple_pool&) = delete;
+  tuple_pool& operator=(const tuple_pool&) = delete;
+
+  ~tuple_pool() {
+    for (void* slab: _slabs) ::operator delete(slab, std::align_val_t{_slab_align});
+  }
+
+  std::size_t batch_size() const noexcept { return _batch_size; }
+
+  std::size_t slab_count() const {
+    std::lock_guard lk{_mutex};
+    return _slabs.size();
+  }
+
+  /**
+    @brief Per-thread front end of a tuple_pool. A cache is used by one thread at a time; rows may be
+    destroyed through any cache of the same pool.
+  */
+  class local_cache {
+    public:
+    explicit local_cache(tuple_pool& pool) noexcept: _pool{&pool} {}
+
+    local_cache(const local_cache&) = delete;
+    local_cache& operator=(const local_cache&) = delete;
+
+    ~local_cache() { flush(); }
+
+    /**
+      @returns A row constructed as value_type(std::forward<Args>(args)...).
+    */
+    template <typename... Args>
+    value_type* emplace(Args&&... args) {
+      if (!_free.head) _pool->_refill(_free);
+      impl::_pool_node* n = _free.head;
+      _free.head = n->next;
+      --_free.count;
+      try {
+        return ::new (static_cast<void*>(n)) value_type(std::forward<Args>(args)...);
+      }
+      catch (...) {
+        _push(n);
+        throw;
+      }
+    }
+
+    /**
+      @brief Destroys a row obtained from any cache of the same pool and keeps its slot for reuse.
+    */
+    void destroy(value_type* p) noexcept {
+      p->~value_type();
+      _push(::new (static_cast<void*>(p)) impl::_pool_node{nullptr, nullptr});
+      if (_free.count >= 2 * _pool->_batch_size) _pool->_give(_split());
+    }
+
+    /**
+      @brief Returns every cached slot to the pool.
+    */
+    void flush() noexcept {
+      if (_free.head) _pool->_give(std::exchange(_free, {}));
+    }
+
+    private:
+    void _push(impl::_pool_node* n) noexcept {
+      n->next = _free.head;
+      _free.head = n;
+      ++_free.count;
+    }
+
+    impl::_pool_batch _split() noexcept {
+      impl::_pool_batch b{_free.head, _pool->_batch_size};
+      impl::_pool_node* last = _free.head;
+      for (std::size_t i = 1; i < b.count; ++i) last = last->next;
+      _free.head = last->next;
+      _free.count -= b.count;
+      last->next = nullptr;
+      return b;
+    }
+
+    tuple_pool* _pool;
+    impl::_pool_batch _free;
+  };
+
+  private:
+  static constexpr std::size_t _slab_align = std::max<std::size_t>(MINPP_CACHELINE_SIZE, slot_align);
+
+  void _give(impl::_pool_batch b) noexcept {
+    std::lock_guard lk{_mutex};
+    b.head->next_batch = _batches;
+    _batches = b.head;
+  }
+
+  void _refill(impl::_pool_batch& out) {
+    impl::_pool_node* head = nullptr;
+    {
+      std::lock_guard lk{_mutex};
+      if (_batches) {
+        head = _batches;
+        _batches = head->next_batch;
+      }
+    }
+    if (head) {
+      out = {head, 0};
+      for (impl::_pool_node* n = head; n; n = n->next) ++out.count;
+      return;
+    }
+
+    auto* slab = static_cast<std::byte*>(::operator new(_rows_per_slab * slot_size, std::align_val_t{_slab_align}));
+    try {
+      std::lock_guard lk{_mutex};
+      _slabs.push_back(slab);
+    }
+    catch (...) {
+      ::operator delete(slab, std::align_val_t{_slab_align});
+      throw;
+    }
+    for (std::size_t i = _rows_per_slab; i-- > 0;) head = ::new (static_cast<void*>(slab + i * slot_size)) impl::_pool_node{head, nullptr};
+    out = {head, _rows_per_slab};
+  }
+
+  std::size_t _rows_per_slab;
+  std::size_t _batch_size;
+  mutable std::mutex _mutex;
+  impl::_pool_node* _batches = nullptr;
+  std::vector<void*> _slabs;
+};
+
+MINPP_NAMESPACE_END
+
+#endif
@@ -0,0 +1,269 @@
+#ifndef MINPP_TUPLE_RING_H_
+#define MINPP_TUPLE_RING_H_
+#include "minpp/_minpp_macros.h"
+#include "minpp/tuple.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+MINPP_IMPL_BEGIN
+
+/*
+A ring slot takes whole cache lines, so a producer filling one slot never invalidates the line a consumer is
+reading from the neighbouring one. MPMC slots carry the sequence number of the position they are ready for.
+*/
+template <typename T, bool Sequenced>
+struct alignas(MINPP_CACHELINE_SIZE) _ring_slot {
+  alignas(T) unsigned char storage[sizeof(T)];
+
+  T* get() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+};
+
+template <typename T>
+struct alignas(MINPP_CACHELINE_SIZE) _ring_slot<T, true> {
+  std::atomic<std::size_t> seq;
+  alignas(T) unsigned char storage[sizeof(T)];
+
+  T* get() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+};
+
+inline std::size_t _ring_capacity(std::size_t requested) noexcept {
+  return std::bit_ceil(std::max<std::size_t>(requested, 2));
+}
+
+MINPP_IMPL_END
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @brief Bounded single-producer single-consumer queue of tuple<Types...> messages.
+  Messages are constructed directly in their slot by try_emplace and consumed in place by try_pop_n, so a
+  message is never moved on its way through the ring. The producer and consumer indices live on separate
+  cache lines, and each side caches the other's index so it only reads the shared one when the ring looks
+  full or empty.
+  @note One thread may push and one thread may pop at a time. The capacity is rounded up to a power of two.
+*/
+template <typename... Types>
+class spsc_tuple_ring {
+  using slot = impl::_ring_slot<tuple<Types...>, false>;
+
+  public:
+  using value_type = tuple<Types...>;
+
+  explicit spsc_tuple_ring(std::size_t capacity)
+  : _mask{impl::_ring_capacity(capacity) - 1}, _slots{std::make_unique<slot[]>(_mask + 1)} {}
+
+  spsc_tuple_ring(const spsc_tuple_ring&) = delete;
+  spsc_tuple_ring& operator=(const spsc_tuple_ring&) = delete;
+
+  ~spsc_tuple_ring() {
+    const std::size_t tail = _tail.load(std::memory_order_acquire);
+    for (std::size_t pos = _head.load(std::memory_order_relaxed); pos != tail; ++pos) _slots[pos & _mask].get()->~value_type();
+  }
+
+  std::size_t capacity() const noexcept { return _mask + 1; }
+
+  /**
+    @brief Constructs value_type(std::forward<Args>(args)...) in the next free slot.
+    @returns false, without constructing anything, if the ring is full.
+  */
+  template <typename... Args>
+  bool try_emplace(Args&&... args) {
+    const std::size_t tail = _tail.load(std::memory_order_relaxed);
+    if (tail - _head_cache > _mask) {
+      _head_cache = _head.load(std::memory_order_acquire);
+      if (tail - _head_cache > _mask) return false;
+    }
+    ::new (static_cast<void*>(_slots[tail & _mask].storage)) value_type(std::forward<Args>(args)...);
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+    @brief Pops up to n messages, calling apply(fn, std::move(message)) on each in its slot.
+    The consumer index is published once for the whole batch.
+    @returns The number of messages popped.
+    @note If fn throws, the message it was called with is destroyed and counts as popped.
+  */
+  template <typename F>
+  std::size_t try_pop_n(std::size_t n, F&& fn) {
+    const std::size_t head = _head.load(std::memory_order_relaxed);
+    if (_tail_cache - head < n) _tail_cache = _tail.load(std::memory_order_acquire);
+    const std::size_t count = std::min(n, _tail_cache - head);
+    std::size_t i = 0;
+    try {
+      for (; i < count; ++i) {
+        value_type* v = _slots[(head + i) & _mask].get();
+        minpp::apply(fn, std::move(*v));
+        v->~value_type();
+      }
+    }
+    catch (...) {
+      _slots[(head + i) & _mask].get()->~value_type();
+      _head.store(head + i + 1, std::memory_order_release);
+      throw;
+    }
+    if (count) _head.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+  private:
+  std::size_t _mask;
+  std::unique_ptr<slot[]> _slots;
+
+  alignas(MINPP_CACHELINE_SIZE) std::atomic<std::size_t> _tail{0};
+  std::size_t _head_cache = 0;
+
+  alignas(MINPP_CACHELINE_SIZE) std::atomic<std::size_t> _head{0};
+  std::size_t _tail_cache = 0;
+};
+
+/**
+  @brief Bounded multi-producer multi-consumer queue of tuple<Types...> messages.
+  Every slot carries a sequence number telling which position it is ready for (Vyukov's bounded queue);
+  producers and consumers claim positions with a compare-exchange on their index and hand slots over through
+  the sequence numbers. try_pop_n claims a run of ready slots with a single compare-exchange.
+  @note The capacity is rounded up to a power of two. When value_type(args...) may throw, try_emplace builds
+  the message before claiming a slot and moves it in, since a claimed slot cannot be given back; producers
+  that retry should then build the message themselves and pass it to try_push.
+*/
+template <typename... Types>
+class mpmc_tuple_ring {
+  using slot = impl::_ring_slot<tuple<Types...>, true>;
+
+  public:
+  using value_type = tuple<Types...>;
+
+  explicit mpmc_tuple_ring(std::size_t capacity)
+  : _mask{impl::_ring_capacity(capacity) - 1}, _slots{std::make_unique<slot[]>(_mask + 1)} {
+    for (std::size_t i = 0; i <= _mask; ++i) _slots[i].seq.store(i, std::memory_order_relaxed);
+  }
+
+  mpmc_tuple_ring(const mpmc_tuple_ring&) = delete;
+  mpmc_tuple_ring& operator=(const mpmc_tuple_ring&) = delete;
+
+  ~mpmc_tuple_ring() {
+    const std::size_t tail = _tail.load(std::memory_order_acquire);
+    for (std::size_t pos = _head.load(std::memory_order_relaxed); pos != tail; ++pos) {
+      slot& s = _slots[pos & _mask];
+      if (s.seq.load(std::memory_order_acquire) == pos + 1) s.get()->~value_type();
+    }
+  }
+
+  std::size_t capacity() const noexcept { return _mask + 1; }
+
+  /**
+    @brief Moves v into the next free slot.
+    @returns false, leaving v untouched, if the ring is full.
+  */
+  bool try_push(value_type&& v) noexcept requires std::is_nothrow_move_constructible_v<value_type> {
+    std::size_t pos;
+    slot* s = _claim_push(pos);
+    if (!s) return false;
+    ::new (static_cast<void*>(s->storage)) value_type(std::move(v));
+    s->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+    @brief Constructs value_type(std::forward<Args>(args)...) in the next free slot.
+    @returns false if the ring is full. When value_type(args...) may throw, the message is built before a
+    slot is claimed, so rvalue args may have been moved from even though false is returned; try_push keeps
+    the message on failure.
+  */
+  template <typename... Args>
+  bool try_emplace(Args&&... args) {
+    if constexpr (std::is_nothrow_constructible_v<value_type, Args&&...>) {
+      std::size_t pos;
+      slot* s = _claim_push(pos);
+      if (!s) return false;
+      ::new (static_cast<void*>(s->storage)) value_type(std::forward<Args>(args)...);
+      s->seq.store(pos + 1, std::memory_order_release);
+      return true;
+    }
+    else {
+      static_assert(std::is_nothrow_move_constructible_v<value_type>,
+        "mpmc_tuple_ring requires a non-throwing constructor for these arguments or a non-throwing move");
+      if (_full()) return false;
+      // another producer may take the last slot meanwhile, after args were consumed
+      return try_push(value_type(std::forward<Args>(args)...));
+    }
+  }
+
+  /**
+    @brief Pops up to n messages, calling apply(fn, std::move(message)) on each in its slot.
+    @returns The number of messages popped.
+    @note If fn throws, the message it was called with and the rest of the claimed batch are destroyed
+    without being processed.
+  */
+  template <typename F>
+  std::size_t try_pop_n(std::size_t n, F&& fn) {
+    std::size_t pos = _head.load(std::memory_order_relaxed);
+    std::size_t count;
+    while (true) {
+      count = 0;
+      while (count < n && _slots[(pos + count) & _mask].seq.load(std::memory_order_acquire) == pos + count + 1) ++count;
+      if (count == 0) {
+        const std::size_t seq = _slots[pos & _mask].seq.load(std::memory_order_acquire);
+        if (static_cast<std::ptrdiff_t>(seq - (pos + 1)) < 0) return 0;
+        pos = _head.load(std::memory_order_relaxed);
+      }
+      else if (_head.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) break;
+    }
+
+    std::size_t i = 0;
+    try {
+      for (; i < count; ++i) {
+        slot& s = _slots[(pos + i) & _mask];
+        minpp::apply(fn, std::move(*s.get()));
+        _release(s, pos + i);
+      }
+    }
+    catch (...) {
+      for (; i < count; ++i) _release(_slots[(pos + i) & _mask], pos + i);
+      throw;
+    }
+    return count;
+  }
+
+  private:
+  slot* _claim_push(std::size_t& pos) noexcept {
+    pos = _tail.load(std::memory_order_relaxed);
+    while (true) {
+      slot& s = _slots[pos & _mask];
+      const auto diff = static_cast<std::ptrdiff_t>(s.seq.load(std::memory_order_acquire) - pos);
+      if (diff == 0) {
+        if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) return &s;
+      }
+      else if (diff < 0) return nullptr;
+      else pos = _tail.load(std::memory_order_relaxed);
+    }
+  }
+
+  bool _full() const noexcept {
+    const std::size_t pos = _tail.load(std::memory_order_relaxed);
+    return static_cast<std::ptrdiff_t>(_slots[pos & _mask].seq.load(std::memory_order_acquire) - pos) < 0;
+  }
+
+  void _release(slot& s, std::size_t pos) noexcept {
+    s.get()->~value_type();
+    s.seq.store(pos + _mask + 1, std::memory_order_release);
+  }
+
+  std::size_t _mask;
+  std::unique_ptr<slot[]> _slots;
+
+  alignas(MINPP_CACHELINE_SIZE) std::atomic<std::size_t> _tail{0};
+  alignas(MINPP_CACHELINE_SIZE) std::atomic<std::size_t> _head{0};
+};
+
+MINPP_NAMESPACE_END
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef MINPP_VISIT_H_
+#define MINPP_VISIT_H_
+#include "minpp/_minpp_macros.h"
+#include "minpp/tuple.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+MINPP_IMPL_BEGIN
+
+// tuples up to this size dispatch through a folded chain of comparisons, which g++ lowers to a jump table with the
+// visitor inlined; it beat the function-pointer table at 4, 16 and 64 elements (times/benchmark_visit.cpp)
+inline constexpr std::size_t _visit_at_chain_limit = 64;
+
+template <std::size_t I, typename F, typename... Tuples>
+using _visit_at_invoke_t = std::invoke_result_t<F, decltype(get<I>(std::declval<Tuples>()))...>;
+
+template <typename F, typename Tuple, typename... Tuples>
+struct _visit_at_result {
+  template <std::size_t... Is>
+  static auto _deduce(std::index_sequence<Is...>) {
+    using R = _visit_at_invoke_t<0, F, Tuple, Tuples...>;
+    static_assert((std::is_same_v<R, _visit_at_invoke_t<Is, F, Tuple, Tuples...>> && ...),
+      "visit_at requires the visitor to return the same type for every element");
+    return std::type_identity<R>{};
+  }
+
+  using type = typename decltype(_deduce(std::make_index_sequence<std::tuple_size_v<std::remove_cvref_t<Tuple>>>{}))::type;
+};
+
+template <typename F, typename... Tuples>
+using _visit_at_result_t = typename _visit_at_result<F, Tuples...>::type;
+
+[[noreturn]] inline void _visit_at_out_of_range() {
+  throw std::out_of_range("minpp::visit_at: index out of range");
+}
+
+template <std::size_t I, typename R, typename F, typename... Tuples>
+constexpr R _visit_at_thunk(F&& f, Tuples&&... ts) {
+  return std::invoke(std::forward<F>(f), get<I>(std::forward<Tuples>(ts))...);
+}
+
+template <typename R, typename F, typename... Tuples, std::size_t... Is>
+constexpr R _visit_at_table(std::size_t i, std::index_sequence<Is...>, F&& f, Tuples&&... ts) {
+  constexpr R (*table[])(F&&, Tuples&&...) = {&_visit_at_thunk<Is, R, F, Tuples...>...};
+  return table[i](std::forward<F>(f), std::forward<Tuples>(ts)...);
+}
+
+/*
+Converts to R by invoking the visitor, so that a result can be emplaced into storage without a move.
+*/
+template <std::size_t I, typename R, typename F, typename... Tuples>
+struct _visit_at_deferred {
+  F&& f;
+  std::tuple<Tuples&&...> ts;
+
+  constexpr operator R() && {
+    return std::apply([this](auto&&... t) -> R {
+      return _visit_at_thunk<I, R>(std::forward<F>(f), std::forward<decltype(t)>(t)...);
+    }, std::move(ts));
+  }
+};
+
+template <typename R, typename F, typename... Tuples, std::size_t... Is>
+constexpr R _visit_at_chain(std::size_t i, std::index_sequence<Is...>, F&& f, Tuples&&... ts) {
+  if constexpr (std::is_void_v<R>) {
+    ((i == Is ? (_visit_at_thunk<Is, R>(std::forward<F>(f), std::forward<Tuples>(ts)...), true) : false) || ...);
+  }
+  else if constexpr (std::is_reference_v<R>) {
+    std::remove_reference_t<R>* r = nullptr;
+    ((i == Is ? (r = std::addressof(_visit_at_thunk<Is, R>(std::forward<F>(f), std::forward<Tuples>(ts)...)), true) : false) || ...);
+    return static_cast<R>(*r);
+  }
+  else {
+    std::optional<R> r;
+    ((i == Is ? (r.emplace(_visit_at_deferred<Is, R, F, Tuples...>{std::forward<F>(f), {std::forward<Tuples>(ts)...}}), true) : false) || ...);
+    return std::move(*r);
+  }
+}
+
+template <typename F, typename Tuple, typename... Tuples>
+constexpr decltype(auto) _visit_at(std::size_t i, F&& f, Tuple&& t, Tuples&&... ts) {
+  constexpr std::size_t N = std::tuple_size_v<std::remove_cvref_t<Tuple>>;
+  static_assert(((std::tuple_size_v<std::remove_cvref_t<Tuples>> == N) && ...), "visit_at requires tuples of the same size");
+  if (i >= N) _visit_at_out_of_range();
+  if constexpr (N > 0) {
+    using R = _visit_at_result_t<F, Tuple, Tuples...>;
+    if constexpr (N <= _visit_at_chain_limit) return _visit_at_chain<R>(i, std::make_index_sequence<N>{}, std::forward<F>(f), std::forward<Tuple>(t), std::forward<Tuples>(ts)...);
+    else return _visit_at_table<R>(i, std::make_index_sequence<N>{}, std::forward<F>(f), std::forward<Tuple>(t), std::forward<Tuples>(ts)...);
+  }
+}
+
+MINPP_IMPL_END
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @fn template<class Tuple, class F>
+  constexpr decltype(auto) visit_at(Tuple&& t, size_t i, F&& f);
+  @returns invoke(std::forward<F>(f), get<i>(std::forward<Tuple>(t))) for the runtime index i.
+  @pre invoking f returns the same type for every element of t.
+  @throws std::out_of_range if i >= tuple_size_v<Tuple>.
+  @note Tuples of up to 64 elements dispatch through a chain of comparisons folded over the indices, which the
+  compiler lowers to a switch; larger ones through a constexpr table of function pointers. Either way the
+  cost does not grow with the index.
+*/
+template <typename Tuple, typename F>
+constexpr decltype(auto) visit_at(Tuple&& t, std::size_t i, F&& f) {
+  return impl::_visit_at(i, std::forward<F>(f), std::forward<Tuple>(t));
+}
+
+/**
+  @fn template<class Tuple1, class Tuple2, class F>
+  constexpr decltype(auto) visit_at(Tuple1&& t1, Tuple2&& t2, size_t i, F&& f);
+  @returns invoke(std::forward<F>(f), get<i>(std::forward<Tuple1>(t1)), get<i>(std::forward<Tuple2>(t2))).
+  @pre t1 and t2 have the same size.
+  @throws std::out_of_range if i is not less than that size.
+*/
+template <typename Tuple1, typename Tuple2, typename F>
+constexpr decltype(auto) visit_at(Tuple1&& t1, Tuple2&& t2, std::size_t i, F&& f) {
+  return impl::_visit_at(i, std::forward<F>(f), std::forward<Tuple1>(t1), std::forward<Tuple2>(t2));
+}
+
+MINPP_NAMESPACE_END
+
+#endif
@@ -0,0 +1,235 @@
+#ifndef MINPP_WHEN_ALL_H_
+#define MINPP_WHEN_ALL_H_
+#include "minpp/_minpp_macros.h"
+#include "minpp/thread_pool.h"
+#include "minpp/tuple.h"
+
+#include <array>
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+MINPP_IMPL_BEGIN
+
+template <typename R>
+struct _when_all_result {
+  using type = R;
+};
+
+template <>
+struct _when_all_result<void> {
+  using type = std::monostate;
+};
+
+template <typename F>
+using _when_all_result_t = typename _when_all_result<std::invoke_result_t<F&>>::type;
+
+/*
+Holds the result (or the exception) of one callable until the result tuple is built.
+*/
+template <typename R>
+struct _when_all_slot {
+  union { R value; };
+  bool engaged = false;
+  std::exception_ptr error;
+
+  _when_all_slot() noexcept {}
+  _when_all_slot(const _when_all_slot&) = delete;
+  ~_when_all_slot() { if (engaged) value.~R(); }
+
+  template <typename F>
+  void fill(F& f) {
+    if constexpr (std::is_void_v<std::invoke_result_t<F&>>) {
+      std::invoke(f);
+      ::new (static_cast<void*>(std::addressof(value))) R{};
+    }
+    else ::new (static_cast<void*>(std::addressof(value))) R(std::invoke(f));
+    engaged = true;
+  }
+
+  R&& take() noexcept { return std::move(value); }
+};
+
+template <typename R>
+struct _when_all_slot<R&> {
+  R* value = nullptr;
+  std::exception_ptr error;
+
+  template <typename F>
+  void fill(F& f) { value = std::addressof(std::invoke(f)); }
+
+  R& take() noexcept { return *value; }
+};
+
+template <typename... Fs>
+struct _when_all_state {
+  using result_type = tuple<_when_all_result_t<Fs>...>;
+
+  struct node: _pool_task {
+    _when_all_state* state;
+  };
+
+  template <typename... UFs>
+  explicit _when_all_state(UFs&&... fs): fns{std::forward<UFs>(fs)...} {}
+
+  _when_all_state(const _when_all_state&) = delete;
+
+  template <std::size_t I>
+  static void _run(_pool_task* t) noexcept {
+    _when_all_state* self = static_cast<node*>(t)->state;
+    self->template _execute<I>();
+    self->_finish();
+  }
+
+  template <std::size_t I>
+  void _execute() noexcept {
+    auto& slot = std::get<I>(slots);
+    try {
+      slot.fill(get<I>(fns));
+    }
+    catch (...) {
+      slot.error = std::current_exception();
+    }
+  }
+
+  void _finish() noexcept {
+    if (!batch.arrive()) return;
+    if (continuation) {
+      continuation.resume();
+      return;
+    }
+    batch.release();
+  }
+
+  template <std::size_t... Is>
+  void _submit(thread_pool& pool, std::size_t first, std::index_sequence<Is...>) noexcept {
+    ((nodes[Is].run = &_run<Is>, nodes[Is].state = this), ...);
+    pool._submit_all(nodes.data(), first, sizeof...(Fs));
+  }
+
+  void _wait(thread_pool& pool) noexcept {
+    batch.wait(pool);
+  }
+
+  template <std::size_t... Is>
+  void _rethrow(std::index_sequence<Is...>) {
+    std::exception_ptr error;
+    ((error = error ? error : std::get<Is>(slots).error), ...);
+    if (error) std::rethrow_exception(error);
+  }
+
+  template <std::size_t... Is>
+  result_type _collect(std::index_sequence<Is...> seq) {
+    _rethrow(seq);
+    return result_type{std::get<Is>(slots).take()...};
+  }
+
+  template <typename Alloc, std::size_t... Is>
+  result_type _collect(const Alloc& a, std::index_sequence<Is...> seq) {
+    _rethrow(seq);
+    return result_type{std::allocator_arg_t{}, a, std::get<Is>(slots).take()...};
+  }
+
+  tuple<std::decay_t<Fs>...> fns;
+  std::tuple<_when_all_slot<_when_all_result_t<Fs>>...> slots;
+  std::array<node, sizeof...(Fs)> nodes;
+  _pool_completion batch{sizeof...(Fs)};
+  std::coroutine_handle<> continuation;
+};
+
+MINPP_IMPL_END
+
+MINPP_NAMESPACE_BEGIN
+
+/**
+  @fn template<class... Fs>
+  tuple<R...> when_all(thread_pool& pool, Fs&&... fs);
+  @returns A tuple holding the result of invoking each callable in fs, in order. A callable returning void
+  contributes a std::monostate.
+  @brief Invokes fs concurrently on pool and waits for all of them.
+  The calling thread runs the first callable itself and helps with queued work of pool while waiting, so it
+  is safe to call when_all from inside a task of the same pool.
+  @throws The exception of the lowest-indexed callable that threw, after every callable has finished.
+*/
+template <typename... Fs>
+tuple<impl::_when_all_result_t<Fs>...> when_all(thread_pool& pool, Fs&&... fs) {
+  if constexpr (sizeof...(Fs) == 0) return {};
+  else {
+    impl::_when_all_state<Fs...> state{std::forward<Fs>(fs)...};
+    state._submit(pool, 1, std::index_sequence_for<Fs...>{});
+    impl::_when_all_state<Fs...>::template _run<0>(&state.nodes[0]);
+    state._wait(pool);
+    return state._collect(std::index_sequence_for<Fs...>{});
+  }
+}
+
+/**
+  @fn template<class Alloc, class... Fs>
+  tuple<R...> when_all(allocator_arg_t, const Alloc& a, thread_pool& pool, Fs&&... fs);
+  @brief Equivalent to when_all(pool, fs...) except that the result tuple is constructed with uses-allocator
+  construction.
+*/
+template <typename Alloc, typename... Fs>
+tuple<impl::_when_all_result_t<Fs>...> when_all(std::allocator_arg_t, const Alloc& a, thread_pool& pool, Fs&&... fs) {
+  if constexpr (sizeof...(Fs) == 0) return {std::allocator_arg_t{}, a};
+  else {
+    impl::_when_all_state<Fs...> state{std::forward<Fs>(fs)...};
+    state._submit(pool, 1, std::index_sequence_for<Fs...>{});
+    impl::_when_all_state<Fs...>::template _run<0>(&state.nodes[0]);
+    state._wait(pool);
+    return state._collect(a, std::index_sequence_for<Fs...>{});
+  }
+}
+
+/**
+  @brief Awaitable returned by when_all_async.
+  Awaiting it submits every callable to the pool and resumes the awaiting coroutine on the worker that
+  finishes last (or inline, if everything finished before the coroutine could suspend).
+*/
+template <typename... Fs>
+class when_all_awaitable {
+  public:
+  template <typename... UFs>
+  explicit when_all_awaitable(thread_pool& pool, UFs&&... fs): _pool{pool}, _state{std::forward<UFs>(fs)...} {}
+
+  when_all_awaitable(const when_all_awaitable&) = delete;
+
+  bool await_ready() const noexcept { return sizeof...(Fs) == 0; }
+
+  bool await_suspend(std::coroutine_handle<> h) {
+    _state.continuation = h;
+    // one extra count held by await_suspend itself, so that a fast worker cannot resume h before we return
+    _state.batch.remaining.store(sizeof...(Fs) + 1, std::memory_order_relaxed);
+    _state._submit(_pool, 0, std::index_sequence_for<Fs...>{});
+    return !_state.batch.arrive();
+  }
+
+  tuple<impl::_when_all_result_t<Fs>...> await_resume() {
+    return _state._collect(std::index_sequence_for<Fs...>{});
+  }
+
+  private:
+  thread_pool& _pool;
+  impl::_when_all_state<Fs...> _state;
+};
+
+/**
+  @fn template<class... Fs>
+  when_all_awaitable<Fs...> when_all_async(thread_pool& pool, Fs&&... fs);
+  @brief Coroutine flavor of when_all: co_await when_all_async(pool, fs...) yields the same tuple.
+  @note The awaiting coroutine continues on a thread of pool.
+*/
+template <typename... Fs>
+when_all_awaitable<Fs...> when_all_async(thread_pool& pool, Fs&&... fs) {
+  return when_all_awaitable<Fs...>{pool, std::forward<Fs>(fs)...};
+}
+
+MINPP_NAMESPACE_END
+
+#endif
@@ -0,0 +1,187 @@
+/*
+Named module interface for minpp. The headers are included in the global module fragment, so `import minpp;`
+and `#include "minpp/..."` in the same program name the same entities, and the module only re-exports the
+public names. The std specializations (tuple_size, tuple_element, uses_allocator, hash) come with the headers
+and are reachable through the exported templates.
+
+Configuration macros such as MINPP_STD_COMPAT and MINPP_CACHELINE_SIZE take effect when the module is built,
+not when it is imported.
+
+Toolchains that cannot build or consume this interface can import the headers as header units instead
+(import "minpp/tuple.h";): every header is self-contained and only reads configuration macros that have
+defaults, so they have to be given as compile definitions rather than defined before the import.
+times/module_build_times.sh compares both against #include.
+*/
+module;
+
+#include "minpp/atomic_tuple.h"
+#include "minpp/column_codec.h"
+#include "minpp/cow_tuple.h"
+#include "minpp/dynamic_tuple.h"
+#include "minpp/elementwise.h"
+#include "minpp/format.h"
+#include "minpp/group_by.h"
+#include "minpp/lazy_tuple.h"
+#include "minpp/memoize.h"
+#include "minpp/pair.h"
+#include "minpp/parse_delimited.h"
+#include "minpp/projection.h"
+#include "minpp/sort_key.h"
+#include "minpp/split_tuple.h"
+#include "minpp/thread_pool.h"
+#include "minpp/tuple.h"
+#include "minpp/tuple_interner.h"
+#include "minpp/tuple_pool.h"
+#include "minpp/tuple_ring.h"
+#include "minpp/visit.h"
+#include "minpp/when_all.h"
+
+export module minpp;
+
+export namespace minpp {
+
+// tuple.h
+using minpp::tuple;
+using minpp::cacheline;
+using minpp::aligned_tuple;
+using minpp::enable_expand_type_with_template_args;
+using minpp::enable_expand_type_with_template_args_v;
+using minpp::make_tuple;
+using minpp::forward_as_tuple;
+using minpp::ignore;
+using minpp::tie;
+using minpp::tuple_cat;
+using minpp::apply;
+using minpp::make_from_tuple;
+using minpp::get;
+using minpp::swap;
+using minpp::operator==;
+using minpp::operator<=>;
+
+// common_meta.h and common_concepts.h
+using minpp::is_list_constructible;
+using minpp::is_list_constructible_v;
+using minpp::leading_allocator_constructible;
+using minpp::trailing_allocator_constructible;
+
+// elementwise.h
+namespace elementwise {
+using minpp::elementwise::expression;
+using minpp::elementwise::operator+;
+using minpp::elementwise::operator-;
+using minpp::elementwise::operator*;
+using minpp::elementwise::operator/;
+using minpp::elementwise::operator+=;
+using minpp::elementwise::operator-=;
+using minpp::elementwise::operator*=;
+using minpp::elementwise::operator/=;
+using minpp::elementwise::min;
+using minpp::elementwise::max;
+using minpp::elementwise::dot;
+using minpp::elementwise::eval;
+}
+
+// format.h
+using minpp::format_to;
+using minpp::write_rows;
+#if MINPP_FORMAT_HAS_FD
+using minpp::row_writer;
+#endif
+
+// lazy_tuple.h
+using minpp::deferred;
+using minpp::defer;
+using minpp::basic_lazy_tuple;
+using minpp::lazy_tuple;
+using minpp::concurrent_lazy_tuple;
+
+// pair.h
+using minpp::pair;
+
+// parse_delimited.h
+using minpp::delimited_rows;
+using minpp::parse_delimited;
+
+// projection.h
+using minpp::select_view;
+using minpp::select;
+using minpp::compare_by;
+using minpp::equal_by;
+using minpp::hash_by;
+
+// sort_key.h
+using minpp::descending_columns;
+using minpp::encode_sort_key;
+using minpp::decode_sort_key;
+using minpp::encode_sort_keys;
+
+// visit.h
+using minpp::visit_at;
+
+// memoize.h
+using minpp::memo_stats;
+using minpp::memoized;
+using minpp::memoize;
+
+// tuple_interner.h
+using minpp::basic_tuple_interner;
+using minpp::tuple_interner;
+using minpp::concurrent_tuple_interner;
+
+// column_codec.h
+using minpp::column_codec;
+namespace codec {
+using minpp::codec::raw;
+using minpp::codec::bit_packing;
+using minpp::codec::frame_of_reference;
+using minpp::codec::delta;
+using minpp::codec::run_length;
+using minpp::codec::dictionary;
+}
+
+// group_by.h
+using minpp::grouping;
+using minpp::group_by;
+namespace agg {
+using minpp::agg::count_t;
+using minpp::agg::sum_t;
+using minpp::agg::min_t;
+using minpp::agg::max_t;
+using minpp::agg::mean_t;
+using minpp::agg::count;
+using minpp::agg::sum;
+using minpp::agg::min;
+using minpp::agg::max;
+using minpp::agg::mean;
+}
+
+// cow_tuple.h
+using minpp::basic_cow_tuple;
+using minpp::cow_tuple;
+using minpp::concurrent_cow_tuple;
+
+// dynamic_tuple.h
+using minpp::column_type;
+using minpp::column_of;
+using minpp::tuple_layout;
+using minpp::dynamic_tuple;
+
+// tuple_pool.h, atomic_tuple.h and tuple_ring.h
+using minpp::tuple_pool;
+using minpp::atomic_tuple;
+using minpp::spsc_tuple_ring;
+using minpp::mpmc_tuple_ring;
+
+// split_tuple.h
+using minpp::hot;
+using minpp::cold;
+using minpp::hot_at;
+using minpp::split_tuple;
+
+// thread_pool.h and when_all.h
+using minpp::thread_pool;
+using minpp::when_all;
+using minpp::when_all_awaitable;
+using minpp::when_all_async;
+
+}
@@ -0,0 +1,89 @@
+#include "minpp/atomic_tuple.h"
+
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+template <typename Atomic>
+bool hammer(Atomic& a) {
+  // writers keep the invariant get<1> == 2 * get<0> and get<2> == get<0> + 7; readers must never see it broken
+  constexpr unsigned writes = 10000;
+  std::atomic<bool> torn = false;
+  std::atomic<bool> stop = false;
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 2; ++r) {
+    readers.emplace_back([&] {
+      while (!stop.load()) {
+        auto v = a.load();
+        const std::uint64_t first = minpp::get<0>(v);
+        if (minpp::get<1>(v) != 2 * first || minpp::get<2>(v) != first + 7) torn = true;
+      }
+    });
+  }
+  std::vector<std::thread> writers;
+  for (int w = 0; w < 2; ++w) {
+    writers.emplace_back([&] {
+      for (unsigned i = 0; i < writes; ++i) {
+        auto cur = a.load();
+        decltype(cur) next;
+        do {
+          next = cur;
+          minpp::get<0>(next) = minpp::get<0>(cur) + 1;
+          minpp::get<1>(next) = 2 * minpp::get<0>(next);
+          minpp::get<2>(next) = minpp::get<0>(next) + 7;
+        } while (!a.compare_exchange(cur, next));
+      }
+    });
+  }
+  for (auto& t: writers) t.join();
+  stop = true;
+  for (auto& t: readers) t.join();
+  return !torn && minpp::get<0>(a.load()) == 2 * writes;
+}
+
+int main() {
+  std::cout << std::boolalpha;
+
+  {
+    using small = minpp::atomic_tuple<std::uint16_t, std::uint16_t, std::uint32_t>;
+    static_assert(small::is_always_lock_free);
+    small a{{std::uint16_t{0}, std::uint16_t{0}, 7u}};
+    const bool ok = hammer(a);
+    std::cout << ok << std::endl;
+    if (!ok) return 1;
+  }
+
+  {
+    using state = minpp::atomic_tuple<std::uint32_t, std::uint32_t, std::uint64_t>;
+    std::cout << state::is_always_lock_free << std::endl;
+    state a{{0u, 0u, std::uint64_t{7}}};
+    if (!hammer(a)) return 1;
+
+    auto v = a.update<2>([](std::uint64_t x) { return x + 1; });
+    if (minpp::get<2>(v) != minpp::get<2>(a.load()) || minpp::get<2>(v) != minpp::get<0>(v) + 8) return 1;
+
+    minpp::tuple<std::uint32_t, std::uint32_t, std::uint64_t> wrong{1u, 1u, std::uint64_t{1}};
+    if (a.compare_exchange(wrong, {}) || wrong != a.load()) return 1;
+  }
+
+  {
+    // 40 bytes with padding and a double: sequence lock
+    using wide = minpp::atomic_tuple<std::uint64_t, std::uint64_t, std::uint64_t, char, double>;
+    static_assert(!wide::is_always_lock_free);
+    wide a;
+    if (a.load() != minpp::tuple<std::uint64_t, std::uint64_t, std::uint64_t, char, double>{}) return 1;
+    a.store({std::uint64_t{0}, std::uint64_t{0}, std::uint64_t{7}, 'c', 0.5});
+    if (!hammer(a)) return 1;
+
+    std::vector<std::thread> bumpers;
+    for (int t = 0; t < 4; ++t) {
+      bumpers.emplace_back([&] {
+        for (int i = 0; i < 10000; ++i) a.update<4>([](double d) { return d + 1.0; });
+      });
+    }
+    for (auto& t: bumpers) t.join();
+    std::cout << minpp::get<4>(a.load()) << std::endl;
+    if (minpp::get<4>(a.load()) != 40000.5 || minpp::get<3>(a.load()) != 'c') return 1;
+  }
+}
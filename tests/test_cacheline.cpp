@@ -0,0 +1,74 @@
+#include "minpp/tuple.h"
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using counters = minpp::aligned_tuple<std::atomic<std::uint64_t>, std::atomic<std::uint64_t>, std::atomic<std::uint64_t>, std::atomic<std::uint64_t>>;
+using mixed = minpp::tuple<int, minpp::cacheline<long>, std::string>;
+
+static_assert(alignof(counters) == MINPP_CACHELINE_SIZE);
+static_assert(sizeof(counters) == 4 * MINPP_CACHELINE_SIZE);
+static_assert(std::is_same_v<std::tuple_element_t<1, mixed>, long>);
+static_assert(std::is_same_v<decltype(minpp::get<1>(std::declval<mixed&>())), long&>);
+static_assert(std::is_same_v<decltype(minpp::get<1>(std::declval<const mixed&>())), const long&>);
+static_assert(std::is_same_v<decltype(minpp::get<1>(std::declval<mixed&&>())), long&&>);
+static_assert(std::is_same_v<decltype(minpp::get<0>(std::declval<counters&>())), std::atomic<std::uint64_t>&>);
+
+constexpr long constexpr_check() {
+  minpp::tuple<int, minpp::cacheline<long>> t{1, 2L};
+  minpp::get<1>(t) += minpp::get<0>(t);
+  return minpp::get<1>(t);
+}
+static_assert(constexpr_check() == 3);
+
+template <typename Tuple, std::size_t I, std::size_t J>
+std::ptrdiff_t distance(Tuple& t) {
+  return reinterpret_cast<const char*>(&minpp::get<J>(t)) - reinterpret_cast<const char*>(&minpp::get<I>(t));
+}
+
+int main() {
+  std::cout << std::boolalpha;
+
+  {
+    counters c;
+    for (std::ptrdiff_t d: {distance<counters, 0, 1>(c), distance<counters, 1, 2>(c), distance<counters, 2, 3>(c)}) {
+      std::cout << (d < 0 ? -d : d) << ' ';
+      if ((d < 0 ? -d : d) < MINPP_CACHELINE_SIZE) return 1;
+    }
+    std::cout << std::endl;
+
+    std::vector<std::thread> threads;
+    threads.emplace_back([&] { for (int i = 0; i < 1000; ++i) minpp::get<0>(c).fetch_add(1, std::memory_order_relaxed); });
+    threads.emplace_back([&] { for (int i = 0; i < 2000; ++i) minpp::get<1>(c).fetch_add(1, std::memory_order_relaxed); });
+    threads.emplace_back([&] { for (int i = 0; i < 3000; ++i) minpp::get<3>(c).fetch_add(1, std::memory_order_relaxed); });
+    for (auto& t: threads) t.join();
+    const std::uint64_t sum = minpp::apply([](const auto&... a) { return (a.load() + ...); }, c);
+    std::cout << sum << std::endl;
+    if (sum != 6000 || minpp::get<2>(c).load() != 0) return 1;
+  }
+
+  {
+    mixed a{1, 2L, "x"};
+    mixed b = a;
+    auto& [i, l, s] = b;
+    static_assert(std::is_same_v<decltype(l), long>);
+    l = 5;
+    s += "y";
+    std::cout << minpp::get<1>(b) << ' ' << minpp::get<2>(b) << std::endl;
+    if (minpp::get<1>(b) != 5 || minpp::get<1>(a) != 2 || a == b || !(a < b)) return 1;
+
+    a = b;
+    if (!(a == b)) return 1;
+    a = minpp::tuple<int, long, const char*>{7, 8L, "z"};
+    if (minpp::get<0>(a) != 7 || minpp::get<1>(a) != 8 || minpp::get<2>(a) != "z") return 1;
+
+    swap(a, b);
+    if (minpp::get<1>(a) != 5 || minpp::get<1>(b) != 8) return 1;
+    if (minpp::apply([](int x, long y, const std::string& z) { return x + y + static_cast<long>(z.size()); }, b) != 16) return 1;
+  }
+}
@@ -0,0 +1,155 @@
+#include "minpp/column_codec.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+using row = minpp::tuple<std::uint64_t, std::uint32_t, std::int32_t>;
+
+template <typename... Codecs>
+using codec_for = minpp::column_codec<row, Codecs...>;
+
+namespace {
+
+std::vector<row> make_rows(std::size_t n, std::uint32_t seed) {
+  std::mt19937_64 rng{seed};
+  std::vector<row> rows;
+  std::uint64_t ts = 1700000000000;
+  for (std::size_t i = 0; i < n; ++i) {
+    ts += rng() % 5;
+    const auto id = static_cast<std::uint32_t>(40000 + rng() % 300);
+    const auto v = static_cast<std::int32_t>(i / 37 % 2 ? -static_cast<std::int32_t>(i % 11) : static_cast<std::int32_t>(rng() % 1000));
+    rows.emplace_back(ts, id, v);
+  }
+  return rows;
+}
+
+template <typename Codec>
+bool round_trips(const std::vector<row>& rows, std::size_t block_rows) {
+  const Codec codec{block_rows};
+  const std::vector<std::byte> data = codec.encode(rows.begin(), rows.end());
+  if (Codec::rows(data) != rows.size() || Codec::blocks(data) != (rows.size() + block_rows - 1) / block_rows) return false;
+
+  std::vector<row> back;
+  Codec::decode(data, std::back_inserter(back));
+  if (back != rows) return false;
+
+  std::vector<std::uint64_t> c0(rows.size());
+  std::vector<std::uint32_t> c1(rows.size());
+  std::vector<std::int32_t> c2(rows.size());
+  if (Codec::template decode_column<0>(data, std::span{c0}) != rows.size()) return false;
+  Codec::template decode_column<1>(data, std::span{c1});
+  Codec::template decode_column<2>(data, std::span{c2});
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    if (c0[i] != minpp::get<0>(rows[i]) || c1[i] != minpp::get<1>(rows[i]) || c2[i] != minpp::get<2>(rows[i])) return false;
+  }
+  return true;
+}
+
+template <typename Codec>
+bool round_trips(const std::vector<row>& rows) {
+  for (std::size_t block_rows: {std::size_t{1}, std::size_t{100}, std::size_t{256}, std::size_t{4096}}) {
+    if (!round_trips<Codec>(rows, block_rows)) return false;
+  }
+  return true;
+}
+
+}
+
+int main() {
+  using namespace minpp::codec;
+  const std::vector<row> rows = make_rows(10000, 1);
+
+  if (!round_trips<codec_for<raw, raw, raw>>(rows)) return 1;
+  if (!round_trips<codec_for<delta, frame_of_reference, bit_packing>>(rows)) return 1;
+  if (!round_trips<codec_for<frame_of_reference, dictionary, run_length>>(rows)) return 1;
+  if (!round_trips<codec_for<bit_packing, run_length, dictionary>>(rows)) return 1;
+  if (!round_trips<codec_for<dictionary, delta, delta>>(rows)) return 1;
+  if (!round_trips<codec_for<delta, delta, frame_of_reference>>(std::vector<row>{})) return 1;
+
+  {
+    // full-width values, wrapping deltas and both ends of every type
+    std::mt19937_64 rng{2};
+    std::vector<row> wide;
+    for (int i = 0; i < 3000; ++i) {
+      wide.emplace_back(rng(), static_cast<std::uint32_t>(rng()), static_cast<std::int32_t>(static_cast<std::uint32_t>(rng())));
+    }
+    wide.emplace_back(std::uint64_t{0}, std::numeric_limits<std::uint32_t>::max(), std::numeric_limits<std::int32_t>::min());
+    wide.emplace_back(std::numeric_limits<std::uint64_t>::max(), std::uint32_t{0}, std::numeric_limits<std::int32_t>::max());
+    if (!round_trips<codec_for<bit_packing, frame_of_reference, delta>>(wide)) return 1;
+    if (!round_trips<codec_for<delta, bit_packing, frame_of_reference>>(wide)) return 1;
+    if (!round_trips<codec_for<frame_of_reference, delta, bit_packing>>(wide)) return 1;
+  }
+
+  {
+    // blocks decode independently, and the codecs compress what they are meant for
+    const codec_for<delta, frame_of_reference, run_length> codec{1024};
+    std::vector<row> sorted;
+    for (std::uint32_t i = 0; i < 5000; ++i) sorted.emplace_back(1700000000000 + 3 * std::uint64_t{i}, 70000 + i % 16, static_cast<std::int32_t>(i / 1000));
+    const auto data = codec.encode(sorted.begin(), sorted.end());
+    std::cout << data.size() << " bytes for " << sorted.size() * sizeof(row) << std::endl;
+    if (data.size() * 8 > sorted.size() * sizeof(row)) return 1;
+
+    std::vector<row> block3;
+    codec.decode_block(data, 3, std::back_inserter(block3));
+    if (block3.size() != 1024 || !(block3.front() == sorted[3 * 1024]) || !(block3.back() == sorted[4 * 1024 - 1])) return 1;
+    std::vector<std::uint32_t> ids(1024);
+    if (codec.decode_column<1>(data, 4, std::span{ids}) != 5000 - 4 * 1024 || ids[0] != minpp::get<1>(sorted[4 * 1024])) return 1;
+
+    // any tuple-like input whose elements convert
+    std::vector<std::tuple<int, int, int>> small{{1, 2, 3}, {4, 5, -6}};
+    std::vector<row> back;
+    codec.decode(codec.encode(small.begin(), small.end()), std::back_inserter(back));
+    if (back.size() != 2 || !(back[1] == row{4u, 5u, -6})) return 1;
+  }
+
+  {
+    const codec_for<delta, frame_of_reference, dictionary> codec{512};
+    const auto data = codec.encode(rows.begin(), rows.end());
+    std::vector<row> out;
+
+    auto rejects = [&](std::span<const std::byte> bytes) {
+      try {
+        out.clear();
+        codec.decode(bytes, std::back_inserter(out));
+        return false;
+      }
+      catch (const std::invalid_argument&) {
+        return true;
+      }
+    };
+    for (std::size_t cut: {std::size_t{0}, std::size_t{3}, std::size_t{30}, data.size() / 2, data.size() - 1}) {
+      if (!rejects(std::span{data}.first(cut))) return 1;
+    }
+    // a different codec for a column is a format error, not garbage
+    try {
+      codec_for<delta, dictionary, dictionary>::decode(data, std::back_inserter(out));
+      return 1;
+    }
+    catch (const std::invalid_argument&) {}
+    try {
+      std::vector<std::uint64_t> c(512);
+      codec.decode_column<0>(data, codec.blocks(data), std::span{c});
+      return 1;
+    }
+    catch (const std::out_of_range&) {}
+    try {
+      std::vector<std::uint64_t> c(511);
+      codec.decode_column<0>(data, 0, std::span{c});
+      return 1;
+    }
+    catch (const std::invalid_argument&) {}
+    try {
+      codec_for<raw, raw, raw>{0};
+      return 1;
+    }
+    catch (const std::invalid_argument&) {}
+  }
+}
@@ -0,0 +1,85 @@
+#include "minpp/cow_tuple.h"
+
+#include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using record = minpp::cow_tuple<std::string, std::vector<int>, double>;
+
+static_assert(std::tuple_size_v<record> == 3);
+static_assert(std::is_same_v<std::tuple_element_t<1, record>, std::vector<int>>);
+static_assert(std::is_same_v<decltype(minpp::get<0>(std::declval<const record&>())), const std::string&>);
+static_assert(std::is_same_v<decltype(minpp::get<0>(std::declval<record&>())), std::string&>);
+static_assert(std::is_same_v<decltype(minpp::get<0>(std::declval<record&&>())), std::string&&>);
+static_assert(!std::is_convertible_v<minpp::tuple<std::string, std::vector<int>, double>, record>);
+
+int main() {
+  {
+    const record a{"name", std::vector<int>{1, 2, 3}, 0.5};
+    record b = a;
+    record c = b;
+    std::cout << a.use_count() << std::endl;
+    if (a.use_count() != 3 || !b.shares_with(a) || &minpp::get<0>(a) != &minpp::get<0>(std::as_const(c))) return 1;
+    if (!(a == c) || !(a == minpp::tuple<std::string, std::vector<int>, double>{"name", {1, 2, 3}, 0.5})) return 1;
+
+    // writing through a shared copy copies the tuple once; the others keep the old value
+    minpp::get<2>(b) = 1.5;
+    minpp::get<1>(b).push_back(4);
+    std::cout << a.use_count() << ' ' << b.use_count() << std::endl;
+    if (a.use_count() != 2 || b.use_count() != 1 || b.shares_with(a)) return 1;
+    if (minpp::get<2>(a) != 0.5 || minpp::get<1>(a).size() != 3 || minpp::get<1>(std::as_const(b)).size() != 4) return 1;
+    if (!(a < b) || a == b) return 1;
+
+    // a unique value is written in place
+    const auto* before = &b.read();
+    b.write() = {"other", {}, 2.0};
+    if (&b.read() != before || minpp::get<0>(std::as_const(b)) != "other") return 1;
+
+    const auto& [name, values, score] = std::as_const(c);
+    if (name != "name" || values.size() != 3 || score != 0.5 || c.use_count() != 2) return 1;
+
+    // moving an element out of a shared value moves it out of a copy
+    std::string moved = minpp::get<0>(std::move(c));
+    if (moved != "name" || minpp::get<0>(std::as_const(a)) != "name" || c.use_count() != 1 || a.use_count() != 1) return 1;
+  }
+
+  {
+    record a{"x", std::vector<int>{}, 1.0};
+    record b{std::move(a)};
+    a = b;
+    b = std::move(b);
+    swap(a, b);
+    if (a.use_count() != 2 || minpp::get<0>(std::as_const(a)) != "x") return 1;
+    record d;
+    if (!(d == minpp::tuple<std::string, std::vector<int>, double>{})) return 1;
+
+    // equality does not depend on sharing: a NaN compares unequal to itself, shared or not
+    const minpp::cow_tuple<double> nan{std::numeric_limits<double>::quiet_NaN()};
+    const minpp::cow_tuple<double> shared = nan;
+    const minpp::cow_tuple<double> unshared{minpp::get<0>(nan)};
+    if (!shared.shares_with(nan) || shared == nan || unshared == nan) return 1;
+  }
+
+  {
+    // copies of a concurrent cow tuple are made and dropped on several threads
+    const minpp::concurrent_cow_tuple<std::string, int> shared{"shared", 1};
+    std::vector<std::thread> threads;
+    std::vector<int> sums(4);
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&, t] {
+        for (int i = 0; i < 10000; ++i) {
+          auto copy = shared;
+          if (i % 100 == 0) minpp::get<1>(copy) += i;
+          sums[static_cast<std::size_t>(t)] += minpp::get<1>(std::as_const(copy));
+        }
+      });
+    }
+    for (auto& t: threads) t.join();
+    std::cout << shared.use_count() << ' ' << sums[0] << std::endl;
+    if (shared.use_count() != 1 || minpp::get<1>(shared) != 1 || sums[0] != 10000 + 495000) return 1;
+  }
+}
@@ -0,0 +1,89 @@
+#include "minpp/dynamic_tuple.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <typeinfo>
+
+struct padded {
+  char c;
+  double d;
+};
+
+template <typename... Ts, std::size_t... Is>
+bool offsets_match(std::index_sequence<Is...>) {
+  minpp::tuple<Ts...> t{};
+  const auto layout = minpp::tuple_layout::of<Ts...>();
+  const auto* base = reinterpret_cast<const char*>(&t);
+  return layout.size_bytes() == sizeof(t) && layout.alignment() == alignof(decltype(t)) &&
+    ((static_cast<std::size_t>(reinterpret_cast<const char*>(&minpp::get<Is>(t)) - base) == layout.offset(Is)) && ...);
+}
+
+template <typename... Ts>
+bool offsets_match() {
+  return offsets_match<Ts...>(std::index_sequence_for<Ts...>{});
+}
+
+int main() {
+  std::cout << std::boolalpha;
+
+  {
+    const bool ok = offsets_match<char, int, char, double>() && offsets_match<std::uint16_t, padded, char>() &&
+      offsets_match<std::string, char, std::int64_t, float>() && offsets_match<char>();
+    std::cout << ok << std::endl;
+    if (!ok) return 1;
+  }
+
+  using row = minpp::tuple<std::int32_t, std::string, double, char>;
+  // built from config at runtime in practice
+  const minpp::tuple_layout layout{minpp::column_of<std::int32_t>(), minpp::column_of<std::string>(), minpp::column_of<double>(), minpp::column_of<char>()};
+  if (!layout.matches<row>() || layout.matches<minpp::tuple<std::int32_t, std::string, double>>()) return 1;
+  if (!(layout == minpp::tuple_layout::of<std::int32_t, std::string, double, char>())) return 1;
+
+  std::pmr::monotonic_buffer_resource arena;
+  {
+    minpp::dynamic_tuple r{layout, &arena};
+    if (r.get<std::int32_t>(0) != 0 || !r.get<std::string>(1).empty()) return 1;
+    r.get<std::int32_t>(0) = 7;
+    r.get<std::string>(1) = std::string(64, 'z');
+    r.get<double>(2) = 1.5;
+
+    row& view = r.as<row>();
+    std::cout << minpp::get<0>(view) << ' ' << minpp::get<1>(view).size() << ' ' << minpp::get<2>(view) << std::endl;
+    if (minpp::get<0>(view) != 7 || minpp::get<1>(view).size() != 64 || static_cast<void*>(&view) != r.data()) return 1;
+    minpp::get<3>(view) = 'q';
+    if (r.get<char>(3) != 'q') return 1;
+
+    minpp::dynamic_tuple copy = r;
+    copy.get<std::string>(1) = "copy";
+    if (r.get<std::string>(1).size() != 64 || copy.as<row>() == view) return 1;
+
+    minpp::dynamic_tuple moved = std::move(copy);
+    if (moved.get<std::string>(1) != "copy") return 1;
+
+    bool caught_type = false;
+    try {
+      r.get<float>(2);
+    }
+    catch (const std::bad_cast&) {
+      caught_type = true;
+    }
+    bool caught_view = false;
+    try {
+      r.as<minpp::tuple<std::int32_t, std::string, float, char>>();
+    }
+    catch (const std::bad_cast&) {
+      caught_view = true;
+    }
+    bool caught_index = false;
+    try {
+      r.get<char>(4);
+    }
+    catch (const std::out_of_range&) {
+      caught_index = true;
+    }
+    std::cout << caught_type << ' ' << caught_view << ' ' << caught_index << std::endl;
+    if (!caught_type || !caught_view || !caught_index) return 1;
+  }
+}
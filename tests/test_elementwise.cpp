@@ -0,0 +1,83 @@
+#include "minpp/elementwise.h"
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+
+using namespace minpp::elementwise;
+
+using vec3 = minpp::tuple<float, float, float>;
+using vec4 = minpp::tuple<float, float, float, float>;
+using dvec2 = minpp::tuple<double, double>;
+
+#if MINPP_ELEMENTWISE_VECTOR_EXT
+template <typename Expression>
+inline constexpr bool vectorized = minpp::impl::_vectorizable<std::remove_cvref_t<decltype(std::declval<Expression>().node())>>;
+
+static_assert(vectorized<decltype(vec4{} * 2.0f + vec4{})>);
+static_assert(vectorized<decltype(-dvec2{} / dvec2{})>);
+static_assert(vectorized<decltype(min(minpp::tuple<int, int, int, int>{} / 2, 0))>);
+static_assert(!vectorized<decltype(vec3{} + vec3{})>);
+static_assert(!vectorized<decltype(minpp::tuple<int, double>{} + 1)>);
+#endif
+static_assert(std::is_same_v<decltype(eval(minpp::tuple<short, int>{} + minpp::tuple<short, long>{})), minpp::tuple<int, long>>);
+static_assert(std::is_same_v<decltype(eval(minpp::tuple<int, float>{} * 0.5)), minpp::tuple<int, float>>);
+
+// operands must have the same size
+template <typename L, typename R>
+concept addable = requires (L l, R r) { l + r; };
+static_assert(addable<vec3, vec3> && addable<vec3, float> && addable<double, vec3>);
+static_assert(!addable<vec3, vec4> && !addable<minpp::tuple<float, bool>, float>);
+
+// the element-by-element path is used in constant evaluation
+static_assert(eval(dvec2{1.0, 2.0} * 3.0 - dvec2{1.0, 1.0}) == dvec2{2.0, 5.0});
+static_assert(dot(dvec2{1.0, 2.0}, dvec2{3.0, 4.0}) == 11.0);
+
+int main() {
+  const vec3 a{1.0f, 2.0f, 3.0f};
+  const vec3 b{4.0f, -5.0f, 6.0f};
+
+  vec3 c = a * 2.0f + b;
+  std::cout << minpp::get<0>(c) << ' ' << minpp::get<1>(c) << ' ' << minpp::get<2>(c) << std::endl;
+  if (!(c == vec3{6.0f, -1.0f, 12.0f})) return 1;
+
+  c = (a - b) / vec3{1.0f, 2.0f, 4.0f};
+  if (!(c == vec3{-3.0f, 3.5f, -0.75f})) return 1;
+  if (!(eval(-a) == vec3{-1.0f, -2.0f, -3.0f})) return 1;
+  if (!(eval(2.0f - a) == vec3{1.0f, 0.0f, -1.0f})) return 1;
+  if (!(eval(min(a, b)) == vec3{1.0f, -5.0f, 3.0f}) || !(eval(max(a, 2.5f)) == vec3{2.5f, 2.5f, 3.0f})) return 1;
+  if (dot(a, b) != 4.0f - 10.0f + 18.0f || dot(a, a + b) != dot(a, a) + dot(a, b)) return 1;
+
+  // the target may appear on the right of a compound assignment
+  vec4 v{1.0f, 2.0f, 3.0f, 4.0f};
+  v += v * 0.5f;
+  v -= vec4{1.0f, 1.0f, 1.0f, 1.0f};
+  v *= 2.0f;
+  v /= v;
+  if (!(v == vec4{1.0f, 1.0f, 1.0f, 1.0f})) return 1;
+
+  // an expression built from temporaries keeps them
+  const auto e = vec3{1.0f, 1.0f, 1.0f} + vec3{2.0f, 2.0f, 2.0f};
+  if (!(e.eval() == vec3{3.0f, 3.0f, 3.0f})) return 1;
+
+  // NaN and ties are handled like std::min and std::max on both paths
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const vec4 n = min(vec4{nan, 1.0f, 2.0f, 0.0f}, vec4{1.0f, nan, 2.0f, -0.0f});
+  if (!std::isnan(minpp::get<0>(n)) || minpp::get<1>(n) != 1.0f || std::signbit(minpp::get<3>(n))) return 1;
+  const minpp::tuple<float, double> m = min(minpp::tuple<float, double>{nan, 1.0}, 0.0);
+  if (!std::isnan(minpp::get<0>(m)) || minpp::get<1>(m) != 0.0) return 1;
+
+  // integer tuples
+  using ivec3 = minpp::tuple<std::int32_t, std::int32_t, std::int32_t>;
+  const ivec3 i = (ivec3{10, 20, 30} - ivec3{1, 2, 3}) / 3 * ivec3{1, 2, 3};
+  if (!(i == ivec3{3, 12, 27}) || dot(i, ivec3{1, 1, 1}) != 42) return 1;
+  using ivec4 = minpp::tuple<std::int32_t, std::int32_t, std::int32_t, std::int32_t>;
+  const ivec4 j = max(ivec4{7, -8, 9, -10} / ivec4{2, 2, -2, -2}, -3);
+  if (!(j == ivec4{3, -3, -3, 5})) return 1;
+
+  // mixed element types
+  const minpp::tuple<int, double, std::int64_t> mixed = minpp::tuple<int, double, std::int64_t>{1, 1.5, 1LL << 40} * 2;
+  if (!(mixed == minpp::tuple<int, double, std::int64_t>{2, 3.0, 1LL << 41})) return 1;
+}
@@ -0,0 +1,89 @@
+#include "minpp/format.h"
+#include "minpp/parse_delimited.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <unistd.h>
+
+enum class side : std::uint8_t { buy = 1, sell = 2 };
+
+using row = minpp::tuple<std::int64_t, double, std::string, bool, char, side>;
+
+int main() {
+  {
+    std::string out;
+    minpp::format_to(out, row{-42, 0.1, "abc", true, 'x', side::sell});
+    std::cout << out << std::endl;
+    if (out != "-42,0.1,abc,true,x,2") return 1;
+
+    std::vector<char> chars;
+    minpp::format_to(chars, minpp::tuple<unsigned, float, std::string_view, const char*>{7u, 1.5f, "sv", "cstr"}, '\t');
+    if (std::string_view(chars.data(), chars.size()) != "7\t1.5\tsv\tcstr") return 1;
+  }
+
+  std::vector<minpp::tuple<std::int64_t, double, std::string>> rows;
+  for (int i = 0; i < 5000; ++i) rows.emplace_back(i * 1000003LL, i / 3.0, std::string(static_cast<std::size_t>(i % 17), 'a'));
+
+  {
+    // doubles are written in round-trip form, so the dump parses back to the same rows
+    std::string out;
+    minpp::write_rows(out, rows, ';');
+    std::size_t i = 0;
+    for (const auto& [a, b, c]: minpp::parse_delimited<minpp::tuple<std::int64_t, double, std::string_view>>(out, ';')) {
+      if (a != minpp::get<0>(rows[i]) || b != minpp::get<1>(rows[i]) || c != minpp::get<2>(rows[i])) return 1;
+      ++i;
+    }
+    std::cout << out.size() << ' ' << i << std::endl;
+    if (i != rows.size()) return 1;
+  }
+
+  {
+    // write_rows to a descriptor writes the same bytes, several buffers' worth
+    std::FILE* f = std::tmpfile();
+    if (!f) return 1;
+    const int fd = fileno(f);
+    {
+      minpp::row_writer w{fd, ';', 4096};
+      w.write_rows(rows);
+      w.write(rows.front());
+    }
+    minpp::write_rows(fd, rows, ';');
+
+    std::string expected;
+    minpp::write_rows(expected, rows, ';');
+    minpp::format_to(expected, rows.front(), ';');
+    expected += '\n';
+    minpp::write_rows(expected, rows, ';');
+
+    std::string written(expected.size() + 1, '\0');
+    const auto n = ::pread(fd, written.data(), written.size(), 0);
+    std::fclose(f);
+    std::cout << n << ' ' << expected.size() << std::endl;
+    if (n != static_cast<std::ptrdiff_t>(expected.size())) return 1;
+    written.resize(static_cast<std::size_t>(n));
+    if (written != expected) return 1;
+  }
+
+  {
+    bool threw = false;
+    try {
+      minpp::write_rows(-1, rows);
+    }
+    catch (const std::system_error& e) {
+      std::cout << e.what() << std::endl;
+      threw = true;
+    }
+    if (!threw) return 1;
+  }
+
+#if defined(__cpp_lib_format)
+  if (std::format("{}", minpp::tuple<int, std::string, double>{1, "a", 2.5}) != "(1, a, 2.5)") return 1;
+  if (std::format("{:n}", minpp::tuple<int, int>{1, 2}) != "1, 2") return 1;
+#endif
+}
@@ -0,0 +1,164 @@
+#include "minpp/group_by.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+using row = minpp::tuple<std::string, std::uint32_t, std::int32_t, double>;
+
+namespace {
+
+std::vector<row> make_rows(std::size_t n, std::uint32_t groups) {
+  std::mt19937 rng{5};
+  std::vector<row> rows;
+  for (std::size_t i = 0; i < n; ++i) {
+    const std::uint32_t g = rng() % groups;
+    std::string key = "k";
+    key += std::to_string(g % 7);
+    rows.emplace_back(std::move(key), g, static_cast<std::int32_t>(rng() % 2001) - 1000, static_cast<double>(rng() % 100));
+  }
+  return rows;
+}
+
+using result = minpp::tuple<std::string, std::uint32_t, std::int64_t, std::size_t, std::int32_t, std::int32_t, double>;
+
+// the same aggregation through a std::map
+std::vector<result> reference(const std::vector<row>& rows) {
+  std::map<std::pair<std::string, std::uint32_t>, result> m;
+  for (const auto& [s, g, v, d]: rows) {
+    auto [it, fresh] = m.try_emplace({s, g}, s, g, std::int64_t{v}, std::size_t{1}, v, v, d);
+    if (fresh) continue;
+    auto& [rs, rg, sum, count, lo, hi, total] = it->second;
+    sum += v;
+    ++count;
+    lo = std::min(lo, v);
+    hi = std::max(hi, v);
+    total += d;
+  }
+  std::vector<result> out;
+  for (auto& [k, r]: m) {
+    minpp::get<6>(r) /= static_cast<double>(minpp::get<3>(r));
+    out.push_back(r);
+  }
+  return out;
+}
+
+template <typename Range>
+std::vector<result> grouped(Range&& rows) {
+  using namespace minpp::agg;
+  return minpp::group_by<0, 1>(std::forward<Range>(rows)).aggregate(sum<2>, count, min<2>, max<2>, mean<3>);
+}
+
+std::vector<result> sorted(std::vector<result> v) {
+  std::sort(v.begin(), v.end());
+  return v;
+}
+
+// a user-defined aggregator: the last value of element I
+template <std::size_t I>
+struct last {
+  template <typename Row>
+  auto first(const Row& r) const {
+    using std::get;
+    return get<I>(r);
+  }
+  template <typename S, typename Row>
+  void update(S& s, const Row& r) const {
+    using std::get;
+    s = get<I>(r);
+  }
+  template <typename S>
+  void merge(S& s, S&& o) const { s = o; }
+  template <typename S>
+  S finish(S&& s) const { return s; }
+};
+
+struct throwing {
+  template <typename Row>
+  int first(const Row&) const { return 0; }
+  template <typename Row>
+  void update(int& s, const Row&) const {
+    if (++s == 3) throw std::runtime_error("update");
+  }
+  void merge(int& s, int o) const { s += o; }
+  int finish(int s) const { return s; }
+};
+
+}
+
+static_assert(std::is_same_v<decltype(grouped(std::declval<const std::vector<row>&>()))::value_type, result>);
+static_assert(std::is_same_v<minpp::grouping<std::ranges::ref_view<const std::vector<row>>, 1>::result_type<minpp::agg::count_t>,
+  minpp::tuple<std::uint32_t, std::size_t>>);
+
+int main() {
+  {
+    const std::vector<row> rows = make_rows(20000, 300);
+    const std::vector<result> out = grouped(rows);
+    std::cout << out.size() << " groups" << std::endl;
+    if (out.size() != 300 || sorted(out) != reference(rows)) return 1;
+
+    // groups come in the order their keys first appear
+    if (!(minpp::get<0>(out[0]) == minpp::get<0>(rows[0])) || minpp::get<1>(out[0]) != minpp::get<1>(rows[0])) return 1;
+
+    // no aggregators: the distinct keys
+    const auto keys = minpp::group_by<1>(rows).aggregate();
+    if (keys.size() != 300) return 1;
+
+    // rvalue containers are moved in, views are taken as they are, with rows that are not lvalues
+    if (sorted(grouped(std::vector<row>(rows))) != reference(rows)) return 1;
+    auto view = std::views::iota(std::size_t{0}, rows.size()) | std::views::transform([&](std::size_t i) { return rows[i]; });
+    if (sorted(grouped(view)) != reference(rows)) return 1;
+
+    if (!grouped(std::vector<row>{}).empty()) return 1;
+  }
+
+  {
+    // std::tuple rows and a user-defined aggregator
+    std::vector<std::tuple<int, char>> rows{{1, 'a'}, {2, 'b'}, {1, 'c'}, {3, 'd'}, {2, 'e'}};
+    const auto out = minpp::group_by<0>(rows).aggregate(last<1>{}, minpp::agg::count);
+    using out_row = minpp::tuple<int, char, std::size_t>;
+    if (out != std::vector<out_row>{{1, 'c', 2u}, {2, 'e', 2u}, {3, 'd', 1u}}) return 1;
+  }
+
+  {
+    // the parallel mode finds the same groups, from few to one per row
+    minpp::thread_pool pool{3};
+    for (std::uint32_t groups: {1u, 300u, 100000u}) {
+      const std::vector<row> rows = make_rows(100000, groups);
+      const std::vector<result> expected = reference(rows);
+      std::vector<result> out = grouped(rows);
+      if (sorted(out) != expected) return 1;
+      using namespace minpp::agg;
+      out = minpp::group_by<0, 1>(rows).aggregate(pool, sum<2>, count, min<2>, max<2>, mean<3>);
+      out = sorted(std::move(out));
+      if (out.size() != expected.size()) return 1;
+      // the means may differ in the last bits, since the partial sums are added in another order
+      for (std::size_t i = 0; i < out.size(); ++i) {
+        const double m = minpp::get<6>(expected[i]);
+        if (minpp::get<6>(out[i]) < m - 1e-9 || minpp::get<6>(out[i]) > m + 1e-9) return 1;
+        minpp::get<6>(out[i]) = m;
+      }
+      if (out != expected) return 1;
+    }
+
+    // exceptions of an aggregator reach the caller, in either mode
+    const std::vector<row> rows = make_rows(100000, 10);
+    for (int parallel = 0; parallel < 2; ++parallel) {
+      try {
+        if (parallel) minpp::group_by<1>(rows).aggregate(pool, throwing{});
+        else minpp::group_by<1>(rows).aggregate(throwing{});
+        return 1;
+      }
+      catch (const std::runtime_error&) {}
+    }
+  }
+}
@@ -0,0 +1,39 @@
+// every public header in one translation unit, so that names two headers both define fail to compile here
+#include "minpp/atomic_tuple.h"
+#include "minpp/column_codec.h"
+#include "minpp/common_concepts.h"
+#include "minpp/common_meta.h"
+#include "minpp/common_shorthands.h"
+#include "minpp/cow_tuple.h"
+#include "minpp/dynamic_tuple.h"
+#include "minpp/elementwise.h"
+#include "minpp/format.h"
+#include "minpp/group_by.h"
+#include "minpp/lazy_tuple.h"
+#include "minpp/memoize.h"
+#include "minpp/pair.h"
+#include "minpp/parse_delimited.h"
+#include "minpp/projection.h"
+#include "minpp/sort_key.h"
+#include "minpp/split_tuple.h"
+#include "minpp/thread_pool.h"
+#include "minpp/tuple.h"
+#include "minpp/tuple_interner.h"
+#include "minpp/tuple_pool.h"
+#include "minpp/tuple_ring.h"
+#include "minpp/visit.h"
+#include "minpp/when_all.h"
+
+#include <vector>
+
+int main() {
+  // the helpers of the pools and of the fan-outs are instantiated side by side
+  minpp::tuple_pool<int, double> rows;
+  minpp::tuple_pool<int, double>::local_cache cache{rows};
+  minpp::thread_pool pool{1};
+  std::vector<minpp::tuple<int, int>> in{{1, 2}, {1, 3}, {2, 4}};
+  const auto out = minpp::group_by<0>(in).aggregate(pool, minpp::agg::sum<1>);
+  if (out.size() != 2 || minpp::get<1>(out[0]) != 5) return 1;
+  const auto [a, b] = minpp::when_all(pool, [] { return 1; }, [] { return 2; });
+  if (a + b != 3) return 1;
+}
@@ -0,0 +1,96 @@
+#include "minpp/tuple.h"
+
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <span>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+using vec4 = minpp::tuple<float, float, float, float>;
+
+template <typename Tuple>
+concept runtime_indexable = requires (Tuple t, std::size_t i) { t[i]; t.data(); };
+
+static_assert(runtime_indexable<vec4> && runtime_indexable<minpp::tuple<std::string, std::string>>);
+static_assert(!runtime_indexable<minpp::tuple<int>> && !runtime_indexable<minpp::tuple<int, long>>);
+static_assert(!runtime_indexable<minpp::tuple<int&, int&>> && !runtime_indexable<minpp::aligned_tuple<int, int>>);
+
+// the array has the layout of the leaves it replaces
+static_assert(sizeof(vec4) == 4 * sizeof(float) && alignof(vec4) == alignof(float));
+static_assert(std::is_trivially_copyable_v<vec4> && std::is_standard_layout_v<vec4>);
+
+static_assert(std::is_same_v<decltype(std::declval<vec4&>()[0]), float&>);
+static_assert(std::is_same_v<decltype(std::declval<const vec4&>()[0]), const float&>);
+static_assert(std::is_same_v<decltype(std::declval<vec4&&>()[0]), float&&>);
+static_assert(std::is_same_v<decltype(minpp::get<2>(std::declval<vec4&&>())), float&&>);
+static_assert(std::is_same_v<std::tuple_element_t<3, vec4>, float>);
+
+static_assert(std::is_convertible_v<vec4&, std::span<float, 4>> && std::is_convertible_v<vec4&, std::span<const float>>);
+static_assert(std::is_convertible_v<const vec4&, std::span<const float, 4>> && !std::is_convertible_v<const vec4&, std::span<float, 4>>);
+static_assert(!std::is_convertible_v<vec4&, std::span<float, 3>> && !std::is_convertible_v<vec4&&, std::span<float>>);
+
+constexpr int sum_by_index() {
+  minpp::tuple<int, int, int> t{1, 2, 3};
+  t[1] = 20;
+  int s = 0;
+  for (std::size_t i = 0; i < 3; ++i) s += t[i];
+  return s + *(t.data() + 2);
+}
+
+static_assert(sum_by_index() == 27);
+
+// elements with an explicit default constructor are value-initialized, as with the leaves
+struct explicit_default {
+  explicit explicit_default() = default;
+  int v;
+};
+
+static_assert(runtime_indexable<minpp::tuple<explicit_default, explicit_default>>);
+static_assert(std::is_default_constructible_v<minpp::tuple<explicit_default, explicit_default>>);
+static_assert(minpp::tuple<explicit_default, explicit_default>{}[1].v == 0);
+
+int main() {
+  vec4 v{1.0f, 2.0f, 3.0f, 4.0f};
+  for (std::size_t i = 0; i < 4; ++i) v[i] *= 2.0f;
+  const std::span<float, 4> s = v;
+  const std::span<const float> cs = std::as_const(v);
+  std::cout << std::accumulate(cs.begin(), cs.end(), 0.0f) << ' ' << s[3] << std::endl;
+  if (minpp::get<0>(v) != 2.0f || s[3] != 8.0f || cs.size() != 4 || s.data() != v.data()) return 1;
+
+  // the storages convert, assign and compare across each other and std::tuple
+  minpp::tuple<double, double, double, double> d = v;
+  minpp::tuple<double, float, double, float> mixed = v;
+  if (!(d == v) || !(mixed == d) || (v <=> mixed) != 0) return 1;
+  mixed = minpp::tuple<int, int, int, int>{1, 2, 3, 4};
+  v = mixed;
+  if (v[3] != 4.0f) return 1;
+#if MINPP_STD_COMPAT
+  const std::tuple<float, float, float, float> st{4.0f, 3.0f, 2.0f, 1.0f};
+  const vec4 from_std = st;
+  if (from_std[0] != 4.0f) return 1;
+#endif
+
+  minpp::tuple<explicit_default, explicit_default> defaulted;
+  if (defaulted[0].v != 0 || defaulted[1].v != 0) return 1;
+
+  auto [a, b, c, e] = minpp::tuple_cat(minpp::tuple<int, int>{1, 2}, minpp::tuple<int, int>{3, 4});
+  if (a + b + c + e != 10) return 1;
+
+  // elements that are not trivial: moves, swap and uses-allocator construction
+  minpp::tuple<std::unique_ptr<int>, std::unique_ptr<int>> p{std::make_unique<int>(1), nullptr};
+  auto q = std::move(p);
+  swap(p, q);
+  if (!p[0] || *p[0] != 1 || q[0]) return 1;
+
+  std::pmr::monotonic_buffer_resource arena;
+  const std::pmr::polymorphic_allocator<char> alloc{&arena};
+  minpp::tuple<std::pmr::string, std::pmr::string> strings{std::allocator_arg, alloc, "a long string that allocates", "b"};
+  minpp::tuple<std::pmr::string, std::pmr::string> copy{std::allocator_arg, alloc, strings};
+  minpp::tuple<std::pmr::string, std::pmr::string> empty{std::allocator_arg, alloc};
+  if (copy[0] != strings[0] || copy[1].get_allocator().resource() != &arena || empty[0].get_allocator().resource() != &arena) return 1;
+}
@@ -0,0 +1,95 @@
+#include "minpp/lazy_tuple.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using record = minpp::lazy_tuple<int, std::string, double>;
+
+static_assert(std::tuple_size_v<record> == 3);
+static_assert(std::is_same_v<std::tuple_element_t<1, record>, std::string>);
+static_assert(std::is_same_v<decltype(minpp::get<1>(std::declval<record&>())), std::string&>);
+static_assert(std::is_same_v<decltype(minpp::get<1>(std::declval<const record&>())), const std::string&>);
+static_assert(std::is_same_v<decltype(minpp::get<1>(std::declval<record&&>())), std::string&&>);
+
+int main() {
+  std::cout << std::boolalpha;
+
+  {
+    int calls = 0;
+    record r{1, minpp::defer([&] { ++calls; return std::string("derived"); }), 2.5};
+    if (!r.ready<0>() || r.ready<1>() || calls != 0) return 1;
+
+    // comparisons stop at the first element that decides, so element 1 is not computed here
+    if (r == minpp::tuple<int, std::string, double>{2, "derived", 2.5} || calls != 0) return 1;
+    if (!(r < minpp::tuple<int, std::string, double>{2, "", 0.0}) || calls != 0) return 1;
+
+    const std::string& s = minpp::get<1>(r);
+    std::cout << s << ' ' << calls << std::endl;
+    if (s != "derived" || calls != 1 || !r.ready<1>()) return 1;
+    minpp::get<1>(r) += "!";
+    if (minpp::get<1>(std::as_const(r)) != "derived!" || calls != 1) return 1;
+
+    const double sum = minpp::apply([](int i, const std::string& str, double d) { return i + static_cast<double>(str.size()) + d; }, r);
+    if (sum != 11.5) return 1;
+    if (!(r.to_tuple() == minpp::tuple<int, std::string, double>{1, "derived!", 2.5})) return 1;
+  }
+
+  {
+    // copies carry the computation, or the result once there is one
+    int calls = 0;
+    record a{1, minpp::defer([&] { ++calls; return std::string("x"); }), 0.0};
+    record b = a;
+    if (minpp::get<1>(b) != "x" || calls != 1 || a.ready<1>()) return 1;
+    if (!(a == b) || calls != 2) return 1;
+
+    record c{3, "c", 1.0};
+    c = a;
+    auto [i, s, d] = c;
+    if (i != 1 || s != "x" || calls != 2) return 1;
+    record m = std::move(c);
+    if (minpp::get<1>(m) != "x") return 1;
+  }
+
+  {
+    // a computation that throws leaves the element pending
+    int attempts = 0;
+    record r{1, minpp::defer([&]() -> std::string { if (++attempts == 1) throw std::runtime_error("first"); return "second"; }), 0.0};
+    try {
+      minpp::get<1>(r);
+      return 1;
+    }
+    catch (const std::runtime_error&) {}
+    if (r.ready<1>() || minpp::get<1>(r) != "second" || attempts != 2) return 1;
+  }
+
+  {
+    // concurrent readers compute a concurrent element once
+    std::atomic<int> calls{0};
+    minpp::concurrent_lazy_tuple<int, std::vector<int>> r{7, minpp::defer([&] {
+      ++calls;
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      return std::vector<int>(1000, 1);
+    })};
+    std::atomic<long> total{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+      threads.emplace_back([&] {
+        long s = 0;
+        for (int v: minpp::get<1>(r)) s += v;
+        total += s;
+      });
+    }
+    for (auto& t: threads) t.join();
+    std::cout << calls << ' ' << total << std::endl;
+    if (calls != 1 || total != 8000) return 1;
+
+    const auto copy = r;
+    if (!copy.ready<1>() || minpp::get<1>(copy).size() != 1000 || !(copy == r)) return 1;
+  }
+}
@@ -0,0 +1,145 @@
+#include "minpp/memoize.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+int square(int x) {
+  return x * x;
+}
+
+// counts the key copies the cache makes
+struct counted {
+  int v;
+  static inline int copies = 0;
+
+  counted(int v): v{v} {}
+  counted(const counted& o): v{o.v} { ++copies; }
+  counted(counted&&) = default;
+  counted& operator=(const counted& o) { v = o.v; ++copies; return *this; }
+  counted& operator=(counted&&) = default;
+  bool operator==(const counted&) const = default;
+};
+
+}
+
+template <>
+struct std::hash<counted> {
+  std::size_t operator()(const counted& c) const noexcept { return std::hash<int>{}(c.v); }
+};
+
+using square_memo = decltype(minpp::memoize(square, 4));
+static_assert(std::is_same_v<square_memo::key_type, minpp::tuple<int>>);
+static_assert(std::is_same_v<square_memo::result_type, int>);
+static_assert(std::is_same_v<decltype(minpp::memoize([](const std::string&, double) { return 0L; }, 4))::key_type, minpp::tuple<std::string, double>>);
+
+int main() {
+  {
+    int calls = 0;
+    auto f = minpp::memoize([&](const std::string& s, int n) { ++calls; return s.size() * static_cast<std::size_t>(n); }, 16, 1);
+    const std::string a = "abc";
+    if (f(a, 2) != 6 || f(a, 2) != 6 || f(std::string("abc"), 2) != 6 || calls != 1) return 1;
+    if (f(a, 3) != 9 || calls != 2) return 1;
+    const minpp::memo_stats st = f.stats();
+    std::cout << st.hits << ' ' << st.misses << ' ' << st.hit_rate() << std::endl;
+    if (st.hits != 2 || st.misses != 2 || st.evictions != 0 || st.size != 2 || st.capacity != 16 || st.hit_rate() != 0.5) return 1;
+
+    f.clear();
+    if (f(a, 2) != 6 || calls != 3 || f.stats().size != 1) return 1;
+  }
+
+  {
+    // lookups copy nothing; a miss copies each argument once, into the key
+    auto f = minpp::memoize([](const counted& c) { return c.v + 1; }, 8, 1);
+    const counted c{41};
+    counted::copies = 0;
+    if (f(c) != 42 || counted::copies != 1) return 1;
+    if (f(c) != 42 || f(c) != 42 || counted::copies != 1) return 1;
+  }
+
+  {
+    // a full shard replaces entries in clock order, keeping the ones that were hit since the last sweep
+    int calls = 0;
+    auto f = minpp::memoize<int>([&](int x) { ++calls; return x * 10; }, 3, 1);
+    f(1); f(2); f(3);
+    f(1);
+    f(4); // sweeps 1 (referenced), evicts 2
+    if (calls != 4 || f.stats().evictions != 1 || f.stats().size != 3) return 1;
+    f(1); f(3); f(4);
+    if (calls != 4) return 1;
+    f(2);
+    if (calls != 5 || f.stats().evictions != 2) return 1;
+
+    // many insertions and evictions keep the index consistent with the slots
+    for (int round = 0; round < 4; ++round) {
+      for (int x = 0; x < 200; ++x) {
+        if (f(x) != x * 10) return 1;
+      }
+    }
+    if (f.stats().size != 3) return 1;
+  }
+
+  {
+    // the capacity is split between the shards
+    auto f = minpp::memoize(square, 10, 4);
+    if (f.shard_count() != 4 || f.stats().capacity != 10) return 1;
+    for (int x = 0; x < 1000; ++x) f(x);
+    const minpp::memo_stats st = f.stats();
+    if (st.size > 10 || st.evictions != 1000 - st.size) return 1;
+    if (minpp::memoize(square, 3, 8).shard_count() != 2) return 1;
+  }
+
+  {
+    // a memoized function may call itself while computing
+    std::uint64_t calls = 0;
+    std::function<std::uint64_t(int)> fib;
+    auto memo = minpp::memoize<int>([&](int n) -> std::uint64_t { ++calls; return n < 2 ? n : fib(n - 1) + fib(n - 2); }, 128, 1);
+    fib = std::ref(memo);
+    if (memo(90) != 2880067194370816120ull || calls != 91) return 1;
+  }
+
+  {
+    try {
+      minpp::memoize(square, 0);
+      return 1;
+    }
+    catch (const std::invalid_argument&) {}
+
+    // a computation that throws caches nothing
+    int calls = 0;
+    auto f = minpp::memoize<int>([&](int x) { if (++calls == 1) throw std::runtime_error("first"); return x; }, 4);
+    try {
+      f(7);
+      return 1;
+    }
+    catch (const std::runtime_error&) {}
+    if (f(7) != 7 || f(7) != 7 || calls != 2) return 1;
+  }
+
+  {
+    std::atomic<int> calls{0};
+    auto f = minpp::memoize<int>([&](int x) { ++calls; return static_cast<long>(x) * x; }, 64, 8);
+    std::vector<std::thread> threads;
+    std::atomic<bool> ok{true};
+    for (int t = 0; t < 8; ++t) {
+      threads.emplace_back([&, t] {
+        for (int i = 0; i < 20000; ++i) {
+          const int x = (i * 7 + t) % 48;
+          if (f(x) != static_cast<long>(x) * x) ok = false;
+        }
+      });
+    }
+    for (auto& t: threads) t.join();
+    const minpp::memo_stats st = f.stats();
+    std::cout << calls << ' ' << st.hit_rate() << ' ' << st.evictions << std::endl;
+    if (!ok || st.hits + st.misses != 160000 || st.misses != static_cast<std::uint64_t>(calls.load()) || st.size > 64) return 1;
+  }
+}
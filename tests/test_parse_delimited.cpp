@@ -0,0 +1,72 @@
+#include "minpp/parse_delimited.h"
+
+#include <cstdint>
+#include <iostream>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using row = minpp::tuple<std::int64_t, double, std::string_view, bool, std::string>;
+using rows = minpp::delimited_rows<row>;
+
+static_assert(std::ranges::input_range<rows>);
+static_assert(std::is_same_v<std::ranges::range_value_t<rows>, row>);
+
+template <typename Tuple>
+bool throws(std::string_view input, char delimiter = ',') {
+  try {
+    for (const auto& r: minpp::parse_delimited<Tuple>(input, delimiter)) static_cast<void>(r);
+  }
+  catch (const std::invalid_argument& e) {
+    std::cout << e.what() << std::endl;
+    return true;
+  }
+  return false;
+}
+
+int main() {
+  {
+    const std::string input = "1,2.5,abc,true,x\r\n-7,1e3,,0,y\n\n42,-0.25,a longer field that spans the block boundary of sixty four bytes,1,z";
+    std::vector<row> parsed;
+    for (const auto& r: minpp::parse_delimited<row>(input)) parsed.push_back(r);
+    for (const auto& [i, d, sv, b, s]: parsed) std::cout << i << ' ' << d << ' ' << sv << ' ' << b << ' ' << s << std::endl;
+    if (parsed.size() != 3) return 1;
+    if (!(parsed[0] == row{1, 2.5, "abc", true, "x"}) || !(parsed[1] == row{-7, 1000.0, "", false, "y"})) return 1;
+    if (minpp::get<0>(parsed[2]) != 42 || minpp::get<4>(parsed[2]) != "z") return 1;
+
+    // string_view fields point into the input
+    const std::string_view sv = minpp::get<2>(parsed[0]);
+    if (sv.data() != input.data() + 6) return 1;
+  }
+
+  {
+    // many short fields, so that a block holds several rows, and a trailing newline
+    std::string input;
+    std::int64_t expected = 0;
+    for (int i = 0; i < 1000; ++i) {
+      input += std::to_string(i) + '\t' + std::to_string(i % 7) + '\n';
+      expected += i * (i % 7);
+    }
+    std::int64_t sum = 0;
+    std::size_t lines = 0;
+    auto parsed = minpp::parse_delimited<minpp::tuple<std::int64_t, int>>(input, '\t');
+    for (auto it = parsed.begin(); it != parsed.end(); ++it) {
+      sum += minpp::get<0>(*it) * minpp::get<1>(*it);
+      lines = it.line();
+    }
+    std::cout << sum << ' ' << lines << std::endl;
+    if (sum != expected || lines != 1000) return 1;
+  }
+
+  {
+    if (minpp::parse_delimited<row>("").begin() != std::default_sentinel) return 1;
+    if (!throws<minpp::tuple<int, int>>("1,2\n3\n")) return 1;
+    if (!throws<minpp::tuple<int, int>>("1,2,3\n")) return 1;
+    if (!throws<minpp::tuple<int, int>>("1,x\n")) return 1;
+    if (!throws<minpp::tuple<int, int>>("1,2 \n")) return 1;
+    if (!throws<minpp::tuple<bool>>("yes\n")) return 1;
+    if (throws<minpp::tuple<int, int>>("1;2\n", ';')) return 1;
+  }
+}
@@ -0,0 +1,81 @@
+#include "minpp/projection.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+using row = minpp::tuple<int, std::string, double, std::string>;
+
+int main() {
+  std::cout << std::boolalpha;
+
+  {
+    row r{1, "alpha", 2.5, "beta"};
+    auto v = minpp::select<3, 0>(r);
+    static_assert(std::tuple_size_v<decltype(v)> == 2);
+    static_assert(std::is_same_v<std::tuple_element_t<0, decltype(v)>, std::string&>);
+    static_assert(std::is_same_v<decltype(v)::materialized_type, minpp::tuple<std::string, int>>);
+    std::cout << (&minpp::get<0>(v) == &minpp::get<3>(r)) << std::endl;
+    if (&minpp::get<0>(v) != &minpp::get<3>(r)) return 1;
+
+    auto [s, i] = v;
+    s += "!";
+    i = 7;
+    std::cout << minpp::get<3>(r) << ' ' << minpp::get<0>(r) << std::endl;
+    if (minpp::get<3>(r) != "beta!" || minpp::get<0>(r) != 7) return 1;
+
+    const row& cr = r;
+    static_assert(std::is_same_v<decltype(minpp::get<0>(minpp::select<1>(cr))), const std::string&>);
+
+    if (v.materialize() != minpp::tuple<std::string, int>{"beta!", 7}) return 1;
+    if (!(v == minpp::tuple<std::string, int>{"beta!", 7})) return 1;
+    if (!(minpp::tuple<std::string, int>{"beta!", 8} > v)) return 1;
+  }
+
+  {
+    // int& elements stay references through the view
+    int x = 3;
+    minpp::tuple<int&, long> t{x, 4L};
+    static_assert(std::is_same_v<std::tuple_element_t<0, minpp::tuple<int&, long>>, int&>);
+    const auto& ct = t;
+    auto v = minpp::select<0>(ct);
+    minpp::get<0>(v) = 9;
+    if (x != 9) return 1;
+  }
+
+  {
+    row a{1, "b", 0.0, "x"};
+    row b{2, "a", 0.0, "x"};
+    std::cout << ((minpp::select<1, 0>(a) <=> minpp::select<1, 0>(b)) > 0) << std::endl;
+    if (!((minpp::select<1, 0>(a) <=> minpp::select<1, 0>(b)) > 0)) return 1;
+    if (!(minpp::select<2, 3>(a) == minpp::select<2, 3>(b))) return 1;
+
+    std::tuple<std::string, int> st{"b", 1};
+    if (!(minpp::select<1, 0>(a) == minpp::select<0, 1>(st))) return 1;
+  }
+
+  {
+    std::vector<row> rows{
+      {3, "c", 1.0, "k"}, {1, "a", 2.0, "k"}, {2, "b", 1.0, "j"}, {4, "a", 1.0, "j"}
+    };
+    std::sort(rows.begin(), rows.end(), minpp::compare_by<3, 2, 0>{});
+    std::vector<int> order;
+    for (const auto& r: rows) order.push_back(minpp::get<0>(r));
+    for (int o: order) std::cout << o << ' ';
+    std::cout << std::endl;
+    if (order != std::vector<int>{2, 4, 3, 1}) return 1;
+
+    std::unordered_set<const row*, decltype([](const row* r) { return minpp::hash_by<3>{}(*r); }),
+      decltype([](const row* a, const row* b) { return minpp::equal_by<3>{}(*a, *b); })> groups;
+    for (const auto& r: rows) groups.insert(&r);
+    std::cout << groups.size() << std::endl;
+    if (groups.size() != 2) return 1;
+
+    const row& r = rows.front();
+    if (minpp::hash_by<3, 0>{}(r) != std::hash<minpp::tuple<std::string, int>>{}(minpp::select<3, 0>(r).materialize())) return 1;
+    if (std::hash<decltype(minpp::select<3, 0>(r))>{}(minpp::select<3, 0>(r)) != minpp::hash_by<3, 0>{}(r)) return 1;
+  }
+}
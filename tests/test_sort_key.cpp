@@ -0,0 +1,90 @@
+#include "minpp/sort_key.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using row = minpp::tuple<std::int32_t, double, std::string, std::uint16_t>;
+using spec = minpp::descending_columns<3>;
+
+// reference ordering: operator<=> with column 3 reversed
+std::partial_ordering expected_order(const row& a, const row& b) {
+  const minpp::tuple<std::int32_t, double, std::string> ha{minpp::get<0>(a), minpp::get<1>(a), minpp::get<2>(a)};
+  const minpp::tuple<std::int32_t, double, std::string> hb{minpp::get<0>(b), minpp::get<1>(b), minpp::get<2>(b)};
+  if (auto c = ha <=> hb; c != 0) return c;
+  return minpp::get<3>(b) <=> minpp::get<3>(a);
+}
+
+int sign_of(int v) { return (v > 0) - (v < 0); }
+
+int main() {
+  std::cout << std::boolalpha;
+  std::mt19937 gen{1234};
+
+  const std::string alphabet{"\0\1ab\xff", 5};
+  auto random_row = [&] {
+    std::string s;
+    for (auto n = gen() % 4; n > 0; --n) s.push_back(alphabet[gen() % alphabet.size()]);
+    const double doubles[] = {-1.5, -0.0, 0.0, 1e-300, 2.5, -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity()};
+    return row{static_cast<std::int32_t>(gen() % 5) - 2, doubles[gen() % 7], s, static_cast<std::uint16_t>(gen() % 3)};
+  };
+
+  std::vector<row> rows;
+  for (int i = 0; i < 500; ++i) rows.push_back(random_row());
+  rows.push_back(row{std::numeric_limits<std::int32_t>::min(), 0.0, "", std::uint16_t{0}});
+  rows.push_back(row{std::numeric_limits<std::int32_t>::max(), 0.0, "", std::uint16_t{0xffff}});
+
+  std::vector<std::string> keys;
+  for (const auto& r: rows) {
+    std::string key;
+    minpp::encode_sort_key(r, key, spec{});
+    keys.push_back(key);
+  }
+
+  int mismatches = 0;
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    for (std::size_t j = 0; j < rows.size(); ++j) {
+      const auto expected = expected_order(rows[i], rows[j]);
+      const int actual = sign_of(keys[i].compare(keys[j]));
+      if (actual != (expected < 0 ? -1 : expected > 0 ? 1 : 0)) ++mismatches;
+    }
+  }
+  std::cout << "order mismatches: " << mismatches << std::endl;
+  if (mismatches) return 1;
+
+  int roundtrip_failures = 0;
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    if (minpp::decode_sort_key<row>(keys[i], spec{}) != rows[i]) ++roundtrip_failures;
+  }
+  std::cout << "roundtrip failures: " << roundtrip_failures << std::endl;
+  if (roundtrip_failures) return 1;
+
+  {
+    std::vector<unsigned char> buffer;
+    std::vector<std::size_t> offsets;
+    minpp::encode_sort_keys(rows.begin(), rows.end(), buffer, offsets, spec{});
+    bool same = offsets.size() == rows.size() + 1;
+    for (std::size_t i = 0; same && i < rows.size(); ++i) {
+      same = std::string(buffer.begin() + offsets[i], buffer.begin() + offsets[i + 1]) == keys[i];
+    }
+    std::cout << same << std::endl;
+    if (!same) return 1;
+  }
+
+  {
+    bool thrown = false;
+    try {
+      minpp::decode_sort_key<row>(std::string_view{keys[0]}.substr(0, keys[0].size() - 1), spec{});
+    }
+    catch (const std::invalid_argument&) {
+      thrown = true;
+    }
+    std::cout << thrown << std::endl;
+    if (!thrown) return 1;
+  }
+}
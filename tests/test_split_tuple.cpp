@@ -0,0 +1,111 @@
+#include "minpp/split_tuple.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using record = minpp::split_tuple<minpp::hot<std::uint64_t, double>, minpp::cold<std::string, int, std::pmr::string>>;
+
+static_assert(std::tuple_size_v<record> == 5);
+static_assert(std::is_same_v<std::tuple_element_t<1, record>, double>);
+static_assert(std::is_same_v<std::tuple_element_t<4, record>, std::pmr::string>);
+static_assert(std::is_same_v<decltype(minpp::get<2>(std::declval<record&>())), std::string&>);
+static_assert(std::is_same_v<decltype(minpp::get<0>(std::declval<const record&>())), const std::uint64_t&>);
+static_assert(std::is_same_v<decltype(minpp::get<3>(std::declval<record&&>())), int&&>);
+static_assert(sizeof(record) == sizeof(minpp::tuple<std::uint64_t, double>) + sizeof(void*));
+static_assert(std::uses_allocator_v<record, std::pmr::polymorphic_allocator<>>);
+
+// hot fields anywhere in the declaration keep their indices
+using flat = minpp::tuple<std::string, std::uint64_t, int, double, std::string>;
+using scattered = minpp::split_tuple<flat, minpp::hot_at<1, 3>>;
+
+static_assert(std::is_same_v<scattered::hot_type, minpp::tuple<std::uint64_t, double>>);
+static_assert(std::is_same_v<scattered::cold_type, minpp::tuple<std::string, int, std::string>>);
+static_assert(std::tuple_size_v<scattered> == 5);
+static_assert(std::is_same_v<std::tuple_element_t<3, scattered>, double>);
+static_assert(std::is_same_v<decltype(minpp::get<1>(std::declval<scattered&>())), std::uint64_t&>);
+static_assert(std::is_same_v<decltype(minpp::get<2>(std::declval<const scattered&>())), const int&>);
+static_assert(sizeof(scattered) == sizeof(minpp::tuple<std::uint64_t, double>) + sizeof(void*));
+static_assert(std::is_same_v<minpp::split_tuple<minpp::hot<int>, minpp::cold<double>>::record_type, minpp::tuple<int, double>>);
+
+int main() {
+  std::cout << std::boolalpha;
+
+  {
+    record r{1u, 2.5, "name", 3, "note"};
+    auto& [id, score, name, count, note] = r;
+    std::cout << id << ' ' << score << ' ' << name << ' ' << count << ' ' << note << std::endl;
+    if (id != 1 || score != 2.5 || name != "name" || count != 3 || note != "note") return 1;
+    if (&minpp::get<0>(r) != &minpp::get<0>(r.hot_fields()) || &minpp::get<2>(r) != &minpp::get<0>(r.cold_fields())) return 1;
+
+    name += "!";
+    const auto total = minpp::apply([](std::uint64_t i, double s, const std::string& n, int c, const std::pmr::string&) {
+      return static_cast<double>(i) + s + static_cast<double>(n.size()) + c;
+    }, r);
+    std::cout << total << std::endl;
+    if (total != 11.5) return 1;
+
+    record copy = r;
+    if (!(copy == r) || &minpp::get<2>(copy) == &minpp::get<2>(r)) return 1;
+    minpp::get<3>(copy) = 4;
+    if (!(r < copy) || !(r == minpp::tuple<std::uint64_t, double, std::string, int, std::pmr::string>{1u, 2.5, "name!", 3, "note"})) return 1;
+    if (!((copy <=> minpp::tuple<std::uint64_t, double, std::string, int, std::pmr::string>{1u, 2.5, "name!", 3, "note"}) > 0)) return 1;
+
+    record moved = std::move(copy);
+    copy = r;
+    if (minpp::get<3>(moved) != 4 || !(copy == r)) return 1;
+    swap(copy, moved);
+    if (minpp::get<3>(copy) != 4 || minpp::get<3>(moved) != 3) return 1;
+  }
+
+  {
+    // cold blocks and their pmr fields come from the arena
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::vector<record> rows{&arena};
+    for (std::uint64_t i = 0; i < 100; ++i) rows.emplace_back(i, 0.5, std::string(40, 'x'), 1, std::pmr::string(40, 'y'));
+    bool same_arena = true;
+    for (const auto& r: rows) same_arena = same_arena && r.get_allocator().resource() == &arena && minpp::get<4>(r).get_allocator().resource() == &arena;
+    std::cout << same_arena << std::endl;
+    if (!same_arena) return 1;
+
+    double hot_sum = 0;
+    for (const auto& r: rows) hot_sum += static_cast<double>(minpp::get<0>(r)) * minpp::get<1>(r);
+    if (hot_sum != 2475) return 1;
+
+    record on_heap{minpp::tuple<std::uint64_t, double, std::string, int, std::pmr::string>{7u, 1.0, "a", 2, "b"}};
+    rows.front() = on_heap;
+    if (rows.front().get_allocator().resource() != &arena || !(rows.front() == on_heap)) return 1;
+    rows.front() = std::move(on_heap);
+    if (rows.front().get_allocator().resource() != &arena || minpp::get<0>(rows.front()) != 7) return 1;
+  }
+
+  {
+    scattered r{"name", 7u, 3, 0.5, "note"};
+    auto& [name, id, count, score, note] = r;
+    if (name != "name" || id != 7 || count != 3 || score != 0.5 || note != "note") return 1;
+    if (&minpp::get<1>(r) != &minpp::get<0>(r.hot_fields()) || &minpp::get<3>(r) != &minpp::get<1>(r.hot_fields())) return 1;
+    if (&minpp::get<0>(r) != &minpp::get<0>(r.cold_fields()) || &minpp::get<4>(r) != &minpp::get<2>(r.cold_fields())) return 1;
+
+    // apply and comparisons go in declaration order, so a cold field can decide an ordering
+    const std::string joined = minpp::apply([](const std::string& n, std::uint64_t i, int c, double, const std::string& m) {
+      return n + std::to_string(i) + std::to_string(c) + m;
+    }, r);
+    if (joined != "name73note") return 1;
+    const scattered before{"a", 9u, 9, 9.0, "z"};
+    if (!(before < r) || !(r == flat{"name", 7u, 3, 0.5, "note"}) || !((r <=> flat{"name", 7u, 3, 0.5, "nots"}) < 0)) return 1;
+
+    const scattered copy{flat{"name", 7u, 3, 0.5, "note"}};
+    if (!(copy == r)) return 1;
+  }
+
+  {
+    minpp::split_tuple<minpp::hot<>, minpp::cold<int>> only_cold{5};
+    minpp::split_tuple<minpp::hot<int>, minpp::cold<>> only_hot{6};
+    if (minpp::get<0>(only_cold) != 5 || minpp::get<0>(only_hot) != 6) return 1;
+    auto copy = only_cold;
+    if (!(copy == only_cold)) return 1;
+  }
+}
@@ -0,0 +1,46 @@
+#include "minpp/tuple.h"
+
+#include <array>
+#include <iostream>
+#include <type_traits>
+
+template <minpp::tuple Cfg>
+struct column_layout {
+  static constexpr auto config = Cfg;
+  static constexpr std::size_t columns = std::tuple_size_v<decltype(Cfg)>;
+};
+
+template <minpp::tuple<int, int> Key>
+constexpr int key_sum() {
+  return minpp::get<0>(Key) + minpp::get<1>(Key);
+}
+
+template <minpp::tuple Cfg>
+int scaled(int v) {
+  return v * minpp::get<0>(Cfg) + minpp::get<1>(Cfg);
+}
+
+int main() {
+  std::cout << std::boolalpha;
+
+  // class template argument deduction of the placeholder
+  using layout = column_layout<minpp::tuple{4, 'x', 2.5}>;
+  static_assert(std::is_same_v<std::remove_const_t<decltype(layout::config)>, minpp::tuple<int, char, double>>);
+  static_assert(layout::columns == 3);
+  static_assert(minpp::get<1>(layout::config) == 'x');
+
+  // template argument equivalence is element-wise
+  static_assert(std::is_same_v<column_layout<minpp::tuple{1, 2}>, column_layout<minpp::tuple<int, int>{1, 2}>>);
+  static_assert(!std::is_same_v<column_layout<minpp::tuple{1, 2}>, column_layout<minpp::tuple{2, 1}>>);
+
+  static_assert(key_sum<{20, 22}>() == 42);
+
+  // nested tuples and arrays are structural as well
+  using nested = column_layout<minpp::tuple{minpp::tuple{1, 2u}, std::array<short, 2>{3, 4}}>;
+  static_assert(minpp::get<1>(minpp::get<0>(nested::config)) == 2u);
+  static_assert(minpp::get<1>(nested::config)[1] == 4);
+
+  const int r = scaled<minpp::tuple{3, 1}>(5);
+  std::cout << r << std::endl;
+  if (r != 16) return 1;
+}
@@ -0,0 +1,95 @@
+#include "minpp/tuple_interner.h"
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+using key_interner = minpp::tuple_interner<std::string_view, std::uint32_t, std::uint16_t>;
+
+static_assert(std::is_same_v<key_interner::id_type, std::uint32_t>);
+static_assert(std::is_same_v<decltype(std::declval<const key_interner&>()[0]), const minpp::tuple<std::string_view, std::uint32_t, std::uint16_t>&>);
+
+int main() {
+  {
+    key_interner in;
+    std::string buf = "checkout";
+    const auto a = in.intern(buf, 7, 1);
+    const auto b = in.intern("checkout", 7, 2);
+    const auto c = in.intern(std::string_view{buf}, 7, 1);
+    std::cout << a << ' ' << b << ' ' << c << std::endl;
+    if (a != 0 || b != 1 || c != 0 || in.size() != 2) return 1;
+
+    // the characters are copied: the stored view does not point to the caller's buffer
+    buf = "xxxxxxxx";
+    if (minpp::get<0>(in[a]) != "checkout" || minpp::get<0>(in[a]).data() == buf.data()) return 1;
+    if (in.string_bytes() != 16) return 1;
+
+    if (in.find("checkout", 7, 2) != b || in.find("checkout", 8, 2) || in.size() != 2) return 1;
+    if (in.intern(minpp::tuple<std::string_view, std::uint32_t, std::uint16_t>{"checkout", 7u, std::uint16_t{2}}) != b) return 1;
+    try {
+      in.at(2);
+      return 1;
+    }
+    catch (const std::out_of_range&) {}
+  }
+
+  {
+    // ids are dense, and references to interned tuples survive growth
+    minpp::tuple_interner<int, std::string> in;
+    const auto& first = in[in.intern(-1, "first")];
+    for (int i = 0; i < 100000; ++i) {
+      if (in.intern(i, std::to_string(i % 1000)) != static_cast<std::uint32_t>(i + 1)) return 1;
+    }
+    for (int i = 0; i < 100000; i += 997) {
+      if (in.intern(i, std::to_string(i % 1000)) != static_cast<std::uint32_t>(i + 1)) return 1;
+      if (!(in[static_cast<std::uint32_t>(i + 1)] == minpp::tuple<int, std::string>{i, std::to_string(i % 1000)})) return 1;
+    }
+    if (&first != &in[0] || minpp::get<1>(first) != "first" || in.size() != 100001) return 1;
+  }
+
+  {
+    // batch interning takes any tuple-like elements, converting to the interned types
+    key_interner in;
+    const auto pre = in.intern("b", 2, 0);
+    std::vector<std::tuple<std::string, std::uint32_t, std::uint16_t>> rows{{"a", 1, 0}, {"b", 2, 0}, {"a", 1, 0}, {"c", 3, 0}};
+    std::vector<std::uint32_t> ids;
+    in.intern_all(rows.begin(), rows.end(), std::back_inserter(ids));
+    if (ids != std::vector<std::uint32_t>{1, pre, 1, 2} || in.size() != 3 || minpp::get<0>(in[2]) != "c") return 1;
+  }
+
+  {
+    minpp::concurrent_tuple_interner<std::string_view, std::uint32_t> in;
+    std::vector<std::string> names;
+    for (int i = 0; i < 500; ++i) names.push_back("name-" + std::to_string(i));
+    std::vector<std::vector<std::uint32_t>> seen(8);
+    std::atomic<bool> ok{true};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+      threads.emplace_back([&, t] {
+        for (int i = 0; i < 5000; ++i) {
+          const int k = (i * 13 + t * 7) % 2000;
+          const std::uint32_t id = in.intern(names[k % 500], static_cast<std::uint32_t>(k / 500));
+          const auto& stored = in[id];
+          if (minpp::get<0>(stored) != names[k % 500] || minpp::get<1>(stored) != static_cast<std::uint32_t>(k / 500)) ok = false;
+        }
+        std::vector<minpp::tuple<std::string_view, std::uint32_t>> batch;
+        for (int k = 0; k < 2000; ++k) batch.emplace_back(names[k % 500], static_cast<std::uint32_t>(k / 500));
+        in.intern_all(batch.begin(), batch.end(), std::back_inserter(seen[t]));
+      });
+    }
+    for (auto& t: threads) t.join();
+    std::cout << in.size() << std::endl;
+    if (!ok || in.size() != 2000) return 1;
+    for (int t = 1; t < 8; ++t) {
+      if (seen[t] != seen[0]) return 1;
+    }
+  }
+}
@@ -0,0 +1,87 @@
+#include "minpp/tuple_pool.h"
+
+#include <cstdint>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct throws_on_negative {
+  int v;
+  explicit throws_on_negative(int x): v{x} {
+    if (x < 0) throw std::invalid_argument("negative");
+  }
+};
+
+int main() {
+  std::cout << std::boolalpha;
+
+  {
+    using pool_type = minpp::tuple_pool<std::int64_t, std::string>;
+    pool_type pool{16, 4};
+    pool_type::local_cache cache{pool};
+
+    std::vector<pool_type::value_type*> rows;
+    for (int i = 0; i < 40; ++i) rows.push_back(cache.emplace(i, std::string(32, static_cast<char>('a' + i % 26))));
+    std::cout << pool.slab_count() << std::endl;
+    if (pool.slab_count() != 3) return 1;
+    for (auto* r: rows) {
+      if (reinterpret_cast<std::uintptr_t>(r) % alignof(pool_type::value_type) != 0) return 1;
+    }
+    if (minpp::get<0>(*rows[39]) != 39 || minpp::get<1>(*rows[39])[0] != 'a' + 39 % 26) return 1;
+
+    std::set<pool_type::value_type*> distinct(rows.begin(), rows.end());
+    if (distinct.size() != rows.size()) return 1;
+
+    for (auto* r: rows) cache.destroy(r);
+    rows.clear();
+    // freed slots are reused before any new slab is carved
+    for (int i = 0; i < 40; ++i) rows.push_back(cache.emplace(i, "x"));
+    if (pool.slab_count() != 3) return 1;
+    for (auto* r: rows) cache.destroy(r);
+  }
+
+  {
+    // a throwing constructor returns the slot
+    minpp::tuple_pool<throws_on_negative> pool{1};
+    minpp::tuple_pool<throws_on_negative>::local_cache cache{pool};
+    bool caught = false;
+    try {
+      cache.emplace(-1);
+    }
+    catch (const std::invalid_argument&) {
+      caught = true;
+    }
+    auto* r = cache.emplace(5);
+    std::cout << caught << ' ' << pool.slab_count() << std::endl;
+    if (!caught || pool.slab_count() != 1 || minpp::get<0>(*r).v != 5) return 1;
+    cache.destroy(r);
+  }
+
+  {
+    // rows allocated on one thread and freed on another travel through the global list
+    minpp::tuple_pool<int, double> pool{64, 8};
+    std::vector<minpp::tuple<int, double>*> handoff;
+    std::thread producer{[&] {
+      minpp::tuple_pool<int, double>::local_cache cache{pool};
+      for (int i = 0; i < 1000; ++i) handoff.push_back(cache.emplace(i, i * 0.5));
+    }};
+    producer.join();
+    long long sum = 0;
+    std::thread consumer{[&] {
+      minpp::tuple_pool<int, double>::local_cache cache{pool};
+      for (auto* r: handoff) {
+        sum += minpp::get<0>(*r);
+        cache.destroy(r);
+      }
+    }};
+    consumer.join();
+    const std::size_t slabs = pool.slab_count();
+    minpp::tuple_pool<int, double>::local_cache cache{pool};
+    for (int i = 0; i < 1000; ++i) cache.destroy(cache.emplace(i, 0.0));
+    std::cout << sum << ' ' << slabs << ' ' << pool.slab_count() << std::endl;
+    if (sum != 999 * 1000 / 2 || pool.slab_count() != slabs) return 1;
+  }
+}
@@ -0,0 +1,162 @@
+#include "minpp/tuple_ring.h"
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// counts copies and moves, and live objects so the rings can be checked for leaks
+struct tracked {
+  static inline int live = 0;
+  static inline int moves = 0;
+  static inline int copies = 0;
+
+  int id;
+
+  explicit tracked(int i) noexcept: id{i} { ++live; }
+  tracked(const tracked& o) noexcept: id{o.id} { ++live; ++copies; }
+  tracked(tracked&& o) noexcept: id{o.id} { ++live; ++moves; }
+  ~tracked() { --live; }
+};
+
+// a constructor that can throw, and a move that cannot
+struct fallible {
+  int id;
+
+  explicit fallible(int i): id{i} {
+    if (i < 0) throw i;
+  }
+  fallible(fallible&&) noexcept = default;
+};
+
+}
+
+int main() {
+  std::cout << std::boolalpha;
+
+  {
+    minpp::spsc_tuple_ring<int, std::string, tracked> ring{3};
+    std::cout << ring.capacity() << std::endl;
+    if (ring.capacity() != 4) return 1;
+
+    for (int i = 0; i < 4; ++i) {
+      if (!ring.try_emplace(i, std::string(i + 1, 'x'), i * 10)) return 1;
+    }
+    if (ring.try_emplace(4, "full", 40)) return 1;
+    std::cout << tracked::live << ' ' << tracked::moves << ' ' << tracked::copies << std::endl;
+    if (tracked::live != 4 || tracked::moves != 0 || tracked::copies != 0) return 1;
+
+    std::vector<int> seen;
+    const std::size_t popped = ring.try_pop_n(3, [&](int i, std::string s, const tracked& t) {
+      if (s.size() != static_cast<std::size_t>(i + 1) || t.id != i * 10) seen.push_back(-1);
+      seen.push_back(i);
+    });
+    for (int i: seen) std::cout << i << ' ';
+    std::cout << std::endl;
+    if (popped != 3 || seen != std::vector<int>{0, 1, 2} || tracked::live != 1) return 1;
+
+    if (!ring.try_emplace(5, "y", 50)) return 1;
+    // the destructor releases the two messages that are left
+  }
+  if (tracked::live != 0) return 1;
+
+  {
+    minpp::spsc_tuple_ring<std::uint64_t> ring{64};
+    constexpr std::uint64_t count = 200000;
+    std::thread producer{[&] {
+      for (std::uint64_t i = 0; i < count; ++i) {
+        while (!ring.try_emplace(i)) std::this_thread::yield();
+      }
+    }};
+    std::uint64_t expected = 0;
+    bool in_order = true;
+    while (expected < count) {
+      if (!ring.try_pop_n(16, [&](std::uint64_t v) { in_order = in_order && v == expected++; })) std::this_thread::yield();
+    }
+    producer.join();
+    std::cout << in_order << std::endl;
+    if (!in_order) return 1;
+  }
+
+  {
+    minpp::mpmc_tuple_ring<int, tracked> ring{4};
+    for (int i = 0; i < 4; ++i) {
+      if (!ring.try_emplace(i, i)) return 1;
+    }
+    if (ring.try_emplace(4, 4)) return 1;
+    if (tracked::moves != 0 || tracked::copies != 0) return 1;
+    int sum = 0;
+    if (ring.try_pop_n(8, [&](int i, tracked t) { sum += i + t.id; }) != 4 || sum != 12) return 1;
+    if (ring.try_pop_n(8, [](int, tracked) {}) != 0) return 1;
+
+    // a throwing constructor builds the message before a slot is claimed
+    minpp::mpmc_tuple_ring<std::string, int> strings{2};
+    if (!strings.try_emplace("abc", 1)) return 1;
+    bool thrown = false;
+    try {
+      strings.try_emplace(std::string("abc"), 1);
+      strings.try_pop_n(1, [](std::string, int) { throw 1; });
+    }
+    catch (int) {
+      thrown = true;
+    }
+    if (!thrown || strings.try_pop_n(2, [](std::string, int) {}) != 1) return 1;
+
+    ring.try_emplace(1, 1);
+  }
+  if (tracked::live != 0) return 1;
+
+  {
+    // with a throwing constructor a failed try_emplace leaves the ring as it was, and a failed try_push
+    // leaves the message with the caller
+    using message = minpp::tuple<std::string, fallible>;
+    minpp::mpmc_tuple_ring<std::string, fallible> ring{2};
+    bool thrown = false;
+    try {
+      ring.try_emplace("bad", -1);
+    }
+    catch (int) {
+      thrown = true;
+    }
+    if (!thrown || ring.try_pop_n(2, [](std::string, fallible) {}) != 0) return 1;
+    if (!ring.try_emplace("first", 1) || !ring.try_push(message{"second", fallible{2}})) return 1;
+    message m{"a message long enough to allocate", fallible{3}};
+    if (ring.try_emplace("third", 3) || ring.try_push(std::move(m))) return 1;
+    if (minpp::get<0>(m) != "a message long enough to allocate" || minpp::get<1>(m).id != 3) return 1;
+    int ids = 0;
+    if (ring.try_pop_n(1, [&](std::string, fallible f) { ids = ids * 10 + f.id; }) != 1 || !ring.try_push(std::move(m))) return 1;
+    if (ring.try_pop_n(2, [&](std::string, fallible f) { ids = ids * 10 + f.id; }) != 2 || ids != 123) return 1;
+  }
+
+  {
+    minpp::mpmc_tuple_ring<std::uint32_t, std::uint64_t> ring{128};
+    constexpr std::uint32_t producers = 4;
+    constexpr std::uint64_t per_producer = 50000;
+    std::atomic<std::uint64_t> total = 0;
+    std::atomic<std::uint64_t> received = 0;
+    std::vector<std::thread> threads;
+    for (std::uint32_t p = 0; p < producers; ++p) {
+      threads.emplace_back([&, p] {
+        for (std::uint64_t i = 1; i <= per_producer; ++i) {
+          while (!ring.try_emplace(p, i)) std::this_thread::yield();
+        }
+      });
+    }
+    for (int c = 0; c < 2; ++c) {
+      threads.emplace_back([&] {
+        while (received.load() < producers * per_producer) {
+          const std::size_t n = ring.try_pop_n(32, [&](std::uint32_t, std::uint64_t v) { total += v; });
+          if (n) received += n;
+          else std::this_thread::yield();
+        }
+      });
+    }
+    for (auto& t: threads) t.join();
+    std::cout << total << std::endl;
+    if (total != producers * per_producer * (per_producer + 1) / 2) return 1;
+  }
+}
@@ -0,0 +1,99 @@
+#include "minpp/visit.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+
+template <std::size_t... Is>
+constexpr auto iota_tuple(std::index_sequence<Is...>) {
+  return minpp::tuple<decltype(Is)...>{Is...};
+}
+
+struct to_string {
+  std::string operator()(int v) const { return "int " + std::to_string(v); }
+  std::string operator()(double v) const { return "double " + std::to_string(static_cast<int>(v)); }
+  std::string operator()(const std::string& v) const { return "string " + v; }
+};
+
+int main() {
+  std::cout << std::boolalpha;
+
+  {
+    minpp::tuple<int, double, std::string> t{1, 2.0, "three"};
+    for (std::size_t i = 0; i < 3; ++i) std::cout << minpp::visit_at(t, i, to_string{}) << std::endl;
+    if (minpp::visit_at(t, 2, to_string{}) != "string three") return 1;
+
+    // lvalue access writes through
+    for (std::size_t i: {0, 2}) minpp::visit_at(t, i, [](auto& v) { v = std::remove_reference_t<decltype(v)>{}; });
+    if (minpp::get<0>(t) != 0 || !minpp::get<2>(t).empty()) return 1;
+
+    // rvalue tuples hand out rvalue elements
+    minpp::tuple<std::string, std::string> owned{"a", std::string(40, 'b')};
+    std::string moved = minpp::visit_at(std::move(owned), 1, [](auto&& v) { return std::string(std::forward<decltype(v)>(v)); });
+    if (moved.size() != 40) return 1;
+
+    bool caught = false;
+    try {
+      minpp::visit_at(t, 3, to_string{});
+    }
+    catch (const std::out_of_range&) {
+      caught = true;
+    }
+    std::cout << caught << std::endl;
+    if (!caught) return 1;
+  }
+
+  {
+    // 64 elements, the most that dispatch through the chain of comparisons
+    auto t = iota_tuple(std::make_index_sequence<64>{});
+    std::size_t sum = 0;
+    for (std::size_t i = 0; i < 64; ++i) sum += minpp::visit_at(t, i, [](std::size_t v) { return v; });
+    std::cout << sum << std::endl;
+    if (sum != 64 * 63 / 2) return 1;
+
+    auto u = iota_tuple(std::make_index_sequence<64>{});
+    const bool all_equal = [&] {
+      for (std::size_t i = 0; i < 64; ++i) {
+        if (!minpp::visit_at(t, u, i, [](std::size_t a, std::size_t b) { return a == b; })) return false;
+      }
+      return true;
+    }();
+    if (!all_equal) return 1;
+  }
+
+  {
+    // beyond _visit_at_chain_limit the table of function pointers dispatches
+    constexpr std::size_t n = 100;
+    auto t = iota_tuple(std::make_index_sequence<n>{});
+    for (std::size_t i: {std::size_t{0}, n / 2, n - 1}) {
+      if (minpp::visit_at(t, i, [](std::size_t v) { return v; }) != i) return 1;
+    }
+    minpp::visit_at(t, n - 1, [](std::size_t& v) { v = 0; });
+    if (minpp::get<n - 1>(t) != 0 || minpp::get<n / 2>(t) != n / 2) return 1;
+
+    const auto u = iota_tuple(std::make_index_sequence<n>{});
+    if (minpp::visit_at(t, u, n / 2, [](std::size_t a, std::size_t b) { return a + b; }) != n) return 1;
+
+    bool caught = false;
+    try {
+      minpp::visit_at(t, n, [](std::size_t v) { return v; });
+    }
+    catch (const std::out_of_range&) {
+      caught = true;
+    }
+    if (!caught) return 1;
+  }
+
+  {
+    // binary form pairs the ith elements; std::tuple works as well
+    minpp::tuple<int, double> a{1, 2.5};
+    std::tuple<long, float> b{10, 0.5f};
+    const double r = minpp::visit_at(a, b, 1, [](auto x, auto y) { return static_cast<double>(x + y); });
+    std::cout << r << std::endl;
+    if (r != 3.0) return 1;
+  }
+
+  static_assert(minpp::visit_at(minpp::tuple<int, long, int>{1, 2, 3}, 1, [](auto v) { return static_cast<int>(v) * 2; }) == 4);
+}
@@ -0,0 +1,90 @@
+#include "minpp/when_all.h"
+
+#include <atomic>
+#include <coroutine>
+#include <iostream>
+#include <memory_resource>
+#include <semaphore>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+struct detached_task {
+  struct promise_type {
+    detached_task get_return_object() noexcept { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+detached_task fan_out(minpp::thread_pool& pool, int& out, std::binary_semaphore& done) {
+  auto [a, b] = co_await minpp::when_all_async(pool, [] { return 20; }, [] { return 22; });
+  out = a + b;
+  done.release();
+}
+
+int main() {
+  std::cout << std::boolalpha;
+  minpp::thread_pool pool{2};
+
+  {
+    int shared = 7;
+    auto r = minpp::when_all(pool,
+      [] { return 1; },
+      [] { return std::string(40, 'x'); },
+      [] {},
+      [&]() -> int& { return shared; }
+    );
+    static_assert(std::is_same_v<decltype(r), minpp::tuple<int, std::string, std::monostate, int&>>);
+    std::cout << minpp::get<0>(r) << ' ' << minpp::get<1>(r).size() << ' ' << (&minpp::get<3>(r) == &shared) << std::endl;
+    if (minpp::get<0>(r) != 1 || minpp::get<1>(r).size() != 40 || &minpp::get<3>(r) != &shared) return 1;
+  }
+
+  {
+    // nested fan-out from inside the pool must not deadlock even when every worker waits
+    auto r = minpp::when_all(pool,
+      [&] { return minpp::get<0>(minpp::when_all(pool, [] { return 1; }, [] { return 2; })); },
+      [&] { return minpp::get<1>(minpp::when_all(pool, [] { return 3; }, [] { return 4; })); },
+      [&] { return minpp::get<0>(minpp::when_all(pool, [] { return 5; }, [] { return 6; })); }
+    );
+    std::cout << minpp::get<0>(r) << ' ' << minpp::get<1>(r) << ' ' << minpp::get<2>(r) << std::endl;
+    if (r != minpp::tuple<int, int, int>{1, 4, 5}) return 1;
+  }
+
+  {
+    std::atomic<int> finished = 0;
+    bool caught = false;
+    try {
+      minpp::when_all(pool,
+        [&] { ++finished; return 0; },
+        [&]() -> int { ++finished; throw std::runtime_error("second"); },
+        [&]() -> int { ++finished; throw std::logic_error("third"); }
+      );
+    }
+    catch (const std::runtime_error& e) {
+      caught = true;
+      std::cout << e.what() << std::endl;
+    }
+    std::cout << caught << ' ' << finished << std::endl;
+    if (!caught || finished != 3) return 1;
+  }
+
+  {
+    std::pmr::monotonic_buffer_resource mr;
+    std::pmr::polymorphic_allocator<> a{&mr};
+    auto r = minpp::when_all(std::allocator_arg, a, pool, [] { return std::pmr::string(64, 'y'); }, [] { return 2; });
+    std::cout << (minpp::get<0>(r).get_allocator().resource() == &mr) << std::endl;
+    if (minpp::get<0>(r).get_allocator().resource() != &mr) return 1;
+  }
+
+  {
+    int out = 0;
+    std::binary_semaphore done{0};
+    fan_out(pool, out, done);
+    done.acquire();
+    std::cout << out << std::endl;
+    if (out != 42) return 1;
+  }
+}
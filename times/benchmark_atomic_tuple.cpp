@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include "minpp/atomic_tuple.h"
+
+#include <cstdint>
+#include <mutex>
+
+#include "perf_counters.h"
+
+/*
+Read-mostly shared state: every thread reads the tuple, thread 0 also stores a new value every 64 reads.
+A mutex-protected tuple against minpp::atomic_tuple for an 8-byte tuple (std::atomic), a 16-byte tuple
+(cmpxchg16b when built with -mcx16, otherwise the sequence lock) and a 40-byte tuple (sequence lock).
+*/
+
+namespace {
+
+using small = minpp::tuple<std::uint32_t, std::uint32_t>;
+using state16 = minpp::tuple<std::uint32_t, std::uint32_t, std::uint64_t>;
+using large = minpp::tuple<std::uint64_t, std::uint64_t, std::uint64_t, std::uint64_t, std::uint64_t>;
+
+template <typename T>
+struct locked {
+  T load() {
+    std::lock_guard lk{mutex};
+    return value;
+  }
+
+  void store(const T& v) {
+    std::lock_guard lk{mutex};
+    value = v;
+  }
+
+  std::mutex mutex;
+  T value{};
+};
+
+template <typename Shared>
+void read_mostly(benchmark::State& state, Shared& shared) {
+  std::uint64_t n = 0;
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    if (state.thread_index() == 0 && (++n & 63) == 0) {
+      auto v = shared.load();
+      ++minpp::get<0>(v);
+      shared.store(v);
+    }
+    auto v = shared.load();
+    benchmark::DoNotOptimize(v);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename T>
+void BM_mutex(benchmark::State& state) {
+  static locked<T> shared;
+  read_mostly(state, shared);
+}
+
+template <typename... Types>
+void BM_atomic_tuple(benchmark::State& state) {
+  static minpp::atomic_tuple<Types...> shared;
+  read_mostly(state, shared);
+}
+
+}
+
+BENCHMARK_TEMPLATE(BM_mutex, small)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_atomic_tuple, std::uint32_t, std::uint32_t)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_mutex, state16)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_atomic_tuple, std::uint32_t, std::uint32_t, std::uint64_t)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_mutex, large)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_atomic_tuple, std::uint64_t, std::uint64_t, std::uint64_t, std::uint64_t, std::uint64_t)->ThreadRange(1, 4)->UseRealTime();
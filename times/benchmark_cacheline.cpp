@@ -0,0 +1,38 @@
+#include <benchmark/benchmark.h>
+
+#include "minpp/tuple.h"
+#include "minpp/visit.h"
+
+#include <atomic>
+#include <cstdint>
+
+#include "perf_counters.h"
+
+/*
+Per-thread counters kept in one tuple: thread i increments element i. Packed, all eight counters share one
+cache line and every increment invalidates the other threads' copies; as an aligned_tuple each counter has
+a line of its own.
+*/
+
+namespace {
+
+using counter = std::atomic<std::uint64_t>;
+using packed = minpp::tuple<counter, counter, counter, counter, counter, counter, counter, counter>;
+using padded = minpp::aligned_tuple<counter, counter, counter, counter, counter, counter, counter, counter>;
+
+template <typename Counters>
+void BM_counters(benchmark::State& state) {
+  static Counters counters;
+  counter* mine = minpp::visit_at(counters, static_cast<std::size_t>(state.thread_index()) % 8, [](counter& c) { return &c; });
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    mine->fetch_add(1, std::memory_order_relaxed);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+}
+
+BENCHMARK_TEMPLATE(BM_counters, packed)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_counters, padded)->ThreadRange(1, 8)->UseRealTime();
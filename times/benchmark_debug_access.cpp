@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+
+#include "minpp/tuple.h"
+#include <tuple>
+
+#include <cstdint>
+#include <vector>
+
+#include "perf_counters.h"
+
+/*
+A particle update written against a plain struct, minpp::tuple and std::tuple. In an optimized build the
+three compile to the same loop; the minpp_bench_O0 target builds this file without optimization to track
+how much of the accessor and constructor layering is left in a debug build.
+*/
+
+namespace {
+
+struct particle {
+  double x, y, vx, vy;
+  std::int32_t hits;
+};
+
+using minpp_particle = minpp::tuple<double, double, double, double, std::int32_t>;
+using std_particle = std::tuple<double, double, double, double, std::int32_t>;
+
+void step(particle& p, double dt) {
+  p.x += p.vx * dt;
+  p.y += p.vy * dt;
+  if (p.x < 0 || p.x > 1) {
+    p.vx = -p.vx;
+    ++p.hits;
+  }
+}
+
+template <typename Tuple>
+void step(Tuple& p, double dt) {
+  get<0>(p) += get<2>(p) * dt;
+  get<1>(p) += get<3>(p) * dt;
+  if (get<0>(p) < 0 || get<0>(p) > 1) {
+    get<2>(p) = -get<2>(p);
+    ++get<4>(p);
+  }
+}
+
+template <typename Particle>
+void BM_update(benchmark::State& state) {
+  std::vector<Particle> ps;
+  for (std::int64_t i = 0; i < state.range(0); ++i) {
+    const double d = static_cast<double>(i) / static_cast<double>(state.range(0));
+    ps.push_back(Particle{d, 1 - d, 0.01, -0.01, 0});
+  }
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    for (auto& p: ps) step(p, 0.5);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Particle>
+void BM_construct(benchmark::State& state) {
+  std::vector<Particle> ps;
+  ps.reserve(static_cast<std::size_t>(state.range(0)));
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    ps.clear();
+    for (std::int64_t i = 0; i < state.range(0); ++i) ps.push_back(Particle{static_cast<double>(i), 0.0, 1.0, 1.0, 0});
+    benchmark::DoNotOptimize(ps.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}
+
+BENCHMARK_TEMPLATE(BM_update, particle)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_update, minpp_particle)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_update, std_particle)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_construct, particle)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_construct, minpp_particle)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_construct, std_particle)->Arg(4096);
@@ -0,0 +1,148 @@
+#include <benchmark/benchmark.h>
+
+#include "minpp/elementwise.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "perf_counters.h"
+
+/*
+A particle step (p += v * dt; v = v * damping + g) and a sum of dot products over 4-float and 3-float vectors,
+written as hand-written struct arithmetic, as loops over std::array and as minpp::elementwise expressions on
+minpp::tuple.
+*/
+
+namespace {
+
+struct vec4_struct {
+  float x, y, z, w;
+};
+
+struct vec3_struct {
+  float x, y, z;
+};
+
+vec4_struct step_position(vec4_struct p, vec4_struct v, float dt) {
+  return {p.x + v.x * dt, p.y + v.y * dt, p.z + v.z * dt, p.w + v.w * dt};
+}
+
+vec4_struct step_velocity(vec4_struct v, vec4_struct g, float damping) {
+  return {v.x * damping + g.x, v.y * damping + g.y, v.z * damping + g.z, v.w * damping + g.w};
+}
+
+float dot(vec4_struct a, vec4_struct b) {
+  return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+}
+
+vec3_struct step_position(vec3_struct p, vec3_struct v, float dt) {
+  return {p.x + v.x * dt, p.y + v.y * dt, p.z + v.z * dt};
+}
+
+vec3_struct step_velocity(vec3_struct v, vec3_struct g, float damping) {
+  return {v.x * damping + g.x, v.y * damping + g.y, v.z * damping + g.z};
+}
+
+float dot(vec3_struct a, vec3_struct b) {
+  return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+template <std::size_t N>
+std::array<float, N> step_position(const std::array<float, N>& p, const std::array<float, N>& v, float dt) {
+  std::array<float, N> r;
+  for (std::size_t i = 0; i < N; ++i) r[i] = p[i] + v[i] * dt;
+  return r;
+}
+
+template <std::size_t N>
+std::array<float, N> step_velocity(const std::array<float, N>& v, const std::array<float, N>& g, float damping) {
+  std::array<float, N> r;
+  for (std::size_t i = 0; i < N; ++i) r[i] = v[i] * damping + g[i];
+  return r;
+}
+
+template <std::size_t N>
+float dot(const std::array<float, N>& a, const std::array<float, N>& b) {
+  float r = 0;
+  for (std::size_t i = 0; i < N; ++i) r += a[i] * b[i];
+  return r;
+}
+
+template <typename... Types>
+minpp::tuple<Types...> step_position(const minpp::tuple<Types...>& p, const minpp::tuple<Types...>& v, float dt) {
+  using namespace minpp::elementwise;
+  return p + v * dt;
+}
+
+template <typename... Types>
+minpp::tuple<Types...> step_velocity(const minpp::tuple<Types...>& v, const minpp::tuple<Types...>& g, float damping) {
+  using namespace minpp::elementwise;
+  return v * damping + g;
+}
+
+template <typename... Types>
+float dot(const minpp::tuple<Types...>& a, const minpp::tuple<Types...>& b) {
+  return minpp::elementwise::dot(a, b);
+}
+
+template <typename Vec>
+Vec splat(float f) {
+  if constexpr (requires { Vec{f, f, f, f}; }) return Vec{f, f, f, f};
+  else return Vec{f, f, f};
+}
+
+template <typename Vec>
+void BM_particle_step(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<Vec> position(n, splat<Vec>(0.0f));
+  std::vector<Vec> velocity(n, splat<Vec>(1.0f));
+  const Vec g = splat<Vec>(-0.01f);
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) {
+      position[i] = step_position(position[i], velocity[i], 0.016f);
+      velocity[i] = step_velocity(velocity[i], g, 0.999f);
+    }
+    benchmark::DoNotOptimize(position.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+
+template <typename Vec>
+void BM_dot_sum(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<Vec> a(n, splat<Vec>(0.5f));
+  std::vector<Vec> b(n, splat<Vec>(2.0f));
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    float sum = 0;
+    for (std::size_t i = 0; i < n; ++i) sum += dot(a[i], b[i]);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+
+using vec4_array = std::array<float, 4>;
+using vec3_array = std::array<float, 3>;
+using vec4_tuple = minpp::tuple<float, float, float, float>;
+using vec3_tuple = minpp::tuple<float, float, float>;
+
+}
+
+BENCHMARK_TEMPLATE(BM_particle_step, vec4_struct)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_particle_step, vec4_array)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_particle_step, vec4_tuple)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_particle_step, vec3_struct)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_particle_step, vec3_array)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_particle_step, vec3_tuple)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_dot_sum, vec4_struct)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_dot_sum, vec4_array)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_dot_sum, vec4_tuple)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_dot_sum, vec3_struct)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_dot_sum, vec3_array)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_dot_sum, vec3_tuple)->Arg(4096);
@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include "minpp/format.h"
+
+#include <cstdint>
+#include <fcntl.h>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "perf_counters.h"
+
+/*
+Dumping rows of tuple<int64_t, double, string> as text: through an ostream with operator<< per element, the
+way times/time_minimal_tuple.cpp prints tuples (to /dev/null, so that the terminal is not measured), through
+write_rows on a file descriptor, and through format_to into a reused buffer without any I/O.
+*/
+
+namespace {
+
+using row = minpp::tuple<std::int64_t, double, std::string>;
+
+std::vector<row> make_rows(std::size_t n) {
+  std::vector<row> rows;
+  rows.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    rows.emplace_back(static_cast<std::int64_t>(i * 2654435761u), static_cast<double>(i) / 7.0, std::string(4 + i % 12, 'a'));
+  }
+  return rows;
+}
+
+void BM_ostream_rows(benchmark::State& state) {
+  const auto rows = make_rows(static_cast<std::size_t>(state.range(0)));
+  std::ofstream out{"/dev/null"};
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    for (const auto& [a, b, c]: rows) out << a << ',' << b << ',' << c << '\n';
+    out.flush();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_write_rows_fd(benchmark::State& state) {
+  const auto rows = make_rows(static_cast<std::size_t>(state.range(0)));
+  const int fd = ::open("/dev/null", O_WRONLY);
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    minpp::write_rows(fd, rows);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  ::close(fd);
+}
+
+void BM_format_to_buffer(benchmark::State& state) {
+  const auto rows = make_rows(static_cast<std::size_t>(state.range(0)));
+  std::string buffer;
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    buffer.clear();
+    minpp::write_rows(buffer, rows);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(buffer.size()));
+}
+
+}
+
+BENCHMARK(BM_ostream_rows)->Arg(1 << 14);
+BENCHMARK(BM_write_rows_fd)->Arg(1 << 14);
+BENCHMARK(BM_format_to_buffer)->Arg(1 << 14);
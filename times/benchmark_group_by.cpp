@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+
+#include "minpp/group_by.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "perf_counters.h"
+
+/*
+SELECT key, SUM(value), COUNT(*), MAX(weight) GROUP BY key over 10M rows of (uint64_t key, int64_t value,
+int32_t weight), with 1K, 1M and 5M distinct keys drawn uniformly: from a table that fits in L1 to one far
+larger than the last level cache, where every row is a cache miss on the table.
+group_by is the hash aggregation, once on one thread and once partitioned over a pool of one worker per
+core; adhoc is the std::unordered_map from key to a struct of running aggregates written by hand.
+*/
+
+namespace {
+
+using row = minpp::tuple<std::uint64_t, std::int64_t, std::int32_t>;
+
+constexpr std::size_t rows = 10'000'000;
+
+// one data set at a time, the sets of all the arguments would not fit in memory together
+const std::vector<row>& load(std::size_t distinct) {
+  static std::size_t loaded = 0;
+  static std::vector<row> data;
+  if (loaded != distinct) {
+    std::mt19937_64 rng{11};
+    data.clear();
+    data.reserve(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+      const std::uint64_t key = (rng() % distinct) * 0x9e3779b97f4a7c15ull;
+      data.emplace_back(key, static_cast<std::int64_t>(rng() % 1000), static_cast<std::int32_t>(rng() % 100000));
+    }
+    loaded = distinct;
+  }
+  return data;
+}
+
+void BM_group_by(benchmark::State& state) {
+  const std::vector<row>& in = load(static_cast<std::size_t>(state.range(0)));
+  using namespace minpp::agg;
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    auto out = minpp::group_by<0>(in).aggregate(sum<1>, count, max<2>);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(rows));
+}
+
+void BM_group_by_parallel(benchmark::State& state) {
+  const std::vector<row>& in = load(static_cast<std::size_t>(state.range(0)));
+  minpp::thread_pool pool;
+  using namespace minpp::agg;
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    auto out = minpp::group_by<0>(in).aggregate(pool, sum<1>, count, max<2>);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.counters["threads"] = static_cast<double>(pool.size());
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(rows));
+}
+
+void BM_group_by_adhoc(benchmark::State& state) {
+  const std::vector<row>& in = load(static_cast<std::size_t>(state.range(0)));
+  struct totals {
+    std::int64_t sum;
+    std::size_t count;
+    std::int32_t max;
+  };
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    std::unordered_map<std::uint64_t, totals> groups;
+    for (const auto& [key, value, weight]: in) {
+      auto [it, fresh] = groups.try_emplace(key, totals{value, 1, weight});
+      if (fresh) continue;
+      it->second.sum += value;
+      ++it->second.count;
+      it->second.max = std::max(it->second.max, weight);
+    }
+    benchmark::DoNotOptimize(groups.size());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(rows));
+}
+
+}
+
+BENCHMARK(BM_group_by)->Arg(1'000)->Arg(1'000'000)->Arg(5'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_group_by_parallel)->Arg(1'000)->Arg(1'000'000)->Arg(5'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_group_by_adhoc)->Arg(1'000)->Arg(1'000'000)->Arg(5'000'000)->Unit(benchmark::kMillisecond);
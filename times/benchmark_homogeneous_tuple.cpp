@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+
+#include "minpp/tuple.h"
+#include "minpp/visit.h"
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "perf_counters.h"
+
+/*
+Loops over the elements of 8-float rows by run-time index: minpp::tuple, which stores a homogeneous tuple as
+an array, against std::array and against std::tuple, where a run-time index has to go through visit_at. The
+std::tuple rows are also scaled with a fold over get<0> ... get<7>, the loop written out at compile time.
+Lookups read one element per row at a random index.
+*/
+
+namespace {
+
+using minpp_row = minpp::tuple<float, float, float, float, float, float, float, float>;
+using array_row = std::array<float, 8>;
+using std_row = std::tuple<float, float, float, float, float, float, float, float>;
+
+template <typename Row>
+std::vector<Row> make_rows(std::size_t n) {
+  std::vector<Row> rows(n);
+  for (std::size_t r = 0; r < n; ++r) {
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      ((get<Is>(rows[r]) = static_cast<float>(r + Is)), ...);
+    }(std::make_index_sequence<8>{});
+  }
+  return rows;
+}
+
+template <typename Row>
+float& at(Row& row, std::size_t i) {
+  if constexpr (std::is_same_v<Row, std_row>) return minpp::visit_at(row, i, [](float& v) -> float& { return v; });
+  else return row[i];
+}
+
+template <typename Row>
+void BM_scale_by_index(benchmark::State& state) {
+  auto rows = make_rows<Row>(static_cast<std::size_t>(state.range(0)));
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    for (auto& row: rows) {
+      for (std::size_t i = 0; i < 8; ++i) at(row, i) = at(row, i) * 0.5f + 1.0f;
+    }
+    benchmark::DoNotOptimize(rows.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_scale_by_get_fold(benchmark::State& state) {
+  auto rows = make_rows<std_row>(static_cast<std::size_t>(state.range(0)));
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    for (auto& row: rows) {
+      std::apply([](auto&... v) { ((v = v * 0.5f + 1.0f), ...); }, row);
+    }
+    benchmark::DoNotOptimize(rows.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Row>
+void BM_lookup(benchmark::State& state) {
+  auto rows = make_rows<Row>(static_cast<std::size_t>(state.range(0)));
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<std::size_t> dist{0, 7};
+  std::vector<std::uint8_t> indices(rows.size());
+  for (auto& i: indices) i = static_cast<std::uint8_t>(dist(gen));
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    float sum = 0;
+    for (std::size_t r = 0; r < rows.size(); ++r) sum += at(rows[r], indices[r]);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}
+
+BENCHMARK_TEMPLATE(BM_scale_by_index, minpp_row)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_scale_by_index, array_row)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_scale_by_index, std_row)->Arg(4096);
+BENCHMARK(BM_scale_by_get_fold)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_lookup, minpp_row)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_lookup, array_row)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_lookup, std_row)->Arg(4096);
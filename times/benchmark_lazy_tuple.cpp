@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include "minpp/lazy_tuple.h"
+
+#include <cctype>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "perf_counters.h"
+
+/*
+Request records with a field derived from the raw payload (a lowercased, whitespace-collapsed copy), built
+eagerly as a tuple and deferred in a lazy_tuple / concurrent_lazy_tuple. Only range(0) percent of the requests
+read the derived field; the others read the id alone.
+*/
+
+namespace {
+
+std::string normalize(std::string_view raw) {
+  std::string out;
+  out.reserve(raw.size());
+  bool space = false;
+  for (char c: raw) {
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      space = true;
+      continue;
+    }
+    if (space && !out.empty()) out.push_back(' ');
+    space = false;
+    out.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+  }
+  return out;
+}
+
+const std::vector<std::string>& payloads() {
+  static const std::vector<std::string> p = [] {
+    std::vector<std::string> v;
+    for (int i = 0; i < 1024; ++i) {
+      std::string s;
+      for (int w = 0; w < 24; ++w) s += "  Word" + std::to_string((i * 31 + w) % 97) + " ";
+      v.push_back(std::move(s));
+    }
+    return v;
+  }();
+  return p;
+}
+
+template <typename Record>
+Record make_record(std::uint64_t id, const std::string& raw) {
+  if constexpr (requires { Record{id, minpp::defer([] { return std::string(); })}; }) {
+    return Record{id, minpp::defer([&raw] { return normalize(raw); })};
+  }
+  else return Record{id, normalize(raw)};
+}
+
+template <typename Record>
+void BM_requests(benchmark::State& state) {
+  const auto& raw = payloads();
+  const std::size_t read_every = state.range(0) == 0 ? 0 : static_cast<std::size_t>(100 / state.range(0));
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < raw.size(); ++i) {
+      const Record r = make_record<Record>(i, raw[i]);
+      total += minpp::get<0>(r);
+      if (read_every != 0 && i % read_every == 0) total += minpp::get<1>(r).size();
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(raw.size()));
+}
+
+using eager = minpp::tuple<std::uint64_t, std::string>;
+using lazy = minpp::lazy_tuple<std::uint64_t, std::string>;
+using concurrent_lazy = minpp::concurrent_lazy_tuple<std::uint64_t, std::string>;
+
+}
+
+BENCHMARK_TEMPLATE(BM_requests, eager)->Arg(0)->Arg(10)->Arg(100);
+BENCHMARK_TEMPLATE(BM_requests, lazy)->Arg(0)->Arg(10)->Arg(100);
+BENCHMARK_TEMPLATE(BM_requests, concurrent_lazy)->Arg(0)->Arg(10)->Arg(100);
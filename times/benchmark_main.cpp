@@ -0,0 +1,5 @@
+#include "perf_counters.h"
+
+int main(int argc, char** argv) {
+  return minpp_bench::run_benchmarks(argc, argv);
+}
@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+
+#include "minpp/memoize.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "perf_counters.h"
+
+/*
+Caching a function of (std::string, int) that costs a few hundred nanoseconds, over a stream of calls drawn
+from 4096 distinct arguments with a skewed distribution. The ad-hoc caches are what such code usually looks
+like: a mutex and a std::map or std::unordered_map keyed by std::tuple<std::string, int>, built with
+make_tuple for every lookup, which copies the string, and never evicting. memoize hashes the arguments in
+place and copies them only on a miss; its argument is the capacity, so the smaller ones also measure the
+cost of evictions and the hit rate they leave.
+*/
+
+namespace {
+
+constexpr std::size_t distinct = 4096;
+constexpr std::size_t calls = 1 << 16;
+
+std::uint64_t work(const std::string& s, int n) {
+  std::uint64_t h = static_cast<std::uint64_t>(n);
+  for (int round = 0; round < 8; ++round) {
+    for (char c: s) h = (h ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+  }
+  return h;
+}
+
+struct workload {
+  std::vector<std::string> names;
+  std::vector<std::uint32_t> stream;
+
+  workload() {
+    for (std::size_t i = 0; i < distinct; ++i) names.push_back("customer/" + std::to_string(i) + "/region/some-longer-suffix");
+    std::mt19937 rng{42};
+    // about 80% of the calls go to 20% of the arguments
+    std::discrete_distribution<int> hot{80, 20};
+    std::uniform_int_distribution<std::uint32_t> few(0, distinct / 5 - 1), all(0, distinct - 1);
+    for (std::size_t i = 0; i < calls; ++i) stream.push_back(hot(rng) == 0 ? few(rng) : all(rng));
+  }
+};
+
+const workload& load() {
+  static const workload w;
+  return w;
+}
+
+struct tuple_hash {
+  std::size_t operator()(const std::tuple<std::string, int>& t) const noexcept {
+    return std::hash<std::string>{}(std::get<0>(t)) * 31 + std::hash<int>{}(std::get<1>(t));
+  }
+};
+
+template <typename F>
+void run(benchmark::State& state, F&& f) {
+  const workload& w = load();
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    std::uint64_t total = 0;
+    for (std::uint32_t k: w.stream) total += f(w.names[k], static_cast<int>(k & 7));
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(calls));
+}
+
+void BM_uncached(benchmark::State& state) {
+  run(state, work);
+}
+
+template <typename Map>
+void BM_adhoc(benchmark::State& state) {
+  std::mutex m;
+  Map cache;
+  run(state, [&](const std::string& s, int n) {
+    std::lock_guard lk{m};
+    auto key = std::make_tuple(s, n);
+    auto it = cache.find(key);
+    if (it == cache.end()) it = cache.emplace(std::move(key), work(s, n)).first;
+    return it->second;
+  });
+}
+
+void BM_memoize(benchmark::State& state) {
+  auto f = minpp::memoize(work, static_cast<std::size_t>(state.range(0)));
+  run(state, f);
+  state.counters["hit_rate"] = f.stats().hit_rate();
+}
+
+using adhoc_map = std::map<std::tuple<std::string, int>, std::uint64_t>;
+using adhoc_unordered_map = std::unordered_map<std::tuple<std::string, int>, std::uint64_t, tuple_hash>;
+
+}
+
+BENCHMARK(BM_uncached)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_adhoc, adhoc_map)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_adhoc, adhoc_unordered_map)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_memoize)->Arg(8192)->Arg(2048)->Arg(512)->Unit(benchmark::kMicrosecond);
@@ -3,287 +3,376 @@
 #include "minpp/tuple.h"
 #include <tuple>
 
+#include "perf_counters.h"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/*
+Runtime comparison of minpp::tuple against std::tuple.
+
+Every operation is registered for each element kind and element count as
+  <operation>/<kind>/<count>/<library>
+so that the minpp and std numbers of the same shape sit next to each other.
+Run with --benchmark_format=json (or the minpp_bench_json target) to get machine readable output and
+with --minpp_perf_counters to add hardware counters (see perf_counters.h).
+*/
+
+namespace {
+
+constexpr std::uint_fast32_t bench_seed = 0x6d696e70;
+
+struct large_element {
+  std::array<std::uint64_t, 16> data{};
+
+  auto operator<=>(const large_element&) const = default;
+};
+
+/*
+Element kinds. Each kind provides the stored element type, a value type that owns the referenced
+values (differs from type only for reference tuples), an optional source type used by the converting
+constructor benchmark and a factory for deterministic values.
+*/
+struct trivial_kind {
+  static constexpr const char* name = "trivial";
+  using type = int;
+  using value_type = int;
+  using source_type = short;
+
+  static value_type make(std::mt19937& gen) { return std::uniform_int_distribution<int>{0, 1 << 14}(gen); }
+  static source_type make_source(std::mt19937& gen) { return static_cast<short>(make(gen)); }
+};
+
+struct string_kind {
+  static constexpr const char* name = "string";
+  using type = std::string;
+  using value_type = std::string;
+  using source_type = std::string_view;
+
+  // long enough to defeat the small string optimization
+  static value_type make(std::mt19937& gen) { return std::string(48, static_cast<char>('a' + gen() % 26)); }
+  static source_type make_source(std::mt19937& gen) {
+    static const std::string pool(64, 'x');
+    return std::string_view{pool}.substr(0, 48 - gen() % 8);
+  }
+};
 
-static void BM_minpp_get_assign(benchmark::State& state) {
-  std::random_device seed;
-  std::mt19937 gen{seed()};
-  std::uniform_int_distribution rand;
+struct unique_ptr_kind {
+  static constexpr const char* name = "unique_ptr";
+  using type = std::unique_ptr<int>;
+  using value_type = std::unique_ptr<int>;
 
-  int a = rand(gen), b = rand(gen), c = rand(gen);
+  static value_type make(std::mt19937& gen) { return std::make_unique<int>(static_cast<int>(gen())); }
+};
 
-  minpp::tuple<int, int, int> tup {0, 1, 2}; 
-  
-  for (auto _ : state) {
-    minpp::get<0>(tup) = a;
-    minpp::get<1>(tup) = b;
-    minpp::get<2>(tup) = c;
+struct large_kind {
+  static constexpr const char* name = "large";
+  using type = large_element;
+  using value_type = large_element;
+
+  static value_type make(std::mt19937& gen) {
+    large_element v;
+    for (auto& d: v.data) d = gen();
+    return v;
   }
-}
+};
 
-static void BM_std_get_assign(benchmark::State& state) {
-  std::random_device seed;
-  std::mt19937 gen{seed()};
-  std::uniform_int_distribution rand;
+struct reference_kind {
+  static constexpr const char* name = "reference";
+  using type = int&;
+  using value_type = int;
+  using source_type = std::reference_wrapper<int>;
 
-  int a = rand(gen), b = rand(gen), c = rand(gen);
+  static value_type make(std::mt19937& gen) { return static_cast<int>(gen()); }
+};
 
-  std::tuple<int, int, int> tup {0, 1, 2}; 
-  
-  for (auto _ : state) {
-    std::get<0>(tup) = a;
-    std::get<1>(tup) = b;
-    std::get<2>(tup) = c;
-  }
-}
+template <typename Kind>
+concept convertible_kind = requires { typename Kind::source_type; };
 
-static void BM_minpp_get_get(benchmark::State& state) {
-  std::random_device seed;
-  std::mt19937 gen{seed()};
-  std::uniform_int_distribution rand;
+template <typename Kind>
+concept copyable_kind = std::copy_constructible<typename Kind::value_type>;
 
-  minpp::tuple<int, int, int> tup {rand(gen), rand(gen), rand(gen)}; 
+/*
+Library adaptors: everything except get (found by ADL) is routed through here.
+*/
+struct minpp_lib {
+  static constexpr const char* name = "minpp";
 
-  for (auto _ : state) {
-    auto [a, b, c] {tup};
-    benchmark::DoNotOptimize(a);
-    benchmark::DoNotOptimize(b);
-    benchmark::DoNotOptimize(c);
-  }
-}
+  template <typename... Ts>
+  using tuple = minpp::tuple<Ts...>;
 
-static void BM_std_get_get(benchmark::State& state) {
-  std::random_device seed;
-  std::mt19937 gen{seed()};
-  std::uniform_int_distribution rand;
+  template <typename... Tuples>
+  static constexpr decltype(auto) tuple_cat(Tuples&&... tpls) { return minpp::tuple_cat(std::forward<Tuples>(tpls)...); }
 
-  std::tuple<int, int, int> tup {rand(gen), rand(gen), rand(gen)}; 
+  template <typename F, typename Tuple>
+  static constexpr decltype(auto) apply(F&& f, Tuple&& t) { return minpp::apply(std::forward<F>(f), std::forward<Tuple>(t)); }
 
-  for (auto _ : state) {
-    auto [a, b, c] {tup};
-    benchmark::DoNotOptimize(a);
-    benchmark::DoNotOptimize(b);
-    benchmark::DoNotOptimize(c);
-  }
-}
+  template <typename T, typename Tuple>
+  static constexpr T make_from_tuple(Tuple&& t) { return minpp::make_from_tuple<T>(std::forward<Tuple>(t)); }
+};
 
-static void BM_minpp_construct_copy(benchmark::State& state) {
-  std::random_device seed;
-  std::mt19937 gen{seed()};
-  std::uniform_int_distribution rand;
-  
-  const int a = rand(gen), b = rand(gen), c = rand(gen);
+struct std_lib {
+  static constexpr const char* name = "std";
 
-  for (auto _ : state) {
-    minpp::tuple<int, int, int> tup {a, b, c}; 
-    benchmark::DoNotOptimize(tup);
-  }
-}
+  template <typename... Ts>
+  using tuple = std::tuple<Ts...>;
 
-static void BM_std_construct_copy(benchmark::State& state) { 
-  std::random_device seed;
-  std::mt19937 gen{seed()};
-  std::uniform_int_distribution rand;
+  template <typename... Tuples>
+  static constexpr decltype(auto) tuple_cat(Tuples&&... tpls) { return std::tuple_cat(std::forward<Tuples>(tpls)...); }
 
-  const int a = rand(gen), b = rand(gen), c = rand(gen);
+  template <typename F, typename Tuple>
+  static constexpr decltype(auto) apply(F&& f, Tuple&& t) { return std::apply(std::forward<F>(f), std::forward<Tuple>(t)); }
 
-  for (auto _ : state) {
-    std::tuple<int, int, int> tup {a, b, c}; 
-    benchmark::DoNotOptimize(tup);
-  }
-}
+  template <typename T, typename Tuple>
+  static constexpr T make_from_tuple(Tuple&& t) { return std::make_from_tuple<T>(std::forward<Tuple>(t)); }
+};
 
-static void BM_minpp_construct_move(benchmark::State& state) { 
-  std::random_device seed;
-  std::mt19937 gen{seed()};
-  std::uniform_int_distribution rand;
+template <typename Lib, typename T, typename Seq>
+struct _repeat_tuple;
 
-  int a = rand(gen), b = rand(gen), c = rand(gen);
+template <typename Lib, typename T, std::size_t... Is>
+struct _repeat_tuple<Lib, T, std::index_sequence<Is...>> {
+  using type = typename Lib::template tuple<std::enable_if_t<((void)Is, true), T>...>;
+};
 
-  for (auto _ : state) {
-    minpp::tuple<int, int, int> tup {std::move(a), std::move(b), std::move(c)}; 
-    benchmark::DoNotOptimize(tup);
-  }
-}
+template <typename Lib, typename T, std::size_t N>
+using repeat_tuple = typename _repeat_tuple<Lib, T, std::make_index_sequence<N>>::type;
 
-static void BM_std_construct_move(benchmark::State& state) {  
-  std::random_device seed;
-  std::mt19937 gen{seed()};
-  std::uniform_int_distribution rand;
-    
-  int a = rand(gen), b = rand(gen), c = rand(gen);
+/*
+Owns N values of Kind plus a tuple built from them, so that the reference kind has something to refer to.
+*/
+template <typename Lib, typename Kind, std::size_t N>
+struct fixture {
+  using tuple_type = repeat_tuple<Lib, typename Kind::type, N>;
 
-  for (auto _ : state) {
-    std::tuple<int, int, int> tup {std::move(a), std::move(b), std::move(c)}; 
-    benchmark::DoNotOptimize(tup);
-  }
-}
+  std::array<typename Kind::value_type, N> values;
 
-static void BM_minpp_construct_other_copy(benchmark::State& state) {
-  std::random_device seed;
-  std::mt19937 gen{seed()};
-  std::uniform_int_distribution rand;
-  
-  const minpp::tuple<int, int, int> src{rand(gen), rand(gen), rand(gen)};
+  explicit fixture(std::mt19937& gen) {
+    for (auto& v: values) v = Kind::make(gen);
+  }
 
-  for (auto _ : state) {
-    minpp::tuple<long, long, long> tup {src}; 
-    benchmark::DoNotOptimize(tup);
+  template <std::size_t... Is>
+  tuple_type _make(std::index_sequence<Is...>) {
+    if constexpr (copyable_kind<Kind> || std::is_reference_v<typename Kind::type>) return tuple_type{values[Is]...};
+    else return tuple_type{std::move(values[Is])...};
   }
+
+  // move-only kinds hand their values over, so make is called at most once for those
+  tuple_type make() { return _make(std::make_index_sequence<N>{}); }
+};
+
+struct sink {
+  template <typename... Args>
+  sink(Args&&... args) { (benchmark::DoNotOptimize(args), ...); }
+};
+
+template <typename Lib, typename Kind, std::size_t N>
+void BM_construct(benchmark::State& state) {
+  std::mt19937 gen{bench_seed};
+  fixture<Lib, Kind, N> fx{gen};
+
+  [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    minpp_bench::perf_scope perf{state};
+    for (auto _ : state) {
+      if constexpr (copyable_kind<Kind> || std::is_reference_v<typename Kind::type>) {
+        typename fixture<Lib, Kind, N>::tuple_type tup {fx.values[Is]...};
+        benchmark::DoNotOptimize(tup);
+      }
+      else {
+        // move-only: move the values in and back out again so every iteration starts from the same state
+        typename fixture<Lib, Kind, N>::tuple_type tup {std::move(fx.values[Is])...};
+        benchmark::DoNotOptimize(tup);
+        ((fx.values[Is] = std::move(get<Is>(tup))), ...);
+      }
+    }
+  }(std::make_index_sequence<N>{});
 }
 
-static void BM_std_construct_other_copy(benchmark::State& state) {
-  std::random_device seed;
-  std::mt19937 gen{seed()};
-  std::uniform_int_distribution rand;
+template <typename Lib, typename Kind, std::size_t N>
+void BM_convert(benchmark::State& state) {
+  using source_tuple = repeat_tuple<Lib, typename Kind::source_type, N>;
+  std::mt19937 gen{bench_seed};
+  fixture<Lib, Kind, N> fx{gen};
 
-  const std::tuple<int, int, int> src{rand(gen), rand(gen), rand(gen)};
+  const source_tuple src = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    if constexpr (std::is_reference_v<typename Kind::type>) return source_tuple{std::ref(fx.values[Is])...};
+    else return source_tuple{((void)Is, Kind::make_source(gen))...};
+  }(std::make_index_sequence<N>{});
 
+  minpp_bench::perf_scope perf{state};
   for (auto _ : state) {
-    std::tuple<long, long, long> tup {src}; 
+    typename fixture<Lib, Kind, N>::tuple_type tup {src};
     benchmark::DoNotOptimize(tup);
   }
 }
 
-static void BM_minpp_construct_other_move(benchmark::State& state) {
-  std::random_device seed;
-  std::mt19937 gen{seed()};
-  std::uniform_int_distribution rand;
-    
-  const minpp::tuple<int, int, int> src{rand(gen), rand(gen), rand(gen)};
+template <typename Lib, typename Kind, std::size_t N>
+void BM_copy_assign(benchmark::State& state) {
+  std::mt19937 gen{bench_seed};
+  fixture<Lib, Kind, N> fx_dst{gen}, fx_src{gen};
+  auto dst = fx_dst.make();
+  const auto src = fx_src.make();
 
+  minpp_bench::perf_scope perf{state};
   for (auto _ : state) {
-    minpp::tuple<long, long, long> tup {std::move(src)}; 
-    benchmark::DoNotOptimize(tup);
+    dst = src;
+    benchmark::DoNotOptimize(dst);
   }
 }
 
-static void BM_std_construct_other_move(benchmark::State& state) { 
-  std::random_device seed;
-  std::mt19937 gen{seed()};
-  std::uniform_int_distribution rand;
-  
-  const std::tuple<int, int, int> src{rand(gen), rand(gen), rand(gen)};
-  
+template <typename Lib, typename Kind, std::size_t N>
+void BM_move_assign(benchmark::State& state) {
+  std::mt19937 gen{bench_seed};
+  fixture<Lib, Kind, N> fx_a{gen}, fx_b{gen};
+  auto a = fx_a.make();
+  auto b = fx_b.make();
+
+  // two moves per iteration, so that the moved-from state never leaks into the next one
+  minpp_bench::perf_scope perf{state};
   for (auto _ : state) {
-    std::tuple<long, long, long> tup {std::move(src)}; 
-    benchmark::DoNotOptimize(tup);
+    b = std::move(a);
+    a = std::move(b);
+    benchmark::DoNotOptimize(a);
   }
 }
 
-static void BM_minpp_copy_assign(benchmark::State& state) {
-  std::random_device seed;
-  std::mt19937 gen{seed()};
-  std::uniform_int_distribution rand;
-    
-  minpp::tuple<int, int, int> tup {0, 1, 2}; 
-  const minpp::tuple<int, int, int> src{rand(gen), rand(gen), rand(gen)};
+template <typename Lib, typename Kind, std::size_t N>
+void BM_swap(benchmark::State& state) {
+  std::mt19937 gen{bench_seed};
+  fixture<Lib, Kind, N> fx_a{gen}, fx_b{gen};
+  auto a = fx_a.make();
+  auto b = fx_b.make();
 
+  minpp_bench::perf_scope perf{state};
   for (auto _ : state) {
-    tup = src;
-    benchmark::DoNotOptimize(tup);
+    a.swap(b);
+    benchmark::DoNotOptimize(a);
   }
 }
 
-static void BM_std_copy_assign(benchmark::State& state) { 
-  std::random_device seed;
-  std::mt19937 gen{seed()};
-  std::uniform_int_distribution rand;
-  
-  std::tuple<int, int, int> tup {0, 1, 2}; 
-  const std::tuple<int, int, int> src{rand(gen), rand(gen), rand(gen)};
-  
-  for (auto _ : state) {
-    tup = src;
-    benchmark::DoNotOptimize(tup);
-  }
+template <typename Lib, typename Kind, std::size_t N>
+void BM_get(benchmark::State& state) {
+  std::mt19937 gen{bench_seed};
+  fixture<Lib, Kind, N> fx{gen};
+  auto tup = fx.make();
+
+  [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    minpp_bench::perf_scope perf{state};
+    for (auto _ : state) {
+      (benchmark::DoNotOptimize(get<Is>(tup)), ...);
+    }
+  }(std::make_index_sequence<N>{});
 }
 
-static void BM_minpp_move_assign(benchmark::State& state) {
-  std::random_device seed;
-  std::mt19937 gen{seed()};
-  std::uniform_int_distribution rand;
-    
-  minpp::tuple<int, int, int> tup {0, 1, 2}; 
-  const minpp::tuple<int, int, int> src{rand(gen), rand(gen), rand(gen)};
-
+template <typename Lib, typename Kind, std::size_t N>
+void BM_compare(benchmark::State& state) {
+  std::mt19937 gen{bench_seed};
+  fixture<Lib, Kind, N> fx_a{gen};
+  auto a = fx_a.make();
+
+  // equal up to the last element, so the lexicographical comparison has to visit everything
+  [[maybe_unused]] fixture<Lib, Kind, N> fx_b{gen};
+  auto b = [&] {
+    if constexpr (copyable_kind<Kind> || std::is_reference_v<typename Kind::type>) {
+      fx_b.values = fx_a.values;
+      fx_b.values[N - 1] = Kind::make(gen);
+    }
+    return fx_b.make();
+  }();
+
+  minpp_bench::perf_scope perf{state};
   for (auto _ : state) {
-    tup = std::move(src);
-    benchmark::DoNotOptimize(tup);
+    auto lt = a < b;
+    auto eq = a == b;
+    benchmark::DoNotOptimize(lt);
+    benchmark::DoNotOptimize(eq);
   }
 }
 
-static void BM_std_move_assign(benchmark::State& state) { 
-  std::random_device seed;
-  std::mt19937 gen{seed()};
-  std::uniform_int_distribution rand;
-  
-  std::tuple<int, int, int> tup {0, 1, 2}; 
-  const std::tuple<int, int, int> src{rand(gen), rand(gen), rand(gen)};
-  
+template <typename Lib, typename Kind, std::size_t N>
+void BM_tuple_cat(benchmark::State& state) {
+  std::mt19937 gen{bench_seed};
+  fixture<Lib, Kind, N> fx_a{gen}, fx_b{gen};
+  auto a = fx_a.make();
+  auto b = fx_b.make();
+
+  minpp_bench::perf_scope perf{state};
   for (auto _ : state) {
-    tup = std::move(src);
+    auto tup = Lib::tuple_cat(a, b);
     benchmark::DoNotOptimize(tup);
   }
 }
 
-static void BM_minpp_tuple_cat(benchmark::State& state) {
-  std::random_device seed;
-  std::mt19937 gen{seed()};
-  std::uniform_int_distribution rand;
-    
-  minpp::tuple<int, int, int> tup1{rand(gen), rand(gen), rand(gen)}; 
-  minpp::tuple<int, int, int> tup2{rand(gen), rand(gen), rand(gen)}; 
-  minpp::tuple<int, int, int> tup3{rand(gen), rand(gen), rand(gen)}; 
-  minpp::tuple<int, int, int> tup4{rand(gen), rand(gen), rand(gen)}; 
+template <typename Lib, typename Kind, std::size_t N>
+void BM_apply(benchmark::State& state) {
+  std::mt19937 gen{bench_seed};
+  fixture<Lib, Kind, N> fx{gen};
+  auto tup = fx.make();
 
+  minpp_bench::perf_scope perf{state};
   for (auto _ : state) {
-    auto tup = minpp::tuple_cat(tup1, tup2, tup3, tup4);
-    benchmark::DoNotOptimize(tup);
+    Lib::apply([](auto&... args) { (benchmark::DoNotOptimize(args), ...); }, tup);
   }
 }
 
-static void BM_std_tuple_cat(benchmark::State& state) { 
-  std::random_device seed;
-  std::mt19937 gen{seed()};
-  std::uniform_int_distribution rand;
-    
-  std::tuple<int, int, int> tup1{rand(gen), rand(gen), rand(gen)}; 
-  std::tuple<int, int, int> tup2{rand(gen), rand(gen), rand(gen)}; 
-  std::tuple<int, int, int> tup3{rand(gen), rand(gen), rand(gen)}; 
-  std::tuple<int, int, int> tup4{rand(gen), rand(gen), rand(gen)}; 
+template <typename Lib, typename Kind, std::size_t N>
+void BM_make_from_tuple(benchmark::State& state) {
+  std::mt19937 gen{bench_seed};
+  fixture<Lib, Kind, N> fx{gen};
+  auto tup = fx.make();
 
+  minpp_bench::perf_scope perf{state};
   for (auto _ : state) {
-    auto tup = std::tuple_cat(tup1, tup2, tup3, tup4);
-    benchmark::DoNotOptimize(tup);
+    auto s = Lib::template make_from_tuple<sink>(tup);
+    benchmark::DoNotOptimize(s);
   }
 }
 
-BENCHMARK(BM_minpp_get_assign);
-BENCHMARK(BM_std_get_assign);
-
-BENCHMARK(BM_minpp_get_get);
-BENCHMARK(BM_std_get_get);
-
-BENCHMARK(BM_minpp_construct_copy);
-BENCHMARK(BM_std_construct_copy);
-
-BENCHMARK(BM_minpp_construct_move);
-BENCHMARK(BM_std_construct_move);
-
-BENCHMARK(BM_minpp_construct_other_copy);
-BENCHMARK(BM_std_construct_other_copy);
+template <typename Kind, std::size_t N>
+std::string bench_name(const char* op, const char* lib) {
+  return std::string{op} + '/' + Kind::name + '/' + std::to_string(N) + '/' + lib;
+}
 
-BENCHMARK(BM_minpp_construct_other_move);
-BENCHMARK(BM_std_construct_other_move);
+template <typename Kind, std::size_t N, typename... Libs>
+void register_shape() {
+  constexpr bool copyable = copyable_kind<Kind> || std::is_reference_v<typename Kind::type>;
+
+  auto add = [](const char* op, const char* lib, void (*fn)(benchmark::State&)) {
+    benchmark::RegisterBenchmark(bench_name<Kind, N>(op, lib).c_str(), fn);
+  };
+
+  (add("construct", Libs::name, BM_construct<Libs, Kind, N>), ...);
+  if constexpr (convertible_kind<Kind>) (add("convert", Libs::name, BM_convert<Libs, Kind, N>), ...);
+  if constexpr (copyable) (add("copy_assign", Libs::name, BM_copy_assign<Libs, Kind, N>), ...);
+  (add("move_assign", Libs::name, BM_move_assign<Libs, Kind, N>), ...);
+  (add("swap", Libs::name, BM_swap<Libs, Kind, N>), ...);
+  (add("get", Libs::name, BM_get<Libs, Kind, N>), ...);
+  (add("compare", Libs::name, BM_compare<Libs, Kind, N>), ...);
+  if constexpr (copyable) (add("tuple_cat", Libs::name, BM_tuple_cat<Libs, Kind, N>), ...);
+  (add("apply", Libs::name, BM_apply<Libs, Kind, N>), ...);
+  (add("make_from_tuple", Libs::name, BM_make_from_tuple<Libs, Kind, N>), ...);
+}
 
-BENCHMARK(BM_minpp_copy_assign);
-BENCHMARK(BM_std_copy_assign);
+template <typename Kind, std::size_t... Ns>
+void register_kind(std::index_sequence<Ns...>) {
+  (register_shape<Kind, Ns, minpp_lib, std_lib>(), ...);
+}
 
-BENCHMARK(BM_minpp_move_assign);
-BENCHMARK(BM_std_move_assign);
+using bench_sizes = std::index_sequence<1, 2, 4, 8, 16, 32, 64>;
 
-BENCHMARK(BM_minpp_tuple_cat);
-BENCHMARK(BM_std_tuple_cat);
+const bool registered = [] {
+  register_kind<trivial_kind>(bench_sizes{});
+  register_kind<string_kind>(bench_sizes{});
+  register_kind<unique_ptr_kind>(bench_sizes{});
+  register_kind<large_kind>(bench_sizes{});
+  register_kind<reference_kind>(bench_sizes{});
+  return true;
+}();
 
-BENCHMARK_MAIN();
+}
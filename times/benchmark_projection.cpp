@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+
+#include "minpp/projection.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "perf_counters.h"
+
+/*
+Group-by key extraction over two string columns: copying the key into a fresh tuple against hashing and
+comparing through a select view.
+*/
+
+namespace {
+
+using row = minpp::tuple<int, std::string, double, std::string>;
+
+std::vector<row> make_rows(std::size_t n) {
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> dist{0, 63};
+  std::vector<row> rows;
+  rows.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    rows.emplace_back(dist(gen), std::string(32, static_cast<char>('a' + dist(gen) % 26)), 0.5 * dist(gen), std::string(40, static_cast<char>('A' + dist(gen) % 26)));
+  }
+  return rows;
+}
+
+void BM_key_copy_hash(benchmark::State& state) {
+  const auto rows = make_rows(static_cast<std::size_t>(state.range(0)));
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    std::size_t acc = 0;
+    for (const auto& r: rows) acc ^= std::hash<minpp::tuple<std::string, std::string>>{}(minpp::make_tuple(minpp::get<1>(r), minpp::get<3>(r)));
+    benchmark::DoNotOptimize(acc);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_key_select_hash(benchmark::State& state) {
+  const auto rows = make_rows(static_cast<std::size_t>(state.range(0)));
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    std::size_t acc = 0;
+    for (const auto& r: rows) acc ^= minpp::hash_by<1, 3>{}(r);
+    benchmark::DoNotOptimize(acc);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_sort_key_copy(benchmark::State& state) {
+  const auto rows = make_rows(static_cast<std::size_t>(state.range(0)));
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto work = rows;
+    state.ResumeTiming();
+    std::sort(work.begin(), work.end(), [](const row& a, const row& b) {
+      return minpp::make_tuple(minpp::get<3>(a), minpp::get<1>(a)) < minpp::make_tuple(minpp::get<3>(b), minpp::get<1>(b));
+    });
+    benchmark::DoNotOptimize(work.data());
+  }
+}
+
+void BM_sort_compare_by(benchmark::State& state) {
+  const auto rows = make_rows(static_cast<std::size_t>(state.range(0)));
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto work = rows;
+    state.ResumeTiming();
+    std::sort(work.begin(), work.end(), minpp::compare_by<3, 1>{});
+    benchmark::DoNotOptimize(work.data());
+  }
+}
+
+}
+
+BENCHMARK(BM_key_copy_hash)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_key_select_hash)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_sort_key_copy)->Arg(1 << 10)->Arg(1 << 14);
+BENCHMARK(BM_sort_compare_by)->Arg(1 << 10)->Arg(1 << 14);
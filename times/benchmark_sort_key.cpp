@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include "minpp/sort_key.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "perf_counters.h"
+
+/*
+Merge-phase comparisons: sorting rows by element-wise operator<=> against sorting their binary sort keys
+with memcmp, plus the cost of producing the keys in the first place.
+*/
+
+namespace {
+
+using row = minpp::tuple<std::int64_t, double, std::string, std::uint32_t>;
+
+std::vector<row> make_rows(std::size_t n) {
+  std::mt19937_64 gen{42};
+  std::vector<row> rows;
+  rows.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    // few distinct leading columns so that comparisons regularly reach the later ones
+    rows.emplace_back(static_cast<std::int64_t>(gen() % 16), static_cast<double>(gen() % 64) * 0.25,
+      std::string(16, static_cast<char>('a' + gen() % 4)) + std::to_string(gen() % 1000), static_cast<std::uint32_t>(gen()));
+  }
+  return rows;
+}
+
+void BM_sort_tuples(benchmark::State& state) {
+  const auto rows = make_rows(static_cast<std::size_t>(state.range(0)));
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<const row*> order;
+    for (const auto& r: rows) order.push_back(&r);
+    state.ResumeTiming();
+    std::sort(order.begin(), order.end(), [](const row* a, const row* b) { return *a < *b; });
+    benchmark::DoNotOptimize(order.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_sort_keys(benchmark::State& state) {
+  const auto rows = make_rows(static_cast<std::size_t>(state.range(0)));
+  std::string buffer;
+  std::vector<std::size_t> offsets;
+  minpp::encode_sort_keys(rows.begin(), rows.end(), buffer, offsets);
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<std::string_view> keys;
+    for (std::size_t i = 0; i + 1 < offsets.size(); ++i) keys.emplace_back(buffer.data() + offsets[i], offsets[i + 1] - offsets[i]);
+    state.ResumeTiming();
+    std::sort(keys.begin(), keys.end());
+    benchmark::DoNotOptimize(keys.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_encode_sort_keys(benchmark::State& state) {
+  const auto rows = make_rows(static_cast<std::size_t>(state.range(0)));
+  std::string buffer;
+  std::vector<std::size_t> offsets;
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    buffer.clear();
+    offsets.clear();
+    minpp::encode_sort_keys(rows.begin(), rows.end(), buffer, offsets);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}
+
+BENCHMARK(BM_sort_tuples)->Arg(1 << 16);
+BENCHMARK(BM_sort_keys)->Arg(1 << 16);
+BENCHMARK(BM_encode_sort_keys)->Arg(1 << 16);
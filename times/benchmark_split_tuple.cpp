@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+
+#include "minpp/split_tuple.h"
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "perf_counters.h"
+
+/*
+A hot loop that reads 3 of 20 fields of every record, over a vector of flat 20-field tuples and over a vector
+of split_tuples that keep those 3 inline, where they are declared, and the other 17 in a block allocated
+from an arena. Both are indexed by the same get<0>, get<7> and get<12>.
+*/
+
+namespace {
+
+using flat = minpp::tuple<std::uint64_t, std::string, std::string, std::uint64_t, std::uint64_t, std::uint64_t, std::uint64_t,
+  double, double, double, double, double, std::uint32_t, std::int32_t, std::int32_t, std::int32_t, std::int32_t,
+  std::uint64_t, std::uint64_t, std::string>;
+using split = minpp::split_tuple<flat, minpp::hot_at<0, 7, 12>>;
+
+template <typename Rows>
+void fill(Rows& rows, std::size_t n) {
+  rows.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    rows.emplace_back(i, "name", "description", 1u, 2u, 3u, 4u, 0.5 * static_cast<double>(i), 1.0, 2.0, 3.0, 4.0,
+      static_cast<std::uint32_t>(i & 7), 1, 2, 3, 4, 5u, 6u, "note");
+  }
+}
+
+template <typename Rows>
+void hot_loop(benchmark::State& state, const Rows& rows) {
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    double sum = 0;
+    for (const auto& r: rows) {
+      if (minpp::get<12>(r) != 0) sum += static_cast<double>(minpp::get<0>(r)) * minpp::get<7>(r);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(rows.size()));
+}
+
+void BM_flat_record(benchmark::State& state) {
+  std::vector<flat> rows;
+  fill(rows, static_cast<std::size_t>(state.range(0)));
+  hot_loop(state, rows);
+}
+
+void BM_split_record(benchmark::State& state) {
+  std::pmr::monotonic_buffer_resource arena;
+  std::pmr::vector<split> rows{&arena};
+  fill(rows, static_cast<std::size_t>(state.range(0)));
+  hot_loop(state, rows);
+}
+
+}
+
+BENCHMARK(BM_flat_record)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK(BM_split_record)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+
+#include "minpp/tuple.h"
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include "perf_counters.h"
+
+/*
+A strided column decoder configured by (stride, offset, shift, bias): specialized on the configuration as a
+non-type template parameter against the same kernel reading the configuration at runtime.
+*/
+
+namespace {
+
+using decode_config = minpp::tuple<std::size_t, std::size_t, unsigned, std::int32_t>;
+
+constexpr decode_config bench_config{std::size_t{4}, std::size_t{1}, 3u, -7};
+
+template <minpp::tuple Cfg>
+std::int64_t decode_static(const std::vector<std::int32_t>& raw) {
+  constexpr std::size_t stride = minpp::get<0>(Cfg);
+  constexpr std::size_t offset = minpp::get<1>(Cfg);
+  std::int64_t acc = 0;
+  for (std::size_t i = offset; i < raw.size(); i += stride) acc += (raw[i] >> minpp::get<2>(Cfg)) + minpp::get<3>(Cfg);
+  return acc;
+}
+
+std::int64_t decode_dynamic(const std::vector<std::int32_t>& raw, const decode_config& cfg) {
+  const std::size_t stride = minpp::get<0>(cfg);
+  std::int64_t acc = 0;
+  for (std::size_t i = minpp::get<1>(cfg); i < raw.size(); i += stride) acc += (raw[i] >> minpp::get<2>(cfg)) + minpp::get<3>(cfg);
+  return acc;
+}
+
+std::vector<std::int32_t> make_raw(std::size_t n) {
+  std::vector<std::int32_t> raw(n);
+  std::iota(raw.begin(), raw.end(), 0);
+  return raw;
+}
+
+void BM_decode_nttp(benchmark::State& state) {
+  const auto raw = make_raw(static_cast<std::size_t>(state.range(0)));
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) benchmark::DoNotOptimize(decode_static<bench_config>(raw));
+  state.SetItemsProcessed(state.iterations() * state.range(0) / static_cast<std::int64_t>(minpp::get<0>(bench_config)));
+}
+
+void BM_decode_runtime(benchmark::State& state) {
+  const auto raw = make_raw(static_cast<std::size_t>(state.range(0)));
+  decode_config cfg = bench_config;
+  benchmark::DoNotOptimize(cfg);
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) benchmark::DoNotOptimize(decode_dynamic(raw, cfg));
+  state.SetItemsProcessed(state.iterations() * state.range(0) / static_cast<std::int64_t>(minpp::get<0>(bench_config)));
+}
+
+}
+
+BENCHMARK(BM_decode_nttp)->Arg(1 << 12)->Arg(1 << 20);
+BENCHMARK(BM_decode_runtime)->Arg(1 << 12)->Arg(1 << 20);
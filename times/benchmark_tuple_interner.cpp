@@ -0,0 +1,149 @@
+#include <benchmark/benchmark.h>
+
+#include "minpp/tuple_interner.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "perf_counters.h"
+
+/*
+An event stream of 1M composite keys (string_view, uint32_t, uint16_t) drawn from 10000 distinct ones, the
+views pointing into the buffer the events were parsed from.
+The intern benchmarks turn the stream into ids: one call per event, intern_all over the whole stream, the
+concurrent interner used from one thread, and the usual ad-hoc map from std::tuple<std::string, ...> to an
+id, which builds an owning key for every lookup.
+The index benchmarks then count the distinct keys of the stream by sorting a copy of it, kept either as
+owning std::tuple keys or as ids; index_bytes is the size of that copy.
+*/
+
+namespace {
+
+using key = std::tuple<std::string_view, std::uint32_t, std::uint16_t>;
+using owned_key = std::tuple<std::string, std::uint32_t, std::uint16_t>;
+
+constexpr std::size_t events = 1 << 20;
+constexpr std::size_t distinct = 10000;
+
+struct stream {
+  std::string buffer;
+  std::vector<key> keys;
+
+  stream() {
+    std::mt19937 rng{7};
+    std::uniform_int_distribution<std::size_t> pick(0, distinct - 1);
+    std::vector<std::pair<std::size_t, std::size_t>> spans;
+    for (std::size_t i = 0; i < distinct; ++i) {
+      const std::string name = "service-" + std::to_string(i % 97) + "/endpoint/" + std::to_string(i);
+      spans.emplace_back(buffer.size(), name.size());
+      buffer += name;
+    }
+    keys.reserve(events);
+    for (std::size_t e = 0; e < events; ++e) {
+      const std::size_t i = pick(rng);
+      keys.emplace_back(std::string_view{buffer}.substr(spans[i].first, spans[i].second), static_cast<std::uint32_t>(i % 31),
+        static_cast<std::uint16_t>(i % 5));
+    }
+  }
+};
+
+const stream& load() {
+  static const stream s;
+  return s;
+}
+
+struct owned_key_hash {
+  std::size_t operator()(const owned_key& k) const noexcept {
+    return (std::hash<std::string>{}(std::get<0>(k)) * 31 + std::get<1>(k)) * 31 + std::get<2>(k);
+  }
+};
+
+template <typename Interner>
+void BM_intern(benchmark::State& state) {
+  const stream& s = load();
+  std::vector<std::uint32_t> ids(events);
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    Interner in;
+    for (std::size_t e = 0; e < events; ++e) ids[e] = std::apply([&](auto... v) { return in.intern(v...); }, s.keys[e]);
+    benchmark::DoNotOptimize(ids.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(events));
+}
+
+template <typename Interner>
+void BM_intern_all(benchmark::State& state) {
+  const stream& s = load();
+  std::vector<std::uint32_t> ids(events);
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    Interner in;
+    in.intern_all(s.keys.begin(), s.keys.end(), ids.begin());
+    benchmark::DoNotOptimize(ids.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(events));
+}
+
+void BM_intern_adhoc(benchmark::State& state) {
+  const stream& s = load();
+  std::vector<std::uint32_t> ids(events);
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    std::unordered_map<owned_key, std::uint32_t, owned_key_hash> in;
+    for (std::size_t e = 0; e < events; ++e) {
+      const auto& [name, a, b] = s.keys[e];
+      ids[e] = in.try_emplace(owned_key{name, a, b}, static_cast<std::uint32_t>(in.size())).first->second;
+    }
+    benchmark::DoNotOptimize(ids.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(events));
+}
+
+template <typename Index>
+void BM_distinct(benchmark::State& state) {
+  const stream& s = load();
+  Index index;
+  if constexpr (std::is_same_v<Index, std::vector<owned_key>>) {
+    for (const auto& [name, a, b]: s.keys) index.emplace_back(std::string{name}, a, b);
+  }
+  else {
+    minpp::tuple_interner<std::string_view, std::uint32_t, std::uint16_t> in;
+    index.resize(events);
+    in.intern_all(s.keys.begin(), s.keys.end(), index.begin());
+  }
+  std::size_t bytes = index.size() * sizeof(typename Index::value_type);
+  if constexpr (std::is_same_v<Index, std::vector<owned_key>>) {
+    for (const auto& k: index) bytes += std::get<0>(k).capacity() > 15 ? std::get<0>(k).capacity() + 1 : 0;
+  }
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    state.PauseTiming();
+    Index copy = index;
+    state.ResumeTiming();
+    std::sort(copy.begin(), copy.end());
+    benchmark::DoNotOptimize(std::unique(copy.begin(), copy.end()) - copy.begin());
+  }
+  state.counters["index_bytes"] = static_cast<double>(bytes);
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(events));
+}
+
+using interner = minpp::tuple_interner<std::string_view, std::uint32_t, std::uint16_t>;
+using concurrent_interner = minpp::concurrent_tuple_interner<std::string_view, std::uint32_t, std::uint16_t>;
+
+}
+
+BENCHMARK_TEMPLATE(BM_intern, interner)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_intern, concurrent_interner)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_intern_all, interner)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_intern_all, concurrent_interner)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_intern_adhoc)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_distinct, std::vector<owned_key>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_distinct, std::vector<std::uint32_t>)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include "minpp/tuple_pool.h"
+
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include "perf_counters.h"
+
+/*
+Request-scoped rows: every thread allocates a burst of rows and frees them again, through new/delete,
+a shared std::pmr::synchronized_pool_resource and a shared minpp::tuple_pool with one cache per thread.
+*/
+
+namespace {
+
+using row = minpp::tuple<std::int64_t, double, std::int32_t, std::array<char, 20>>;
+
+constexpr std::size_t burst = 64;
+
+void BM_new_delete(benchmark::State& state) {
+  std::vector<row*> rows(burst);
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < burst; ++i) rows[i] = new row{static_cast<std::int64_t>(i), 0.5, 1, {}};
+    benchmark::DoNotOptimize(rows.data());
+    for (row* r: rows) delete r;
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(burst));
+}
+
+void BM_synchronized_pool(benchmark::State& state) {
+  static std::pmr::synchronized_pool_resource resource;
+  std::pmr::polymorphic_allocator<row> alloc{&resource};
+  std::vector<row*> rows(burst);
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < burst; ++i) {
+      rows[i] = alloc.allocate(1);
+      alloc.construct(rows[i], static_cast<std::int64_t>(i), 0.5, 1, std::array<char, 20>{});
+    }
+    benchmark::DoNotOptimize(rows.data());
+    for (row* r: rows) {
+      r->~row();
+      alloc.deallocate(r, 1);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(burst));
+}
+
+void BM_tuple_pool(benchmark::State& state) {
+  static minpp::tuple_pool<std::int64_t, double, std::int32_t, std::array<char, 20>> pool;
+  decltype(pool)::local_cache cache{pool};
+  std::vector<row*> rows(burst);
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < burst; ++i) rows[i] = cache.emplace(static_cast<std::int64_t>(i), 0.5, 1, std::array<char, 20>{});
+    benchmark::DoNotOptimize(rows.data());
+    for (row* r: rows) cache.destroy(r);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(burst));
+}
+
+}
+
+BENCHMARK(BM_new_delete)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK(BM_synchronized_pool)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK(BM_tuple_pool)->ThreadRange(1, 4)->UseRealTime();
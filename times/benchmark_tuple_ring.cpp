@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+
+#include "minpp/tuple_ring.h"
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "perf_counters.h"
+
+/*
+Pipeline hand-off: state.range(0) producers each send their share of a fixed number of messages and the
+benchmark thread consumes them. A mutex-protected std::deque (which moves every message in) against
+minpp::mpmc_tuple_ring and, with one producer, minpp::spsc_tuple_ring.
+*/
+
+namespace {
+
+using message = minpp::tuple<std::uint64_t, double, std::string>;
+
+constexpr std::uint64_t messages = 1 << 16;
+constexpr std::size_t ring_capacity = 1024;
+constexpr std::size_t pop_batch = 32;
+
+struct locked_deque {
+  template <typename... Args>
+  bool try_emplace(Args&&... args) {
+    message m{std::forward<Args>(args)...};
+    std::lock_guard lk{mutex};
+    queue.push_back(std::move(m));
+    return true;
+  }
+
+  template <typename F>
+  std::size_t try_pop_n(std::size_t n, F&& fn) {
+    std::lock_guard lk{mutex};
+    std::size_t count = 0;
+    for (; count < n && !queue.empty(); ++count) {
+      minpp::apply(fn, std::move(queue.front()));
+      queue.pop_front();
+    }
+    return count;
+  }
+
+  std::mutex mutex;
+  std::deque<message> queue;
+};
+
+template <typename Queue>
+void run(benchmark::State& state, Queue& queue) {
+  const auto producers = static_cast<std::uint64_t>(state.range(0));
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    std::vector<std::thread> threads;
+    for (std::uint64_t p = 0; p < producers; ++p) {
+      threads.emplace_back([&queue, p, producers] {
+        for (std::uint64_t i = p; i < messages; i += producers) {
+          while (!queue.try_emplace(i, 0.5, "payload")) std::this_thread::yield();
+        }
+      });
+    }
+    std::uint64_t received = 0;
+    std::uint64_t sum = 0;
+    while (received < messages) {
+      const std::size_t n = queue.try_pop_n(pop_batch, [&sum](std::uint64_t i, double, std::string s) { sum += i + s.size(); });
+      if (n) received += n;
+      else std::this_thread::yield();
+    }
+    for (auto& t: threads) t.join();
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(messages));
+}
+
+void BM_mutex_deque(benchmark::State& state) {
+  locked_deque queue;
+  run(state, queue);
+}
+
+void BM_mpmc_tuple_ring(benchmark::State& state) {
+  minpp::mpmc_tuple_ring<std::uint64_t, double, std::string> queue{ring_capacity};
+  run(state, queue);
+}
+
+void BM_spsc_tuple_ring(benchmark::State& state) {
+  minpp::spsc_tuple_ring<std::uint64_t, double, std::string> queue{ring_capacity};
+  run(state, queue);
+}
+
+}
+
+BENCHMARK(BM_mutex_deque)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+BENCHMARK(BM_mpmc_tuple_ring)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+BENCHMARK(BM_spsc_tuple_ring)->Arg(1)->UseRealTime();
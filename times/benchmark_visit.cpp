@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include "minpp/visit.h"
+
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "perf_counters.h"
+
+/*
+Runtime-index element access inside a decode loop: visit_at against a forced function-pointer table and the
+hand-rolled branch chain over get<0> ... get<N-1> it replaces, for 4, 16 and 64 elements.
+*/
+
+namespace {
+
+template <std::size_t I>
+using cycle_t = std::tuple_element_t<I % 4, std::tuple<std::int32_t, std::int64_t, float, double>>;
+
+template <std::size_t... Is>
+auto make_row(std::index_sequence<Is...>) {
+  return minpp::tuple<cycle_t<Is>...>{static_cast<cycle_t<Is>>(Is + 1)...};
+}
+
+template <std::size_t N>
+using row_t = decltype(make_row(std::make_index_sequence<N>{}));
+
+struct to_double {
+  template <typename T>
+  double operator()(T v) const noexcept { return static_cast<double>(v); }
+};
+
+std::vector<std::size_t> make_indices(std::size_t n) {
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<std::size_t> dist{0, n - 1};
+  std::vector<std::size_t> indices(4096);
+  for (auto& i: indices) i = dist(gen);
+  return indices;
+}
+
+template <typename Row, std::size_t... Is>
+double branch_chain(const Row& row, std::size_t i, std::index_sequence<Is...>) {
+  double r = 0;
+  ((i == Is ? (r = to_double{}(minpp::get<Is>(row)), true) : false) || ...);
+  return r;
+}
+
+template <std::size_t N>
+void BM_visit_at(benchmark::State& state) {
+  const auto row = make_row(std::make_index_sequence<N>{});
+  const auto indices = make_indices(N);
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    double acc = 0;
+    for (std::size_t i: indices) acc += minpp::visit_at(row, i, to_double{});
+    benchmark::DoNotOptimize(acc);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(indices.size()));
+}
+
+template <std::size_t N>
+void BM_visit_table(benchmark::State& state) {
+  const auto row = make_row(std::make_index_sequence<N>{});
+  const auto indices = make_indices(N);
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    double acc = 0;
+    for (std::size_t i: indices) acc += minpp::impl::_visit_at_table<double>(i, std::make_index_sequence<N>{}, to_double{}, row);
+    benchmark::DoNotOptimize(acc);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(indices.size()));
+}
+
+template <std::size_t N>
+void BM_branch_chain(benchmark::State& state) {
+  const auto row = make_row(std::make_index_sequence<N>{});
+  const auto indices = make_indices(N);
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    double acc = 0;
+    for (std::size_t i: indices) acc += branch_chain(row, i, std::make_index_sequence<N>{});
+    benchmark::DoNotOptimize(acc);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(indices.size()));
+}
+
+}
+
+BENCHMARK_TEMPLATE(BM_visit_at, 4);
+BENCHMARK_TEMPLATE(BM_visit_at, 16);
+BENCHMARK_TEMPLATE(BM_visit_at, 64);
+BENCHMARK_TEMPLATE(BM_visit_table, 4);
+BENCHMARK_TEMPLATE(BM_visit_table, 16);
+BENCHMARK_TEMPLATE(BM_visit_table, 64);
+BENCHMARK_TEMPLATE(BM_branch_chain, 4);
+BENCHMARK_TEMPLATE(BM_branch_chain, 16);
+BENCHMARK_TEMPLATE(BM_branch_chain, 64);
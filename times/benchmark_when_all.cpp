@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+
+#include "minpp/when_all.h"
+#include <tuple>
+
+#include <future>
+#include <string>
+
+#include "perf_counters.h"
+
+/*
+Fan-out of four heterogeneous sub-queries into one tuple: minpp::when_all against std::async with a
+std::tuple assembled from the futures afterwards.
+*/
+
+namespace {
+
+int query_int(int n) {
+  int acc = 0;
+  for (int i = 0; i < n; ++i) benchmark::DoNotOptimize(acc += i);
+  return acc;
+}
+
+double query_double(int n) {
+  return static_cast<double>(query_int(n)) * 0.5;
+}
+
+std::string query_string(int n) {
+  return std::string(static_cast<std::size_t>(32 + query_int(n) % 16), 's');
+}
+
+long query_long(int n) {
+  return static_cast<long>(query_int(n)) << 1;
+}
+
+void BM_minpp_when_all(benchmark::State& state) {
+  const int work = static_cast<int>(state.range(0));
+  minpp::thread_pool pool{4};
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    auto r = minpp::when_all(pool,
+      [=] { return query_int(work); },
+      [=] { return query_double(work); },
+      [=] { return query_string(work); },
+      [=] { return query_long(work); }
+    );
+    benchmark::DoNotOptimize(r);
+  }
+}
+
+void BM_std_async_futures(benchmark::State& state) {
+  const int work = static_cast<int>(state.range(0));
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    auto f0 = std::async(std::launch::async, query_int, work);
+    auto f1 = std::async(std::launch::async, query_double, work);
+    auto f2 = std::async(std::launch::async, query_string, work);
+    auto f3 = std::async(std::launch::async, query_long, work);
+    std::tuple<int, double, std::string, long> r{f0.get(), f1.get(), f2.get(), f3.get()};
+    benchmark::DoNotOptimize(r);
+  }
+}
+
+void BM_serial(benchmark::State& state) {
+  const int work = static_cast<int>(state.range(0));
+
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) {
+    minpp::tuple<int, double, std::string, long> r{query_int(work), query_double(work), query_string(work), query_long(work)};
+    benchmark::DoNotOptimize(r);
+  }
+}
+
+}
+
+BENCHMARK(BM_minpp_when_all)->Arg(0)->Arg(1 << 10)->Arg(1 << 16)->UseRealTime();
+BENCHMARK(BM_std_async_futures)->Arg(0)->Arg(1 << 10)->Arg(1 << 16)->UseRealTime();
+BENCHMARK(BM_serial)->Arg(0)->Arg(1 << 10)->Arg(1 << 16)->UseRealTime();
@@ -0,0 +1,143 @@
+#!/bin/sh
+# Compares the build time of a synthetic project that uses minpp through #include with the same project using
+# minpp through a header unit (import "minpp/tuple.h";) and, where the compiler can consume it, the named
+# module (import minpp;).
+#
+#   times/module_build_times.sh [translation units] [mode...]
+#
+# Modes are include, header-unit and module (default: include header-unit). CXX selects the compiler; the
+# flags are GCC's (-fmodules-ts). Every generated translation unit instantiates a handful of tuple types,
+# comparisons, tuple_cat and apply, and uses only fundamental element types so that it does not have to mix
+# standard headers with an imported copy of them.
+#
+# For each mode it reports a clean build, a rebuild after touching one translation unit, and a rebuild after
+# touching a minpp header (which rebuilds the header unit or module and everything that imports it).
+set -e
+
+units=${1:-200}
+[ $# -gt 0 ] && shift
+modes=${*:-include header-unit}
+cxx=${CXX:-g++}
+root=$(cd "$(dirname "$0")/.." && pwd)
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+flags="-std=c++20 -O1 -I$root/include"
+
+now() {
+  date +%s.%N
+}
+
+elapsed() {
+  awk "BEGIN { print $2 - $1 }"
+}
+
+generate() {
+  mode=$1
+  dir=$work/$mode
+  mkdir -p "$dir"
+  i=0
+  while [ "$i" -lt "$units" ]; do
+    {
+      case $mode in
+        include) echo '#include "minpp/tuple.h"' ;;
+        header-unit) echo 'import "minpp/tuple.h";' ;;
+        module) echo 'import minpp;' ;;
+      esac
+      cat <<EOF
+namespace detail_$i {
+using row = minpp::tuple<int, long, double, char, unsigned>;
+using key = minpp::tuple<int, long>;
+
+bool less(const row& a, const row& b) {
+  return a < b;
+}
+
+double sum(const row& r) {
+  return minpp::apply([](auto... v) { return (static_cast<double>(v) + ... + $i.0); }, r);
+}
+
+auto widen(row r, key k) {
+  return minpp::tuple_cat(r, k);
+}
+}
+
+double unit_$i() {
+  detail_$i::row a{$i, 2L, 3.0, 'a', 4u}, b = a;
+  minpp::get<0>(b) += 1;
+  auto [x, y, z, c, u] = b;
+  return detail_$i::less(a, b) ? detail_$i::sum(b) + minpp::get<5>(detail_$i::widen(a, {x, y})) + z + c + u : 0.0;
+}
+EOF
+    } > "$dir/unit_$i.cpp"
+    i=$((i + 1))
+  done
+  {
+    i=0
+    while [ "$i" -lt "$units" ]; do
+      echo "double unit_$i();"
+      i=$((i + 1))
+    done
+    echo 'int main() {'
+    echo '  double s = 0;'
+    i=0
+    while [ "$i" -lt "$units" ]; do
+      echo "  s += unit_$i();"
+      i=$((i + 1))
+    done
+    echo '  return s > 0 ? 0 : 1;'
+    echo '}'
+  } > "$dir/main.cpp"
+}
+
+prepare() {
+  mode=$1
+  case $mode in
+    include) ;;
+    header-unit) $cxx $flags -fmodules-ts -x c++-header "$root/include/minpp/tuple.h" ;;
+    module) $cxx $flags -fmodules-ts -c -x c++ "$root/modules/minpp.cppm" -o minpp_module.o ;;
+  esac
+}
+
+compile() {
+  mode=$1
+  src=$2
+  case $mode in
+    include) $cxx $flags -c "$src" -o "${src%.cpp}.o" ;;
+    *) $cxx $flags -fmodules-ts -c "$src" -o "${src%.cpp}.o" ;;
+  esac
+}
+
+build() {
+  mode=$1
+  shift
+  for src in "$@"; do
+    compile "$mode" "$src"
+  done
+  $cxx "$work/$mode"/*.o -o "$work/$mode/app"
+  "$work/$mode/app"
+}
+
+for mode in $modes; do
+  generate "$mode"
+  dir=$work/$mode
+  (
+    cd "$dir"
+    start=$(now)
+    prepare "$mode"
+    build "$mode" "$dir"/*.cpp
+    clean=$(elapsed "$start" "$(now)")
+
+    start=$(now)
+    build "$mode" "$dir/unit_0.cpp" "$dir/main.cpp"
+    one=$(elapsed "$start" "$(now)")
+
+    start=$(now)
+    prepare "$mode"
+    build "$mode" "$dir"/unit_*.cpp
+    header=$(elapsed "$start" "$(now)")
+
+    printf '%-12s %4d units   clean %8.2fs   one unit changed %6.2fs   header changed %8.2fs\n' \
+      "$mode" "$units" "$clean" "$one" "$header"
+  )
+done
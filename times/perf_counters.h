@@ -0,0 +1,205 @@
+#ifndef MINPP_TIMES_PERF_COUNTERS_H_
+#define MINPP_TIMES_PERF_COUNTERS_H_
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <string_view>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define MINPP_BENCH_HAS_PERF_EVENT 1
+#else
+#define MINPP_BENCH_HAS_PERF_EVENT 0
+#endif
+
+/*
+Optional hardware performance counters for the benchmarks.
+
+Counters are off by default. Pass --minpp_perf_counters to the benchmark binary (or set
+MINPP_PERF_COUNTERS=1) to collect cycles, instructions, branch misses and L1d read misses around
+each benchmark loop, reported per iteration as Google Benchmark user counters. Counters that cannot
+be opened (no perf_event_open, perf_event_paranoid too strict, event not supported by the PMU or
+the hypervisor) are left out of the report; the benchmarks themselves always run.
+*/
+
+namespace minpp_bench {
+
+inline bool& perf_counters_requested() noexcept {
+  static bool requested = [] {
+    const char* env = std::getenv("MINPP_PERF_COUNTERS");
+    return env != nullptr && env[0] != '\0' && env[0] != '0';
+  }();
+  return requested;
+}
+
+#if MINPP_BENCH_HAS_PERF_EVENT
+
+struct perf_event_desc {
+  const char* name;
+  std::uint32_t type;
+  std::uint64_t config;
+};
+
+inline constexpr std::array<perf_event_desc, 4> perf_events {{
+  {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+  {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+  {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+  {"l1d_misses", PERF_TYPE_HW_CACHE,
+    PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+}};
+
+/*
+One perf_event_open group over perf_events, counting user space of the calling thread only.
+*/
+class perf_counters {
+  public:
+  perf_counters() noexcept {
+    _fds.fill(-1);
+    for (std::size_t i = 0; i < perf_events.size(); ++i) {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = perf_events[i].type;
+      attr.config = perf_events[i].config;
+      attr.disabled = _leader() < 0 ? 1 : 0;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+      const int fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, _leader(), 0));
+      if (fd < 0) {
+        _report_unavailable(perf_events[i].name, errno);
+        continue;
+      }
+      _fds[i] = fd;
+      ::ioctl(fd, PERF_EVENT_IOC_ID, &_ids[i]);
+    }
+  }
+
+  perf_counters(const perf_counters&) = delete;
+  perf_counters& operator=(const perf_counters&) = delete;
+
+  ~perf_counters() {
+    for (int fd: _fds) if (fd >= 0) ::close(fd);
+  }
+
+  bool available() const noexcept { return _leader() >= 0; }
+
+  void start() noexcept {
+    if (!available()) return;
+    ::ioctl(_leader(), PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ::ioctl(_leader(), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+
+  void stop(benchmark::State& state) noexcept {
+    if (!available()) return;
+    ::ioctl(_leader(), PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    struct {
+      std::uint64_t nr;
+      std::uint64_t time_enabled;
+      std::uint64_t time_running;
+      struct { std::uint64_t value, id; } values[perf_events.size()];
+    } data;
+    if (::read(_leader(), &data, sizeof(data)) <= 0 || data.time_running == 0) return;
+
+    // scale up if the group got multiplexed with other users of the PMU
+    const double scale = static_cast<double>(data.time_enabled) / static_cast<double>(data.time_running);
+    std::array<double, perf_events.size()> counts{};
+    for (std::size_t v = 0; v < data.nr; ++v) {
+      for (std::size_t i = 0; i < perf_events.size(); ++i) {
+        if (_fds[i] >= 0 && _ids[i] == data.values[v].id) {
+          counts[i] = static_cast<double>(data.values[v].value) * scale;
+          state.counters[perf_events[i].name] = benchmark::Counter(counts[i], benchmark::Counter::kAvgIterations);
+        }
+      }
+    }
+    if (_fds[0] >= 0 && _fds[1] >= 0 && counts[0] > 0) state.counters["IPC"] = counts[1] / counts[0];
+  }
+
+  private:
+  int _leader() const noexcept {
+    for (int fd: _fds) if (fd >= 0) return fd;
+    return -1;
+  }
+
+  static void _report_unavailable(const char* name, int err) {
+    static bool reported = false;
+    if (reported) return;
+    reported = true;
+    std::cerr << "minpp_bench: perf counter " << name << " unavailable (" << std::strerror(err)
+      << "), continuing without it" << std::endl;
+  }
+
+  std::array<int, perf_events.size()> _fds;
+  std::array<std::uint64_t, perf_events.size()> _ids{};
+};
+
+#else
+
+class perf_counters {
+  public:
+  bool available() const noexcept { return false; }
+  void start() noexcept {}
+  void stop(benchmark::State&) noexcept {}
+};
+
+#endif
+
+/*
+Counts the enclosing scope when counters were requested. Construct it right before the benchmark loop:
+  minpp_bench::perf_scope perf{state};
+  for (auto _ : state) { ... }
+*/
+class perf_scope {
+  public:
+  explicit perf_scope(benchmark::State& state) noexcept : _state{state} {
+    if (perf_counters_requested()) {
+      _counters.emplace();
+      _counters->start();
+    }
+  }
+
+  perf_scope(const perf_scope&) = delete;
+  perf_scope& operator=(const perf_scope&) = delete;
+
+  ~perf_scope() {
+    if (_counters) _counters->stop(_state);
+  }
+
+  private:
+  benchmark::State& _state;
+  std::optional<perf_counters> _counters;
+};
+
+/*
+Drop-in replacement for BENCHMARK_MAIN() that also understands --minpp_perf_counters.
+*/
+inline int run_benchmarks(int argc, char** argv) {
+  int kept = 1;
+  for (int i = 1; i < argc; ++i) {
+    if (std::string_view{argv[i]} == "--minpp_perf_counters") perf_counters_requested() = true;
+    else argv[kept++] = argv[i];
+  }
+  argc = kept;
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
+
+}
+
+#endif